@@ -41,6 +41,7 @@ int main(int argc, const char** argv)
 {
     std::unique_ptr<IContext> context;
     int32_t rc = EXIT_SUCCESS;
+    SetAudioContextFactory(CreateAudioContext);
     int runGame = cmdline_run(argv, argc);
     core_init();
     RegisterBitmapReader();
@@ -26,6 +26,8 @@ namespace OpenRCT2::Audio
     private:
         ISDLAudioSource* _source = nullptr;
         SpeexResamplerState* _resampler = nullptr;
+        SDL_AudioCVT _converter = {};
+        bool _hasConverter = false;
 
         int32_t _group = MIXER_GROUP_SOUND;
         double _rate = 0;
@@ -81,6 +83,20 @@ namespace OpenRCT2::Audio
             _resampler = value;
         }
 
+        const SDL_AudioCVT* GetConverter() const override
+        {
+            return _hasConverter ? &_converter : nullptr;
+        }
+
+        void SetConverter(const SDL_AudioCVT* value) override
+        {
+            _hasConverter = value != nullptr;
+            if (value != nullptr)
+            {
+                _converter = *value;
+            }
+        }
+
         int32_t GetGroup() const override
         {
             return _group;
@@ -113,6 +129,7 @@ namespace OpenRCT2::Audio
                 AudioFormat format = _source->GetFormat();
                 int32_t samplesize = format.channels * format.BytesPerSample();
                 _offset = (offset / samplesize) * samplesize;
+                _source->Prefetch(_offset);
                 return true;
             }
             return false;
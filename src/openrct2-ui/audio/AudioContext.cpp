@@ -10,6 +10,7 @@
 #include "AudioContext.h"
 
 #include "../SDLException.h"
+#include "AudioStreamer.h"
 
 #include <SDL.h>
 #include <openrct2/audio/AudioContext.h>
@@ -22,6 +23,8 @@ namespace OpenRCT2::Audio
     {
     private:
         IAudioMixer* _audioMixer = nullptr;
+        // Destroyed after the mixer, which closes the streams of the channels it deletes
+        AudioStreamer _streamer;
 
     public:
         AudioContext()
@@ -68,7 +71,12 @@ namespace OpenRCT2::Audio
 
         IAudioSource* CreateStreamFromWAV(const std::string& path) override
         {
-            return AudioSource::CreateStreamFromWAV(path);
+            return AudioSource::CreateStreamFromWAV(path, &_streamer);
+        }
+
+        uint32_t GetStreamUnderrunCount() override
+        {
+            return _streamer.GetUnderrunCount();
         }
 
         void StartTitleMusic() override
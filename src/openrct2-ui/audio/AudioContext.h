@@ -15,12 +15,14 @@
 #include <openrct2/common.h>
 #include <string>
 
+struct SDL_AudioCVT;
 struct SDL_RWops;
 using SpeexResamplerState = struct SpeexResamplerState_;
 
 namespace OpenRCT2::Audio
 {
     struct AudioFormat;
+    class AudioStreamer;
     interface IAudioContext;
 
 #pragma pack(push, 1)
@@ -51,6 +53,8 @@ namespace OpenRCT2::Audio
     interface ISDLAudioSource : public IAudioSource
     {
         virtual AudioFormat GetFormat() const abstract;
+        // Called when the playback position is about to jump to the given offset
+        virtual void Prefetch(uint64_t offset) abstract;
     };
 
     interface ISDLAudioChannel : public IAudioChannel
@@ -58,14 +62,17 @@ namespace OpenRCT2::Audio
         virtual AudioFormat GetFormat() const abstract;
         virtual SpeexResamplerState* GetResampler() const abstract;
         virtual void SetResampler(SpeexResamplerState * value) abstract;
+        // Converts the source's PCM to the device format, nullptr if there is no need to or it cannot be converted
+        virtual const SDL_AudioCVT* GetConverter() const abstract;
+        virtual void SetConverter(const SDL_AudioCVT* value) abstract;
     };
 
     namespace AudioSource
     {
         IAudioSource* CreateMemoryFromCSS1(const std::string& path, size_t index, const AudioFormat* targetFormat = nullptr);
         IAudioSource* CreateMemoryFromWAV(const std::string& path, const AudioFormat* targetFormat = nullptr);
-        IAudioSource* CreateStreamFromWAV(const std::string& path);
-        IAudioSource* CreateStreamFromWAV(SDL_RWops* rw);
+        IAudioSource* CreateStreamFromWAV(const std::string& path, AudioStreamer* streamer = nullptr);
+        IAudioSource* CreateStreamFromWAV(SDL_RWops* rw, AudioStreamer* streamer = nullptr);
     } // namespace AudioSource
 
     namespace AudioChannel
@@ -28,11 +28,22 @@
 #include <speex/speex_resampler.h>
 #include <vector>
 
+#if defined(__SSE2__) || defined(_M_X64)
+#    include <emmintrin.h>
+#endif
+
 namespace OpenRCT2::Audio
 {
     class AudioMixerImpl final : public IAudioMixer
     {
     private:
+        // The read and convert buffers are reserved for channels reading this many times the device's chunk size, so
+        // the audio callback only allocates if a channel is played faster or its source is far from the device format
+        static constexpr size_t RESERVED_READ_RATIO = 8;
+        static constexpr size_t RESERVED_CONVERT_RATIO = 4;
+        // Rendering without a device is usually done a game tick at a time
+        static constexpr size_t OFFLINE_CHUNK_FRAMES = 1024;
+
         IAudioSource* _nullSource = nullptr;
 
         SDL_AudioDeviceID _deviceId = 0;
@@ -50,6 +61,8 @@ namespace OpenRCT2::Audio
         std::vector<uint8_t> _channelBuffer;
         std::vector<uint8_t> _convertBuffer;
         std::vector<uint8_t> _effectBuffer;
+        // The channels are mixed in floating point and only clipped when written to the device
+        std::vector<float> _mixBuffer;
 
     public:
         AudioMixerImpl()
@@ -68,9 +81,9 @@ namespace OpenRCT2::Audio
             Close();
 
             SDL_AudioSpec want = {};
-            want.freq = 22050;
+            want.freq = MIXER_OUTPUT_FREQUENCY;
             want.format = AUDIO_S16SYS;
-            want.channels = 2;
+            want.channels = MIXER_OUTPUT_CHANNELS;
             want.samples = 2048;
             want.callback = [](void* arg, uint8_t* dst, int32_t length) -> void {
                 auto mixer = static_cast<AudioMixerImpl*>(arg);
@@ -78,17 +91,27 @@ namespace OpenRCT2::Audio
             };
             want.userdata = this;
 
+            // No changes are allowed, so SDL converts from the wanted signed 16-bit stereo format if the device needs
+            // another one and the mixing functions can rely on it
             SDL_AudioSpec have;
             _deviceId = SDL_OpenAudioDevice(device, 0, &want, &have, 0);
-            _format.format = have.format;
-            _format.channels = have.channels;
-            _format.freq = have.freq;
-
-            LoadAllSounds();
+            InitFormat(have.format, have.channels, have.freq, have.samples);
 
             SDL_PauseAudioDevice(_deviceId, 0);
         }
 
+        void InitOffline() override
+        {
+            Close();
+            InitFormat(AUDIO_S16SYS, MIXER_OUTPUT_CHANNELS, MIXER_OUTPUT_FREQUENCY, OFFLINE_CHUNK_FRAMES);
+        }
+
+        void Render(int16_t* dst, size_t numFrames) override
+        {
+            Guard::Assert(_deviceId == 0, "Audio can only be rendered when no device is open");
+            GetNextAudioChunk((uint8_t*)dst, numFrames * _format.GetByteRate());
+        }
+
         void Close() override
         {
             // Free channels
@@ -100,7 +123,11 @@ namespace OpenRCT2::Audio
             _channels.clear();
             Unlock();
 
-            SDL_CloseAudioDevice(_deviceId);
+            if (_deviceId != 0)
+            {
+                SDL_CloseAudioDevice(_deviceId);
+                _deviceId = 0;
+            }
 
             // Free sources
             for (size_t i = 0; i < std::size(_css1Sources); i++)
@@ -125,6 +152,8 @@ namespace OpenRCT2::Audio
             _convertBuffer.shrink_to_fit();
             _effectBuffer.clear();
             _effectBuffer.shrink_to_fit();
+            _mixBuffer.clear();
+            _mixBuffer.shrink_to_fit();
         }
 
         void Lock() override
@@ -144,6 +173,7 @@ namespace OpenRCT2::Audio
             if (channel != nullptr)
             {
                 channel->Play(source, loop);
+                PrepareChannel(channel);
                 channel->SetDeleteOnDone(deleteondone);
                 channel->SetDeleteSourceOnDone(deletesourceondone);
                 _channels.push_back(channel);
@@ -196,6 +226,21 @@ namespace OpenRCT2::Audio
         }
 
     private:
+        void InitFormat(SDL_AudioFormat format, int32_t channels, int32_t freq, size_t chunkFrames)
+        {
+            _format.format = format;
+            _format.channels = channels;
+            _format.freq = freq;
+
+            size_t chunkLength = chunkFrames * (size_t)_format.GetByteRate();
+            _mixBuffer.resize(chunkFrames * (size_t)_format.channels);
+            _channelBuffer.reserve(chunkLength * RESERVED_READ_RATIO);
+            _convertBuffer.reserve(chunkLength * RESERVED_READ_RATIO * RESERVED_CONVERT_RATIO);
+            _effectBuffer.reserve(chunkLength);
+
+            LoadAllSounds();
+        }
+
         void LoadAllSounds()
         {
             const utf8* css1Path = context_get_path_legacy(PATH_ID_CSS1);
@@ -210,14 +255,42 @@ namespace OpenRCT2::Audio
             }
         }
 
+        /**
+         * Creates the channel's resampler and the converter from its source's format to the device format, so the
+         * audio callback does not have to.
+         */
+        void PrepareChannel(ISDLAudioChannel* channel)
+        {
+            channel->SetResampler(speex_resampler_init(_format.channels, _format.freq, _format.freq, 0, nullptr));
+
+            AudioFormat streamformat = channel->GetFormat();
+            if (streamformat != _format)
+            {
+                SDL_AudioCVT cvt;
+                if (SDL_BuildAudioCVT(
+                        &cvt, streamformat.format, streamformat.channels, streamformat.freq, _format.format, _format.channels,
+                        _format.freq)
+                    >= 0)
+                {
+                    channel->SetConverter(&cvt);
+                }
+            }
+        }
+
         void GetNextAudioChunk(uint8_t* dst, size_t length)
         {
             UpdateAdjustedSound();
 
-            // Zero the output buffer
-            std::fill_n(dst, length, 0);
+            size_t numFrames = length / _format.GetByteRate();
+            size_t numSamples = numFrames * _format.channels;
+            if (_mixBuffer.size() < numSamples)
+            {
+                // Only if SDL asks for more than the chunk size it opened the device with
+                _mixBuffer.resize(numSamples);
+            }
+            std::fill_n(_mixBuffer.begin(), numSamples, 0.0f);
 
-            // Mix channels onto output buffer
+            // Mix channels onto the mix buffer
             auto it = _channels.begin();
             while (it != _channels.end())
             {
@@ -226,7 +299,7 @@ namespace OpenRCT2::Audio
                 if ((group != MIXER_GROUP_SOUND || gConfigSound.sound_enabled) && gConfigSound.master_sound_enabled
                     && gConfigSound.master_volume != 0)
                 {
-                    MixChannel(channel, dst, length);
+                    MixChannel(channel, numFrames);
                 }
                 if ((channel->IsDone() && channel->DeleteOnDone()) || channel->IsStopping())
                 {
@@ -238,6 +311,10 @@ namespace OpenRCT2::Audio
                     it++;
                 }
             }
+
+            // Write the mix buffer to the output buffer
+            std::fill_n(dst, length, 0);
+            WriteMixS16((int16_t*)dst, _mixBuffer.data(), numSamples);
         }
 
         void UpdateAdjustedSound()
@@ -255,35 +332,26 @@ namespace OpenRCT2::Audio
             }
         }
 
-        void MixChannel(ISDLAudioChannel* channel, uint8_t* data, size_t length)
+        void MixChannel(ISDLAudioChannel* channel, size_t numFrames)
         {
             int32_t byteRate = _format.GetByteRate();
-            int32_t numSamples = (int32_t)(length / byteRate);
-            double rate = 1;
-            if (_format.format == AUDIO_S16SYS)
-            {
-                rate = channel->GetRate();
-            }
+            double rate = channel->GetRate();
 
-            bool mustConvert = false;
             SDL_AudioCVT cvt;
             cvt.len_ratio = 1;
-            AudioFormat streamformat = channel->GetFormat();
-            if (streamformat != _format)
+            const SDL_AudioCVT* converter = channel->GetConverter();
+            if (converter != nullptr)
             {
-                if (SDL_BuildAudioCVT(
-                        &cvt, streamformat.format, streamformat.channels, streamformat.freq, _format.format, _format.channels,
-                        _format.freq)
-                    == -1)
-                {
-                    // Unable to convert channel data
-                    return;
-                }
-                mustConvert = true;
+                cvt = *converter;
+            }
+            else if (channel->GetFormat() != _format)
+            {
+                // Unable to convert channel data
+                return;
             }
 
             // Read raw PCM from channel
-            int32_t readSamples = (int32_t)(numSamples * rate);
+            int32_t readSamples = (int32_t)(numFrames * rate);
             size_t readLength = (size_t)(readSamples / cvt.len_ratio) * byteRate;
             _channelBuffer.resize(readLength);
             size_t bytesRead = channel->Read(_channelBuffer.data(), readLength);
@@ -291,7 +359,7 @@ namespace OpenRCT2::Audio
             // Convert data to required format if necessary
             void* buffer = nullptr;
             size_t bufferLen = 0;
-            if (mustConvert)
+            if (converter != nullptr)
             {
                 if (Convert(&cvt, _channelBuffer.data(), bytesRead))
                 {
@@ -310,27 +378,26 @@ namespace OpenRCT2::Audio
             }
 
             // Apply effects
-            if (rate != 1)
+            if (rate != 1 && channel->GetResampler() != nullptr)
             {
                 int32_t inRate = (int32_t)(bufferLen / byteRate);
-                int32_t outRate = numSamples;
+                int32_t outRate = (int32_t)numFrames;
                 if (bytesRead != readLength)
                 {
                     inRate = _format.freq;
                     outRate = _format.freq * (1 / rate);
                 }
-                _effectBuffer.resize(length);
-                bufferLen = ApplyResample(channel, buffer, (int32_t)(bufferLen / byteRate), numSamples, inRate, outRate);
+                _effectBuffer.resize(numFrames * byteRate);
+                bufferLen = ApplyResample(
+                    channel, buffer, (int32_t)(bufferLen / byteRate), (int32_t)numFrames, inRate, outRate);
                 buffer = _effectBuffer.data();
             }
 
-            // Apply panning and volume
-            ApplyPan(channel, buffer, bufferLen, byteRate);
-            int32_t mixVolume = ApplyVolume(channel, buffer, bufferLen);
-
-            // Finally mix on to destination buffer
-            size_t dstLength = std::min(length, bufferLen);
-            SDL_MixAudioFormat(data, (const uint8_t*)buffer, _format.format, (uint32_t)dstLength, mixVolume);
+            // Apply panning and volume while mixing on to the mix buffer
+            float startL, startR, endL, endR;
+            GetGains(channel, &startL, &startR, &endL, &endR);
+            size_t mixFrames = std::min(numFrames, bufferLen / byteRate);
+            MixFramesS16(_mixBuffer.data(), (const int16_t*)buffer, mixFrames, startL, startR, endL, endR);
 
             channel->UpdateOldVolume();
         }
@@ -345,13 +412,7 @@ namespace OpenRCT2::Audio
         {
             int32_t byteRate = _format.GetByteRate();
 
-            // Create resampler
             SpeexResamplerState* resampler = channel->GetResampler();
-            if (resampler == nullptr)
-            {
-                resampler = speex_resampler_init(_format.channels, _format.freq, _format.freq, 0, nullptr);
-                channel->SetResampler(resampler);
-            }
             speex_resampler_set_rate(resampler, inRate, outRate);
 
             uint32_t inLen = srcSamples;
@@ -362,23 +423,11 @@ namespace OpenRCT2::Audio
             return outLen * byteRate;
         }
 
-        void ApplyPan(const IAudioChannel* channel, void* buffer, size_t len, size_t sampleSize)
-        {
-            if (channel->GetPan() != 0.5f && _format.channels == 2)
-            {
-                switch (_format.format)
-                {
-                    case AUDIO_S16SYS:
-                        EffectPanS16(channel, (int16_t*)buffer, (int32_t)(len / sampleSize));
-                        break;
-                    case AUDIO_U8:
-                        EffectPanU8(channel, (uint8_t*)buffer, (int32_t)(len / sampleSize));
-                        break;
-                }
-            }
-        }
-
-        int32_t ApplyVolume(const IAudioChannel* channel, void* buffer, size_t len)
+        /**
+         * Gets the gains of the left and right samples at the start and end of the chunk, which combine the channel's
+         * pan and its volume adjusted by the mixer and sound settings.
+         */
+        void GetGains(const IAudioChannel* channel, float* startL, float* startR, float* endL, float* endR) const
         {
             float volumeAdjust = _volume;
             volumeAdjust *= gConfigSound.master_sound_enabled ? (gConfigSound.master_volume / 100.0f) : 0;
@@ -399,6 +448,7 @@ namespace OpenRCT2::Audio
                     break;
             }
 
+            // Fade between volume levels to smooth out sound and minimize clicks from sudden volume changes
             int32_t startVolume = (int32_t)(channel->GetOldVolume() * volumeAdjust);
             int32_t endVolume = (int32_t)(channel->GetVolume() * volumeAdjust);
             if (channel->IsStopping())
@@ -406,82 +456,68 @@ namespace OpenRCT2::Audio
                 endVolume = 0;
             }
 
-            int32_t mixVolume = (int32_t)(channel->GetVolume() * volumeAdjust);
-            if (startVolume != endVolume)
-            {
-                // Set to max since we are adjusting the volume ourselves
-                mixVolume = MIXER_VOLUME_MAX;
-
-                // Fade between volume levels to smooth out sound and minimize clicks from sudden volume changes
-                int32_t fadeLength = (int32_t)len / _format.BytesPerSample();
-                switch (_format.format)
-                {
-                    case AUDIO_S16SYS:
-                        EffectFadeS16((int16_t*)buffer, fadeLength, startVolume, endVolume);
-                        break;
-                    case AUDIO_U8:
-                        EffectFadeU8((uint8_t*)buffer, fadeLength, startVolume, endVolume);
-                        break;
-                }
-            }
-            return mixVolume;
+            float startVolumeF = (float)startVolume / MIXER_VOLUME_MAX;
+            float endVolumeF = (float)endVolume / MIXER_VOLUME_MAX;
+            *startL = channel->GetOldVolumeL() * startVolumeF;
+            *startR = channel->GetOldVolumeR() * startVolumeF;
+            *endL = channel->GetVolumeL() * endVolumeF;
+            *endR = channel->GetVolumeR() * endVolumeF;
         }
 
-        static void EffectPanS16(const IAudioChannel* channel, int16_t* data, int32_t length)
+        /**
+         * Adds the frames of interleaved left and right samples to the mix buffer, with the gains of the left and right
+         * samples moving linearly from their start to their end values over the frames.
+         */
+        static void MixFramesS16(
+            float* RESTRICT mix, const int16_t* RESTRICT src, size_t numFrames, float startL, float startR, float endL,
+            float endR)
         {
-            const float dt = 1.0f / (length * 2);
-            float volumeL = channel->GetOldVolumeL();
-            float volumeR = channel->GetOldVolumeR();
-            const float d_left = dt * (channel->GetVolumeL() - channel->GetOldVolumeL());
-            const float d_right = dt * (channel->GetVolumeR() - channel->GetOldVolumeR());
-
-            for (int32_t i = 0; i < length * 2; i += 2)
+            if (numFrames == 0)
+                return;
+
+            const float stepL = (endL - startL) / numFrames;
+            const float stepR = (endR - startR) / numFrames;
+            size_t i = 0;
+#if defined(__SSE2__) || defined(_M_X64)
+            // Two frames at a time
+            __m128 gains = _mm_setr_ps(startL, startR, startL + stepL, startR + stepR);
+            const __m128 gainSteps = _mm_setr_ps(stepL * 2, stepR * 2, stepL * 2, stepR * 2);
+            for (; i + 2 <= numFrames; i += 2)
             {
-                data[i] = (int16_t)(data[i] * volumeL);
-                data[i + 1] = (int16_t)(data[i + 1] * volumeR);
-                volumeL += d_left;
-                volumeR += d_right;
+                const __m128i samples16 = _mm_loadl_epi64((const __m128i*)(src + i * 2));
+                // Sign extend the samples to 32 bits
+                const __m128i samples32 = _mm_srai_epi32(_mm_unpacklo_epi16(samples16, samples16), 16);
+                const __m128 samples = _mm_cvtepi32_ps(samples32);
+                const __m128 mixed = _mm_add_ps(_mm_loadu_ps(mix + i * 2), _mm_mul_ps(samples, gains));
+                _mm_storeu_ps(mix + i * 2, mixed);
+                gains = _mm_add_ps(gains, gainSteps);
             }
-        }
-
-        static void EffectPanU8(const IAudioChannel* channel, uint8_t* data, int32_t length)
-        {
-            float volumeL = channel->GetVolumeL();
-            float volumeR = channel->GetVolumeR();
-            float oldVolumeL = channel->GetOldVolumeL();
-            float oldVolumeR = channel->GetOldVolumeR();
-
-            for (int32_t i = 0; i < length * 2; i += 2)
+#endif
+            for (; i < numFrames; i++)
             {
-                float t = (float)i / (length * 2);
-                data[i] = (uint8_t)(data[i] * ((1.0 - t) * oldVolumeL + t * volumeL));
-                data[i + 1] = (uint8_t)(data[i + 1] * ((1.0 - t) * oldVolumeR + t * volumeR));
+                mix[i * 2] += src[i * 2] * (startL + stepL * i);
+                mix[i * 2 + 1] += src[i * 2 + 1] * (startR + stepR * i);
             }
         }
 
-        static void EffectFadeS16(int16_t* data, int32_t length, int32_t startvolume, int32_t endvolume)
+        /**
+         * Writes the mix buffer as signed 16-bit samples, clipping them.
+         */
+        static void WriteMixS16(int16_t* RESTRICT dst, const float* RESTRICT mix, size_t numSamples)
         {
-            static_assert(SDL_MIX_MAXVOLUME == MIXER_VOLUME_MAX, "Max volume differs between OpenRCT2 and SDL2");
-
-            float startvolume_f = (float)startvolume / SDL_MIX_MAXVOLUME;
-            float endvolume_f = (float)endvolume / SDL_MIX_MAXVOLUME;
-            for (int32_t i = 0; i < length; i++)
+            size_t i = 0;
+#if defined(__SSE2__) || defined(_M_X64)
+            // Eight samples at a time, packing with saturation clips them
+            for (; i + 8 <= numSamples; i += 8)
             {
-                float t = (float)i / length;
-                data[i] = (int16_t)(data[i] * ((1 - t) * startvolume_f + t * endvolume_f));
+                const __m128i low = _mm_cvttps_epi32(_mm_loadu_ps(mix + i));
+                const __m128i high = _mm_cvttps_epi32(_mm_loadu_ps(mix + i + 4));
+                _mm_storeu_si128((__m128i*)(dst + i), _mm_packs_epi32(low, high));
             }
-        }
-
-        static void EffectFadeU8(uint8_t* data, int32_t length, int32_t startvolume, int32_t endvolume)
-        {
-            static_assert(SDL_MIX_MAXVOLUME == MIXER_VOLUME_MAX, "Max volume differs between OpenRCT2 and SDL2");
-
-            float startvolume_f = (float)startvolume / SDL_MIX_MAXVOLUME;
-            float endvolume_f = (float)endvolume / SDL_MIX_MAXVOLUME;
-            for (int32_t i = 0; i < length; i++)
+#endif
+            for (; i < numSamples; i++)
             {
-                float t = (float)i / length;
-                data[i] = (uint8_t)(data[i] * ((1 - t) * startvolume_f + t * endvolume_f));
+                dst[i] = (int16_t)std::clamp(mix[i], (float)INT16_MIN, (float)INT16_MAX);
             }
         }
 
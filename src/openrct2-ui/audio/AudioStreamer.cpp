@@ -0,0 +1,292 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2019 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "AudioStreamer.h"
+
+#include <SDL.h>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <openrct2/config/Config.h>
+
+namespace OpenRCT2::Audio
+{
+    // The most the streamer's thread reads from a file at a time, so it can move on to the other streams
+    static constexpr size_t STREAM_READ_SIZE = 32 * 1024;
+    // The amount read on the calling thread when a stream is opened or moved, about a tenth of a second of music
+    static constexpr size_t STREAM_PREFETCH_SIZE = 8 * 1024;
+    // The streams are also topped up this often without being woken, in case a wake up was missed
+    static constexpr std::chrono::milliseconds STREAM_POLL_INTERVAL(100);
+
+    AudioStream::AudioStream(
+        AudioStreamer* streamer, SDL_RWops* rw, uint64_t dataBegin, uint64_t dataLength, uint8_t silence,
+        size_t bufferSize)
+        : _streamer(streamer)
+        , _rw(rw)
+        , _dataBegin(dataBegin)
+        , _dataLength(dataLength)
+        , _silence(silence)
+        , _buffer(std::max(bufferSize, STREAM_READ_SIZE))
+    {
+    }
+
+    AudioStream::~AudioStream()
+    {
+        SDL_RWclose(_rw);
+    }
+
+    size_t AudioStream::Read(void* dst, uint64_t offset, size_t len)
+    {
+        if (offset >= _dataLength)
+        {
+            return 0;
+        }
+
+        size_t bytesToRead = (size_t)std::min<uint64_t>(len, _dataLength - offset);
+        size_t bytesCopied;
+        bool needsFill;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (offset != _position)
+            {
+                // Skip ahead if the offset has already been read, e.g. because the channel started further in
+                uint64_t distance = (offset + _dataLength - _position) % _dataLength;
+                if (distance < _length)
+                {
+                    Discard((size_t)distance);
+                }
+                else
+                {
+                    Reset(offset);
+                }
+            }
+
+            bytesCopied = std::min(bytesToRead, _length);
+            size_t firstPart = std::min(bytesCopied, _buffer.size() - _head);
+            std::memcpy(dst, &_buffer[_head], firstPart);
+            std::memcpy((uint8_t*)dst + firstPart, _buffer.data(), bytesCopied - firstPart);
+            Discard(bytesCopied);
+
+            if (bytesCopied < bytesToRead)
+            {
+                // Play silence for the missing data and carry on from where the playback will be
+                _underruns++;
+                Reset((offset + bytesToRead) % _dataLength);
+            }
+            needsFill = _length < _buffer.size() / 2;
+        }
+
+        std::memset((uint8_t*)dst + bytesCopied, _silence, bytesToRead - bytesCopied);
+        if (needsFill)
+        {
+            _streamer->Wake();
+        }
+        return bytesToRead;
+    }
+
+    void AudioStream::Prefetch(uint64_t offset)
+    {
+        if (offset >= _dataLength)
+        {
+            return;
+        }
+
+        bool needsFill;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            uint64_t distance = (offset + _dataLength - _position) % _dataLength;
+            if (distance < _length)
+            {
+                Discard((size_t)distance);
+            }
+            else
+            {
+                Reset(offset);
+            }
+            needsFill = _length < STREAM_PREFETCH_SIZE;
+        }
+
+        if (needsFill)
+        {
+            Fill(STREAM_PREFETCH_SIZE);
+        }
+        _streamer->Wake();
+    }
+
+    void AudioStream::Close()
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _closed = true;
+    }
+
+    bool AudioStream::IsClosed()
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _closed;
+    }
+
+    uint32_t AudioStream::GetUnderrunCount()
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _underruns;
+    }
+
+    bool AudioStream::Fill(size_t maxLength)
+    {
+        std::lock_guard<std::mutex> fileLock(_fileMutex);
+
+        uint64_t readOffset;
+        size_t readLength;
+        uint32_t generation;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (_closed)
+            {
+                return false;
+            }
+            readOffset = (_position + _length) % _dataLength;
+            readLength = (size_t)std::min<uint64_t>({ _buffer.size() - _length, maxLength, _dataLength - readOffset });
+            generation = _generation;
+        }
+        if (readLength == 0)
+        {
+            return false;
+        }
+
+        // Read without holding the buffer, so the audio callback can carry on playing what has been read already
+        int64_t dataOffset = _dataBegin + readOffset;
+        if (_filePosition != dataOffset && SDL_RWseek(_rw, dataOffset, RW_SEEK_SET) == -1)
+        {
+            _filePosition = -1;
+            return false;
+        }
+        _readBuffer.resize(readLength);
+        size_t bytesRead = SDL_RWread(_rw, _readBuffer.data(), 1, readLength);
+        _filePosition = dataOffset + bytesRead;
+        if (bytesRead == 0)
+        {
+            return false;
+        }
+
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (generation == _generation)
+        {
+            size_t tail = (_head + _length) % _buffer.size();
+            size_t firstPart = std::min(bytesRead, _buffer.size() - tail);
+            std::memcpy(&_buffer[tail], _readBuffer.data(), firstPart);
+            std::memcpy(_buffer.data(), &_readBuffer[firstPart], bytesRead - firstPart);
+            _length += bytesRead;
+        }
+        return true;
+    }
+
+    void AudioStream::Reset(uint64_t offset)
+    {
+        _position = offset;
+        _head = 0;
+        _length = 0;
+        _generation++;
+    }
+
+    void AudioStream::Discard(size_t len)
+    {
+        _head = (_head + len) % _buffer.size();
+        _length -= len;
+        _position = (_position + len) % _dataLength;
+    }
+
+    AudioStreamer::~AudioStreamer()
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stopping = true;
+        }
+        _wake.notify_one();
+        if (_thread.joinable())
+        {
+            _thread.join();
+        }
+    }
+
+    std::shared_ptr<AudioStream> AudioStreamer::Open(SDL_RWops* rw, uint64_t dataBegin, uint64_t dataLength, uint8_t silence)
+    {
+        size_t bufferSize = (size_t)gConfigSound.stream_buffer_size * 1024;
+        auto stream = std::make_shared<AudioStream>(this, rw, dataBegin, dataLength, silence, bufferSize);
+        stream->Fill(STREAM_PREFETCH_SIZE);
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _streams.push_back(stream);
+            if (!_thread.joinable())
+            {
+                _thread = std::thread(&AudioStreamer::Run, this);
+            }
+        }
+        Wake();
+        return stream;
+    }
+
+    void AudioStreamer::Wake()
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _isWakePending = true;
+        }
+        _wake.notify_one();
+    }
+
+    uint32_t AudioStreamer::GetUnderrunCount()
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        uint32_t underruns = _closedUnderruns;
+        for (const auto& stream : _streams)
+        {
+            underruns += stream->GetUnderrunCount();
+        }
+        return underruns;
+    }
+
+    void AudioStreamer::Run()
+    {
+        std::vector<std::shared_ptr<AudioStream>> streams;
+        std::unique_lock<std::mutex> lock(_mutex);
+        while (!_stopping)
+        {
+            _wake.wait_for(lock, STREAM_POLL_INTERVAL, [this] { return _isWakePending || _stopping; });
+            _isWakePending = false;
+
+            auto it = _streams.begin();
+            while (it != _streams.end())
+            {
+                if ((*it)->IsClosed())
+                {
+                    _closedUnderruns += (*it)->GetUnderrunCount();
+                    streams.push_back(*it);
+                    it = _streams.erase(it);
+                }
+                else
+                {
+                    it++;
+                }
+            }
+            auto numClosedStreams = streams.size();
+            streams.insert(streams.end(), _streams.begin(), _streams.end());
+            lock.unlock();
+
+            for (size_t i = numClosedStreams; i < streams.size(); i++)
+            {
+                while (streams[i]->Fill(STREAM_READ_SIZE))
+                {
+                }
+            }
+            // The last references to the closed streams are dropped here, so their files are closed on this thread
+            streams.clear();
+            lock.lock();
+        }
+    }
+} // namespace OpenRCT2::Audio
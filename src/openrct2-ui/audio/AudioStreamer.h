@@ -0,0 +1,124 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2019 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <openrct2/common.h>
+#include <thread>
+#include <vector>
+
+struct SDL_RWops;
+
+namespace OpenRCT2::Audio
+{
+    class AudioStreamer;
+
+    /**
+     * The PCM data of a file, read ahead of the playback position into a ring buffer by the streamer's thread. Reading
+     * never touches the file, data that has not been read ahead yet is replaced by silence.
+     */
+    class AudioStream
+    {
+    private:
+        AudioStreamer* const _streamer;
+        SDL_RWops* const _rw;
+        const uint64_t _dataBegin;
+        const uint64_t _dataLength;
+        const uint8_t _silence;
+
+        // Held while reading the file, by the streamer's thread or by a thread prefetching
+        std::mutex _fileMutex;
+        std::vector<uint8_t> _readBuffer;
+        int64_t _filePosition = -1;
+
+        std::mutex _mutex;
+        std::vector<uint8_t> _buffer;
+        // The offset in the data of the first buffered byte, the buffer wraps around to the start of the data at its end
+        uint64_t _position = 0;
+        size_t _head = 0;
+        size_t _length = 0;
+        // Changed whenever the buffer is moved to another position, so data read for the old position is dropped
+        uint32_t _generation = 0;
+        uint32_t _underruns = 0;
+        bool _closed = false;
+
+    public:
+        AudioStream(
+            AudioStreamer* streamer, SDL_RWops* rw, uint64_t dataBegin, uint64_t dataLength, uint8_t silence,
+            size_t bufferSize);
+        ~AudioStream();
+
+        size_t Read(void* dst, uint64_t offset, size_t len);
+
+        /**
+         * Moves the buffer to the given offset and reads the first few kilobytes on the calling thread, for when the
+         * playback position is about to jump there.
+         */
+        void Prefetch(uint64_t offset);
+
+        /**
+         * Marks the stream as no longer used, the streamer's thread releases it and closes the file.
+         */
+        void Close();
+
+        bool IsClosed();
+        uint32_t GetUnderrunCount();
+
+        /**
+         * Reads up to maxLength bytes from the file into the buffer. Returns false if the buffer is full or nothing
+         * could be read.
+         */
+        bool Fill(size_t maxLength);
+
+    private:
+        void Reset(uint64_t offset);
+        void Discard(size_t len);
+    };
+
+    /**
+     * Keeps the streamed audio sources read ahead of their playback position on a background thread, so the audio
+     * callback only copies from memory. All streams must have been closed before the streamer is destroyed.
+     */
+    class AudioStreamer
+    {
+    private:
+        std::thread _thread;
+        std::mutex _mutex;
+        std::condition_variable _wake;
+        std::vector<std::shared_ptr<AudioStream>> _streams;
+        bool _isWakePending = false;
+        bool _stopping = false;
+        uint32_t _closedUnderruns = 0;
+
+    public:
+        ~AudioStreamer();
+
+        /**
+         * Creates a stream of the PCM data in the given range of the file, which it takes ownership of. The first few
+         * kilobytes are read on the calling thread so the stream can be played straight away.
+         */
+        std::shared_ptr<AudioStream> Open(SDL_RWops* rw, uint64_t dataBegin, uint64_t dataLength, uint8_t silence);
+
+        /**
+         * Wakes the streamer's thread to top up the streams.
+         */
+        void Wake();
+
+        /**
+         * Gets the number of times the audio callback has read from a stream faster than it could be read ahead.
+         */
+        uint32_t GetUnderrunCount();
+
+    private:
+        void Run();
+    };
+} // namespace OpenRCT2::Audio
@@ -9,6 +9,7 @@
 
 #include "AudioContext.h"
 #include "AudioFormat.h"
+#include "AudioStreamer.h"
 
 #include <SDL.h>
 #include <algorithm>
@@ -19,7 +20,7 @@ namespace OpenRCT2::Audio
 {
     /**
      * An audio source where raw PCM data is streamed directly from
-     * a file.
+     * a file, or read ahead by a streamer if there is one.
      */
     class FileAudioSource final : public ISDLAudioSource
     {
@@ -28,6 +29,7 @@ namespace OpenRCT2::Audio
         SDL_RWops* _rw = nullptr;
         uint64_t _dataBegin = 0;
         uint64_t _dataLength = 0;
+        std::shared_ptr<AudioStream> _stream;
 
     public:
         ~FileAudioSource()
@@ -45,8 +47,21 @@ namespace OpenRCT2::Audio
             return _format;
         }
 
+        void Prefetch(uint64_t offset) override
+        {
+            if (_stream != nullptr)
+            {
+                _stream->Prefetch(offset);
+            }
+        }
+
         size_t Read(void* dst, uint64_t offset, size_t len) override
         {
+            if (_stream != nullptr)
+            {
+                return _stream->Read(dst, offset, len);
+            }
+
             size_t bytesRead = 0;
             int64_t currentPosition = SDL_RWtell(_rw);
             if (currentPosition != -1)
@@ -143,6 +158,19 @@ namespace OpenRCT2::Audio
             return true;
         }
 
+        /**
+         * Hands the file over to the streamer, so the source is read ahead on its thread.
+         */
+        void Stream(AudioStreamer* streamer)
+        {
+            if (_dataLength > 0)
+            {
+                uint8_t silence = _format.format == AUDIO_U8 ? 0x80 : 0;
+                _stream = streamer->Open(_rw, _dataBegin, _dataLength, silence);
+                _rw = nullptr;
+            }
+        }
+
     private:
         uint32_t FindChunk(SDL_RWops* rw, uint32_t wantedId)
         {
@@ -171,6 +199,11 @@ namespace OpenRCT2::Audio
 
         void Unload()
         {
+            if (_stream != nullptr)
+            {
+                _stream->Close();
+                _stream = nullptr;
+            }
             if (_rw != nullptr)
             {
                 SDL_RWclose(_rw);
@@ -181,18 +214,18 @@ namespace OpenRCT2::Audio
         }
     };
 
-    IAudioSource* AudioSource::CreateStreamFromWAV(const std::string& path)
+    IAudioSource* AudioSource::CreateStreamFromWAV(const std::string& path, AudioStreamer* streamer)
     {
         IAudioSource* source = nullptr;
         SDL_RWops* rw = SDL_RWFromFile(path.c_str(), "rb");
         if (rw != nullptr)
         {
-            return AudioSource::CreateStreamFromWAV(rw);
+            return AudioSource::CreateStreamFromWAV(rw, streamer);
         }
         return source;
     }
 
-    IAudioSource* AudioSource::CreateStreamFromWAV(SDL_RWops* rw)
+    IAudioSource* AudioSource::CreateStreamFromWAV(SDL_RWops* rw, AudioStreamer* streamer)
     {
         auto source = new FileAudioSource();
         if (!source->LoadWAV(rw))
@@ -200,6 +233,10 @@ namespace OpenRCT2::Audio
             delete source;
             source = nullptr;
         }
+        else if (streamer != nullptr)
+        {
+            source->Stream(streamer);
+        }
         return source;
     }
 } // namespace OpenRCT2::Audio
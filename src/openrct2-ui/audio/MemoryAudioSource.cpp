@@ -52,6 +52,10 @@ namespace OpenRCT2::Audio
             return _format;
         }
 
+        void Prefetch(uint64_t /*offset*/) override
+        {
+        }
+
         size_t Read(void* dst, uint64_t offset, size_t len) override
         {
             size_t bytesToRead = 0;
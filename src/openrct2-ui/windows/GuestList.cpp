@@ -16,6 +16,7 @@
 #include <openrct2/config/Config.h>
 #include <openrct2/drawing/Drawing.h>
 #include <openrct2/localisation/Localisation.h>
+#include <openrct2/peep/GuestSummary.h>
 #include <openrct2/scenario/Scenario.h>
 #include <openrct2/sprites.h>
 #include <openrct2/util/Util.h>
@@ -49,6 +50,7 @@ enum {
     VIEW_THOUGHTS,
     VIEW_COUNT
 };
+static_assert(static_cast<int32_t>(VIEW_COUNT) == GUEST_SUMMARY_VIEW_COUNT, "Guest list views must match guest summary views");
 
 static constexpr const rct_string_id pageNames[] = {
     STR_PAGE_1,
@@ -173,7 +175,6 @@ static FilterArguments _window_guest_list_filter_arguments;
 static uint16_t _window_guest_list_groups_num_guests[240];
 static FilterArguments _window_guest_list_groups_arguments[240];
 static uint8_t _window_guest_list_groups_guest_faces[240 * 58];
-static uint8_t _window_guest_list_group_index[240];
 
 static char _window_guest_list_filter_name[32];
 
@@ -905,24 +906,11 @@ static int32_t window_guest_list_is_peep_in_filter(Peep* peep)
  */
 static FilterArguments get_arguments_from_peep(const Peep* peep)
 {
+    auto key = guest_summary_get_key(peep, _window_guest_list_selected_view);
+
     FilterArguments result;
-    switch (_window_guest_list_selected_view)
-    {
-        case VIEW_ACTIONS:
-            peep->FormatActionTo(result.args);
-            break;
-        case VIEW_THOUGHTS:
-        {
-            auto thought = &peep->thoughts[0];
-            if (thought->freshness <= 5 && thought->type != PEEP_THOUGHT_TYPE_NONE)
-            {
-                std::memset(gCommonFormatArgs, 0, sizeof(gCommonFormatArgs));
-                peep_thought_set_format_args(thought);
-                std::memcpy(result.args, gCommonFormatArgs, std::min(sizeof(gCommonFormatArgs), sizeof(result.args)));
-            }
-            break;
-        }
-    }
+    static_assert(sizeof(result.args) == sizeof(key.Args), "Guest list arguments must match guest summary keys");
+    std::memcpy(result.args, key.Args, sizeof(result.args));
     return result;
 }
 
@@ -932,9 +920,6 @@ static FilterArguments get_arguments_from_peep(const Peep* peep)
  */
 static void window_guest_list_find_groups()
 {
-    int32_t spriteIndex, spriteIndex2, groupIndex, faceIndex;
-    Peep *peep, *peep2;
-
     uint32_t tick256 = floor2(gScenarioTicks, 256);
     if (_window_guest_list_selected_view == _window_guest_list_last_find_groups_selected_view)
     {
@@ -949,99 +934,29 @@ static void window_guest_list_find_groups()
     _window_guest_list_last_find_groups_wait = 320;
     _window_guest_list_num_groups = 0;
 
-    // Set all guests to unassigned
-    FOR_ALL_GUESTS (spriteIndex, peep)
-        if (peep->outside_of_park == 0)
-            peep->flags |= SPRITE_FLAGS_PEEP_VISIBLE;
-
-    // For each guest / group
-    FOR_ALL_GUESTS (spriteIndex, peep)
+    // The groups come largest first, cap at 240 though
+    for (const auto group : guest_summary_get_groups(_window_guest_list_selected_view))
     {
-        if (peep->outside_of_park != 0 || !(peep->flags & SPRITE_FLAGS_PEEP_VISIBLE))
-            continue;
-
-        // New group, cap at 240 though
-        groupIndex = _window_guest_list_num_groups;
-        if (groupIndex >= 240)
+        if (_window_guest_list_num_groups >= 240)
             break;
 
-        _window_guest_list_num_groups++;
-        _window_guest_list_groups_num_guests[groupIndex] = 1;
-        peep->flags &= ~(SPRITE_FLAGS_PEEP_VISIBLE);
-
-        _window_guest_list_groups_arguments[groupIndex] = get_arguments_from_peep(peep);
-        _window_guest_list_filter_arguments = _window_guest_list_groups_arguments[groupIndex];
+        FilterArguments arguments;
+        std::memcpy(arguments.args, group->Key.Args, sizeof(arguments.args));
+        if (arguments.GetFirstStringId() == 0)
+            continue;
 
-        _window_guest_list_group_index[groupIndex] = groupIndex;
-        faceIndex = groupIndex * 56;
-        _window_guest_list_groups_guest_faces[faceIndex++] = get_peep_face_sprite_small(peep)
-            - SPR_PEEP_SMALL_FACE_VERY_VERY_UNHAPPY;
+        int32_t groupIndex = _window_guest_list_num_groups++;
+        _window_guest_list_groups_num_guests[groupIndex] = static_cast<uint16_t>(group->Guests.size());
+        _window_guest_list_groups_arguments[groupIndex] = arguments;
 
-        // Find more peeps that belong to same group
-        FOR_ALL_GUESTS (spriteIndex2, peep2)
+        // Add face sprites, cap at 56 though
+        int32_t faceIndex = groupIndex * 56;
+        for (size_t i = 0; i < 56 && i < group->Guests.size(); i++)
         {
-            if (peep2->outside_of_park != 0 || !(peep2->flags & SPRITE_FLAGS_PEEP_VISIBLE))
-                continue;
-
-            // Get and check if in same group
-            auto argument12 = get_arguments_from_peep(peep2);
-            if (argument12 != _window_guest_list_groups_arguments[groupIndex])
-                continue;
-
-            // Assign guest
-            _window_guest_list_groups_num_guests[groupIndex]++;
-            peep2->flags &= ~(SPRITE_FLAGS_PEEP_VISIBLE);
-
-            // Add face sprite, cap at 56 though
-            if (_window_guest_list_groups_num_guests[groupIndex] >= 56)
-                continue;
-            _window_guest_list_groups_guest_faces[faceIndex++] = get_peep_face_sprite_small(peep2)
+            auto peep = GET_PEEP(group->Guests[i]);
+            _window_guest_list_groups_guest_faces[faceIndex++] = get_peep_face_sprite_small(peep)
                 - SPR_PEEP_SMALL_FACE_VERY_VERY_UNHAPPY;
         }
-
-        if (_window_guest_list_filter_arguments.GetFirstStringId() == 0)
-        {
-            _window_guest_list_num_groups--;
-            continue;
-        }
-
-        auto curr_num_guests = _window_guest_list_groups_num_guests[groupIndex];
-        int32_t swap_position = 0;
-        // This section places the groups in size order.
-        bool gotoNextPeep = false;
-        while (1)
-        {
-            if (swap_position >= groupIndex)
-            {
-                gotoNextPeep = true;
-                break;
-            }
-            if (curr_num_guests > _window_guest_list_groups_num_guests[swap_position])
-                break;
-            swap_position++;
-        }
-        if (gotoNextPeep)
-        {
-            continue;
-        }
-
-        auto arguments12 = _window_guest_list_groups_arguments[groupIndex];
-        auto bl = _window_guest_list_group_index[groupIndex];
-
-        do
-        {
-            std::swap(curr_num_guests, _window_guest_list_groups_num_guests[swap_position]);
-            std::swap(arguments12, _window_guest_list_groups_arguments[swap_position]);
-
-            uint8_t temp_faces[56];
-            std::memcpy(temp_faces, &(_window_guest_list_groups_guest_faces[groupIndex * 56]), 56);
-            std::memcpy(
-                &(_window_guest_list_groups_guest_faces[groupIndex * 56]),
-                &(_window_guest_list_groups_guest_faces[swap_position * 56]), 56);
-            std::memcpy(&(_window_guest_list_groups_guest_faces[swap_position * 56]), temp_faces, 56);
-
-            std::swap(bl, _window_guest_list_group_index[swap_position]);
-        } while (++swap_position <= groupIndex);
     }
 }
 
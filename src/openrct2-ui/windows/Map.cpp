@@ -27,6 +27,7 @@
 #include <openrct2/ride/Track.h>
 #include <openrct2/world/Entrance.h>
 #include <openrct2/world/Footpath.h>
+#include <openrct2/world/MapDirtyTiles.h>
 #include <openrct2/world/Scenery.h>
 #include <openrct2/world/Sprite.h>
 #include <openrct2/world/Surface.h>
@@ -177,6 +178,10 @@ static uint32_t _currentLine;
 /** rct2: 0x00F1AD68 */
 static std::vector<uint8_t> _mapImageData;
 
+// Whether all pixels of the map image are being set, after which only the pixels of changed tiles are
+static bool _isSettingAllPixels;
+static std::vector<TileCoordsXY> _dirtyTiles;
+
 static uint16_t _landRightsToolSize;
 
 static void window_map_init_map();
@@ -197,6 +202,8 @@ static void window_map_set_peep_spawn_tool_down(ScreenCoordsXY screenCoords);
 static void map_window_increase_map_size();
 static void map_window_decrease_map_size();
 static void map_window_set_pixels(rct_window* w);
+static void map_window_set_dirty_tile_pixels(rct_window* w);
+static void map_window_set_all_pixels();
 
 static CoordsXY map_window_screen_to_map(ScreenCoordsXY screenCoords);
 
@@ -377,6 +384,7 @@ static void window_map_mouseup(rct_window* w, rct_widgetindex widgetIndex)
 
                 w->selected_tab = widgetIndex;
                 w->list_information_type = 0;
+                map_window_set_all_pixels();
             }
     }
 }
@@ -436,8 +444,9 @@ static void window_map_update(rct_window* w)
         window_map_centre_on_view_point();
     }
 
-    for (int32_t i = 0; i < 16; i++)
+    for (int32_t i = 0; i < 16 && _isSettingAllPixels; i++)
         map_window_set_pixels(w);
+    map_window_set_dirty_tile_pixels(w);
 
     w->Invalidate();
 
@@ -901,7 +910,11 @@ static void window_map_scrollpaint(rct_window* w, rct_drawpixelinfo* dpi, int32_
 static void window_map_init_map()
 {
     std::fill(_mapImageData.begin(), _mapImageData.end(), PALETTE_INDEX_10);
-    _currentLine = 0;
+    map_window_set_all_pixels();
+
+    // Tiles that have changed until now are set along with all others
+    _dirtyTiles.clear();
+    map_dirty_tiles_take(_dirtyTiles);
 }
 
 /**
@@ -1623,15 +1636,39 @@ static uint16_t map_window_get_pixel_colour_ride(CoordsXY c)
     return colourB;
 }
 
+static void map_window_set_tile_pixel(rct_window* w, const CoordsXY& c, uint8_t* destination)
+{
+    if (c.x > 0 && c.y > 0 && c.x < gMapSizeUnits && c.y < gMapSizeUnits)
+    {
+        uint16_t colour = 0;
+        switch (w->selected_tab)
+        {
+            case PAGE_PEEPS:
+                colour = map_window_get_pixel_colour_peep(c);
+                break;
+            case PAGE_RIDES:
+                colour = map_window_get_pixel_colour_ride(c);
+                break;
+        }
+        destination[0] = (colour >> 8) & 0xFF;
+        destination[1] = colour;
+    }
+}
+
+/**
+ * Gets the pixels of the i-th tile on the given line, the lines being the diagonals of the map image.
+ */
+static uint8_t* map_window_get_tile_pixels(int32_t line, int32_t i)
+{
+    int32_t pos = (line * (MAP_WINDOW_MAP_SIZE - 1)) + MAXIMUM_MAP_SIZE_TECHNICAL - 1;
+    int32_t destinationX = (pos % MAP_WINDOW_MAP_SIZE) + i;
+    int32_t destinationY = (pos / MAP_WINDOW_MAP_SIZE) + i;
+    return _mapImageData.data() + (destinationY * MAP_WINDOW_MAP_SIZE) + destinationX;
+}
+
 static void map_window_set_pixels(rct_window* w)
 {
-    uint16_t colour = 0;
     int32_t x = 0, y = 0, dx = 0, dy = 0;
-
-    int32_t pos = (_currentLine * (MAP_WINDOW_MAP_SIZE - 1)) + MAXIMUM_MAP_SIZE_TECHNICAL - 1;
-    LocationXY16 destinationPosition = { static_cast<int16_t>(pos % MAP_WINDOW_MAP_SIZE),
-                                         static_cast<int16_t>(pos / MAP_WINDOW_MAP_SIZE) };
-    auto destination = _mapImageData.data() + (destinationPosition.y * MAP_WINDOW_MAP_SIZE) + destinationPosition.x;
     switch (get_current_rotation())
     {
         case 0:
@@ -1662,30 +1699,67 @@ static void map_window_set_pixels(rct_window* w)
 
     for (int32_t i = 0; i < MAXIMUM_MAP_SIZE_TECHNICAL; i++)
     {
-        if (x > 0 && y > 0 && x < gMapSizeUnits && y < gMapSizeUnits)
-        {
-            switch (w->selected_tab)
-            {
-                case PAGE_PEEPS:
-                    colour = map_window_get_pixel_colour_peep({ x, y });
-                    break;
-                case PAGE_RIDES:
-                    colour = map_window_get_pixel_colour_ride({ x, y });
-                    break;
-            }
-            destination[0] = (colour >> 8) & 0xFF;
-            destination[1] = colour;
-        }
+        map_window_set_tile_pixel(w, { x, y }, map_window_get_tile_pixels(_currentLine, i));
         x += dx;
         y += dy;
-
-        destinationPosition.x++;
-        destinationPosition.y++;
-        destination = _mapImageData.data() + (destinationPosition.y * MAP_WINDOW_MAP_SIZE) + destinationPosition.x;
     }
     _currentLine++;
     if (_currentLine >= MAXIMUM_MAP_SIZE_TECHNICAL)
+    {
         _currentLine = 0;
+        _isSettingAllPixels = false;
+    }
+}
+
+/**
+ * Sets the pixels of the tiles that have changed since the last update, or starts setting all pixels again if all
+ * tiles have changed.
+ */
+static void map_window_set_dirty_tile_pixels(rct_window* w)
+{
+    _dirtyTiles.clear();
+    if (!map_dirty_tiles_take(_dirtyTiles))
+    {
+        map_window_set_all_pixels();
+        return;
+    }
+
+    // The inverse of the tile positions of the lines in map_window_set_pixels
+    constexpr int32_t lastTile = MAXIMUM_MAP_SIZE_TECHNICAL - 1;
+    for (const auto& tile : _dirtyTiles)
+    {
+        int32_t line = 0, i = 0;
+        switch (get_current_rotation())
+        {
+            case 0:
+                line = tile.x;
+                i = tile.y;
+                break;
+            case 1:
+                line = tile.y;
+                i = lastTile - tile.x;
+                break;
+            case 2:
+                line = lastTile - tile.x;
+                i = lastTile - tile.y;
+                break;
+            case 3:
+                line = lastTile - tile.y;
+                i = tile.x;
+                break;
+        }
+        map_window_set_tile_pixel(w, tile.ToCoordsXY(), map_window_get_tile_pixels(line, i));
+    }
+}
+
+/**
+ * Starts setting the pixels of all tiles again, one line per call of map_window_set_pixels, without clearing the
+ * map image first.
+ */
+static void map_window_set_all_pixels()
+{
+    _currentLine = 0;
+    _isSettingAllPixels = true;
 }
 
 static CoordsXY map_window_screen_to_map(ScreenCoordsXY screenCoords)
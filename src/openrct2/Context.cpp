@@ -36,6 +36,8 @@
 #include "core/MemoryStream.h"
 #include "core/Path.hpp"
 #include "core/String.hpp"
+#include "core/TaskGraph.hpp"
+#include "core/Trace.h"
 #include "drawing/IDrawingEngine.h"
 #include "drawing/LightFX.h"
 #include "interface/Chat.h"
@@ -240,7 +242,16 @@ namespace OpenRCT2
 
         int32_t RunOpenRCT2(int argc, const char** argv) override
         {
-            if (Initialise())
+            bool initialised;
+            {
+                Trace::Scope traceScope("Initialise");
+                initialised = Initialise();
+            }
+            if (Trace::IsEnabled())
+            {
+                WriteStartupTrace();
+            }
+            if (initialised)
             {
                 Launch();
                 return EXIT_SUCCESS;
@@ -363,6 +374,7 @@ namespace OpenRCT2
 
             try
             {
+                Trace::Scope traceScope("Language and fonts");
                 _localisationService->OpenLanguage(gConfigGeneral.language, *_objectManager);
             }
             catch (const std::exception& e)
@@ -394,26 +406,30 @@ namespace OpenRCT2
 
             if (!gOpenRCT2Headless)
             {
+                Trace::Scope traceScope("Window");
                 _uiContext->CreateWindow();
             }
 
             EnsureUserContentDirectoriesExist();
 
+            // The repositories and title sequences do not depend on each other or on the graphics, so they
+            // are scanned in the background while the graphics and audio are loaded on this thread.
             // TODO Ideally we want to delay this until we show the title so that we can
             //      still open the game window and draw a progress screen for the creation
             //      of the object cache.
-            _objectRepository->LoadOrConstruct(_localisationService->GetCurrentLanguage());
-
-            // TODO Like objects, this can take a while if there are a lot of track designs
-            //      its also really something really we might want to do in the background
-            //      as its not required until the player wants to place a new ride.
-            _trackDesignRepository->Scan(_localisationService->GetCurrentLanguage());
-
-            _scenarioRepository->Scan(_localisationService->GetCurrentLanguage());
-            TitleSequenceManager::Scan();
+            auto language = _localisationService->GetCurrentLanguage();
+            TaskGraph initialisationTasks;
+            initialisationTasks.Add("Object repository", [this, language]() { _objectRepository->LoadOrConstruct(language); });
+            initialisationTasks.Add("Track design repository", [this, language]() { _trackDesignRepository->Scan(language); });
+            auto copyUserFiles = initialisationTasks.Add(
+                "Copy original user files", [this]() { CopyOriginalUserFilesOver(); });
+            initialisationTasks.Add(
+                "Scenario repository", [this, language]() { _scenarioRepository->Scan(language); }, { copyUserFiles });
+            initialisationTasks.Add("Title sequences", []() { TitleSequenceManager::Scan(); });
 
             if (!gOpenRCT2Headless)
             {
+                Trace::Scope traceScope("Audio");
                 audio_init();
                 audio_populate_devices();
                 audio_init_ride_sounds_and_info();
@@ -421,10 +437,10 @@ namespace OpenRCT2
 
             network_set_env(_env);
             chat_init();
-            CopyOriginalUserFilesOver();
 
             if (!gOpenRCT2NoGraphics)
             {
+                Trace::Scope traceScope("Base graphics");
                 if (!LoadBaseGraphics())
                 {
                     return false;
@@ -434,6 +450,11 @@ namespace OpenRCT2
 #endif
             }
 
+            {
+                Trace::Scope traceScope("Waiting for background initialisation");
+                initialisationTasks.WaitAll();
+            }
+
             gScenarioTicks = 0;
             input_reset_place_obj_modifier();
             viewport_init_all();
@@ -670,6 +691,20 @@ namespace OpenRCT2
             return result;
         }
 
+        void WriteStartupTrace()
+        {
+            try
+            {
+                Trace::WriteChromeTrace(gStartupTracePath);
+                Console::WriteLine("Startup trace written to '%s'", gStartupTracePath);
+            }
+            catch (const std::exception& e)
+            {
+                Console::Error::WriteLine("Unable to write startup trace: '%s'.", gStartupTracePath);
+                Console::Error::WriteLine("%s", e.what());
+            }
+        }
+
         bool LoadBaseGraphics()
         {
             if (!gfx_load_g1(*_env))
@@ -1103,6 +1138,22 @@ namespace OpenRCT2
     {
         return Context::Instance;
     }
+
+    static Audio::AudioContextFactory _audioContextFactory = nullptr;
+
+    void Audio::SetAudioContextFactory(Audio::AudioContextFactory factory)
+    {
+        _audioContextFactory = factory;
+    }
+
+    std::unique_ptr<Audio::IAudioContext> Audio::CreateAudioContextFromFactory()
+    {
+        if (_audioContextFactory == nullptr)
+        {
+            return nullptr;
+        }
+        return _audioContextFactory();
+    }
 } // namespace OpenRCT2
 
 void context_init()
@@ -42,6 +42,7 @@ extern utf8 gCustomOpenrctDataPath[MAX_PATH];
 extern utf8 gCustomRCT1DataPath[MAX_PATH];
 extern utf8 gCustomRCT2DataPath[MAX_PATH];
 extern utf8 gCustomPassword[MAX_PATH];
+extern utf8 gStartupTracePath[MAX_PATH];
 extern bool gOpenRCT2Headless;
 extern bool gOpenRCT2NoGraphics;
 extern bool gOpenRCT2ShowChangelog;
@@ -19,6 +19,7 @@
 #include "../ride/Ride.h"
 #include "../ui/UiContext.h"
 #include "../ui/WindowManager.h"
+#include "../world/MapDirtyTiles.h"
 #include "../world/Park.h"
 #include "GameAction.h"
 
@@ -156,6 +157,7 @@ public:
                 gfx_invalidate_screen();
                 break;
         }
+        map_dirty_tiles_mark_ride(_rideIndex);
         window_invalidate_by_number(WC_RIDE, _rideIndex);
 
         auto res = std::make_unique<GameActionResult>();
@@ -16,6 +16,7 @@
 #include "../interface/Window.h"
 #include "../localisation/Localisation.h"
 #include "../localisation/StringIds.h"
+#include "../peep/GuestSummary.h"
 #include "../ride/Ride.h"
 #include "../ui/UiContext.h"
 #include "../ui/WindowManager.h"
@@ -85,6 +86,8 @@ public:
         {
             ride->custom_name = _name;
         }
+        // The guest summary refers to the name of the ride
+        guest_summary_invalidate();
 
         scrolling_text_invalidate();
         gfx_invalidate_screen();
@@ -11,6 +11,7 @@
 
 #include "../ride/Ride.h"
 #include "../ride/RideData.h"
+#include "../world/MapDirtyTiles.h"
 #include "GameAction.h"
 
 enum class RideSetSetting : uint8_t
@@ -239,6 +240,7 @@ public:
             case RideSetSetting::RideType:
                 ride->type = _value;
                 gfx_invalidate_screen();
+                map_dirty_tiles_mark_ride(ride->id);
                 break;
         }
 
@@ -9,6 +9,9 @@
 
 #pragma once
 
+#include "../peep/FootpathGraph.h"
+#include "../ride/TrackCircuit.h"
+#include "../world/MapAreaSummary.h"
 #include "../world/TileInspector.h"
 #include "GameAction.h"
 
@@ -83,7 +86,15 @@ public:
 
     GameActionResult::Ptr Execute() const override
     {
-        return QueryExecute(true);
+        auto res = QueryExecute(true);
+        if (res->Error == GA_ERROR::OK)
+        {
+            // The tile inspector can change elements in ways the element setters do not notice
+            footpath_graph_invalidate_tile(TileCoordsXY(_loc));
+            map_area_summary_invalidate_all();
+            track_circuit_invalidate();
+        }
+        return res;
     }
 
 private:
@@ -34,6 +34,8 @@ namespace OpenRCT2::Audio
         virtual void SetOutputDevice(const std::string& deviceName) abstract;
 
         virtual IAudioSource* CreateStreamFromWAV(const std::string& path) abstract;
+        // The number of times streamed audio was played faster than it could be read from disk
+        virtual uint32_t GetStreamUnderrunCount() abstract;
 
         virtual void StartTitleMusic() abstract;
 
@@ -53,6 +55,15 @@ namespace OpenRCT2::Audio
         virtual void StopVehicleSounds() abstract;
     };
 
+    using AudioContextFactory = std::unique_ptr<IAudioContext> (*)();
+
     std::unique_ptr<IAudioContext> CreateDummyAudioContext();
 
+    /**
+     * Sets the function that creates an audio context with a mixer, for commands that mix audio without running the game
+     * (e.g. benchaudio). Only the UI has a mixer, so without a factory no context is created.
+     */
+    void SetAudioContextFactory(AudioContextFactory factory);
+    std::unique_ptr<IAudioContext> CreateAudioContextFromFactory();
+
 } // namespace OpenRCT2::Audio
@@ -14,6 +14,8 @@
 #define MIXER_VOLUME_MAX 128
 #define MIXER_LOOP_NONE 0
 #define MIXER_LOOP_INFINITE (-1)
+#define MIXER_OUTPUT_FREQUENCY 22050
+#define MIXER_OUTPUT_CHANNELS 2
 
 enum class SoundId : uint8_t;
 
@@ -37,6 +39,10 @@ namespace OpenRCT2::Audio
         virtual ~IAudioMixer() = default;
 
         virtual void Init(const char* device) abstract;
+        // Mixes without opening a device, the audio is instead only mixed when it is taken with Render
+        virtual void InitOffline() abstract;
+        // Mixes the next numFrames of signed 16-bit frames with MIXER_OUTPUT_CHANNELS at MIXER_OUTPUT_FREQUENCY
+        virtual void Render(int16_t * dst, size_t numFrames) abstract;
         virtual void Close() abstract;
         virtual void Lock() abstract;
         virtual void Unlock() abstract;
@@ -31,6 +31,11 @@ namespace OpenRCT2::Audio
             return nullptr;
         }
 
+        uint32_t GetStreamUnderrunCount() override
+        {
+            return 0;
+        }
+
         void StartTitleMusic() override
         {
         }
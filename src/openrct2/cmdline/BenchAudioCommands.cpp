@@ -0,0 +1,236 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2019 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "../Context.h"
+#include "../OpenRCT2.h"
+#include "../PlatformEnvironment.h"
+#include "../audio/AudioContext.h"
+#include "../audio/AudioMixer.h"
+#include "../audio/audio.h"
+#include "../config/Config.h"
+#include "../core/Console.hpp"
+#include "../core/FileStream.hpp"
+#include "../platform/platform.h"
+#include "../ui/UiContext.h"
+#include "CommandLine.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <ctime>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+using namespace OpenRCT2;
+using namespace OpenRCT2::Audio;
+
+// The looping sounds vehicles play while moving
+static constexpr const SoundId BenchVehicleSounds[] = {
+    SoundId::LiftClassic,        SoundId::TrackFrictionClassicWood, SoundId::LiftFrictionWheels, SoundId::GoKartEngine,
+    SoundId::TrackFrictionTrain, SoundId::TrackFrictionWater,       SoundId::LiftWildMouse,      SoundId::TrackFrictionBM,
+};
+
+struct BenchAudioChannel
+{
+    void* Channel;
+    bool IsVehicle;
+};
+
+static exitcode_t HandleBenchAudio(CommandLineArgEnumerator* argEnumerator);
+static std::vector<BenchAudioChannel> BenchAudioPlayChannels(int32_t numChannels);
+static void BenchAudioUpdateChannels(const std::vector<BenchAudioChannel>& channels, uint32_t tick);
+static bool BenchAudioWriteWAV(const char* path, const std::vector<int16_t>& samples);
+
+const CommandLineCommand CommandLine::BenchAudioCommands[]{
+    // Main commands
+    DefineCommand("", "<channels> <seconds> [wav-file]", nullptr, HandleBenchAudio), CommandTableEnd
+};
+
+static exitcode_t HandleBenchAudio(CommandLineArgEnumerator* argEnumerator)
+{
+    const char** argv = (const char**)argEnumerator->GetArguments() + argEnumerator->GetIndex();
+    int32_t argc = argEnumerator->GetCount() - argEnumerator->GetIndex();
+
+    if (argc < 2)
+    {
+        Console::Error::WriteLine("Missing arguments <channels> <seconds>.");
+        return EXITCODE_FAIL;
+    }
+
+    core_init();
+
+    int32_t numChannels = std::max(1, atoi(argv[0]));
+    uint32_t seconds = std::max(1, atoi(argv[1]));
+    const char* outputPath = argc >= 3 ? argv[2] : nullptr;
+
+    auto audioContext = CreateAudioContextFromFactory();
+    if (audioContext == nullptr)
+    {
+        Console::Error::WriteLine("Audio can not be mixed by this build.");
+        return EXITCODE_FAIL;
+    }
+
+    gOpenRCT2Headless = true;
+    gOpenRCT2NoGraphics = true;
+
+    std::unique_ptr<IContext> context(
+        CreateContext(CreatePlatformEnvironment(), std::move(audioContext), Ui::CreateDummyUiContext()));
+    if (!context->Initialise())
+    {
+        Console::Error::WriteLine("Context initialization failed.");
+        return EXITCODE_FAIL;
+    }
+
+    // Mix everything at full volume, whatever the configuration says
+    gConfigSound.master_sound_enabled = true;
+    gConfigSound.master_volume = 100;
+    gConfigSound.sound_enabled = true;
+    gConfigSound.sound_volume = 100;
+    gConfigSound.ride_music_enabled = true;
+    gConfigSound.ride_music_volume = 100;
+
+    auto mixer = context->GetAudioContext()->GetMixer();
+    mixer->InitOffline();
+    auto channels = BenchAudioPlayChannels(numChannels);
+
+    // The channels are updated and the audio is mixed a game tick at a time, as the game would with an audio device
+    std::vector<int16_t> output;
+    std::vector<int16_t> chunk;
+    std::vector<double> tickDurations;
+    uint32_t ticks = seconds * GAME_UPDATE_FPS;
+    tickDurations.reserve(ticks);
+    Console::WriteLine("Mixing %d channels for %u seconds...", numChannels, seconds);
+    std::clock_t startCpuTime = std::clock();
+    for (uint32_t tick = 0; tick < ticks; tick++)
+    {
+        BenchAudioUpdateChannels(channels, tick);
+
+        size_t numFrames = ((tick + 1) * (uint64_t)MIXER_OUTPUT_FREQUENCY / GAME_UPDATE_FPS)
+            - (tick * (uint64_t)MIXER_OUTPUT_FREQUENCY / GAME_UPDATE_FPS);
+        chunk.resize(numFrames * MIXER_OUTPUT_CHANNELS);
+
+        auto startTime = std::chrono::high_resolution_clock::now();
+        mixer->Render(chunk.data(), numFrames);
+        std::chrono::duration<double, std::milli> duration = std::chrono::high_resolution_clock::now() - startTime;
+        tickDurations.push_back(duration.count());
+
+        if (outputPath != nullptr)
+        {
+            output.insert(output.end(), chunk.begin(), chunk.end());
+        }
+    }
+    double cpuMilliseconds = (std::clock() - startCpuTime) * 1000.0 / CLOCKS_PER_SEC;
+
+    std::sort(tickDurations.begin(), tickDurations.end());
+    auto percentile = [&tickDurations](size_t percent) { return tickDurations[(tickDurations.size() - 1) * percent / 100]; };
+    Console::WriteLine("CPU time per second of audio (ms): %.3f", cpuMilliseconds / seconds);
+    Console::WriteLine(
+        "Mixing time per tick (ms): min %.3f, median %.3f, 95th percentile %.3f, 99th percentile %.3f, max %.3f",
+        tickDurations.front(), percentile(50), percentile(95), percentile(99), tickDurations.back());
+    Console::WriteLine("Streamed audio underruns: %u", context->GetAudioContext()->GetStreamUnderrunCount());
+
+    mixer->Close();
+
+    if (outputPath != nullptr && !BenchAudioWriteWAV(outputPath, output))
+    {
+        return EXITCODE_FAIL;
+    }
+    return EXITCODE_OK;
+}
+
+/**
+ * Plays the crowd noise on the first channel, ride music on every fourth and vehicle sounds on the rest.
+ */
+static std::vector<BenchAudioChannel> BenchAudioPlayChannels(int32_t numChannels)
+{
+    std::vector<BenchAudioChannel> channels;
+    for (int32_t i = 0; i < numChannels; i++)
+    {
+        void* channel;
+        bool isVehicle = false;
+        if (i == 0)
+        {
+            channel = Mixer_Play_Music(PATH_ID_CSS2, MIXER_LOOP_INFINITE, false);
+        }
+        else if (i % 4 == 0)
+        {
+            const auto& musicInfo = gRideMusicInfoList[(i / 4) % std::size(gRideMusicInfoList)];
+            channel = Mixer_Play_Music(musicInfo.path_id, MIXER_LOOP_INFINITE, true);
+        }
+        else
+        {
+            auto soundId = BenchVehicleSounds[i % std::size(BenchVehicleSounds)];
+            channel = Mixer_Play_Effect(soundId, MIXER_LOOP_INFINITE, MIXER_VOLUME_MAX, 0.5f, 1, 0);
+            isVehicle = true;
+        }
+
+        if (channel == nullptr)
+        {
+            Console::Error::WriteLine("Unable to play channel %d, it will be left out.", i);
+            continue;
+        }
+        channels.push_back({ channel, isVehicle });
+    }
+    return channels;
+}
+
+/**
+ * Moves every channel's source around the listener, changing the volume and pan every tick and the rate of the vehicle
+ * sounds every fourth tick like vehicle_sounds_update does for the vehicles in view.
+ */
+static void BenchAudioUpdateChannels(const std::vector<BenchAudioChannel>& channels, uint32_t tick)
+{
+    for (size_t i = 0; i < channels.size(); i++)
+    {
+        double angle = (tick + i * 37) * 0.02;
+        int32_t pan = (int32_t)(std::sin(angle) * DSBPAN_RIGHT);
+        int32_t volume = (int32_t)((std::cos(angle * 0.7) - 1) * 1000);
+        Mixer_Channel_Volume(channels[i].Channel, DStoMixerVolume(volume));
+        Mixer_Channel_Pan(channels[i].Channel, DStoMixerPan(pan));
+        if (channels[i].IsVehicle && !(tick & 3))
+        {
+            int32_t frequency = 22050 + (int32_t)(std::sin(angle * 1.3) * 11025);
+            Mixer_Channel_Rate(channels[i].Channel, DStoMixerRate(frequency));
+        }
+    }
+}
+
+static bool BenchAudioWriteWAV(const char* path, const std::vector<int16_t>& samples)
+{
+    try
+    {
+        uint32_t dataLength = (uint32_t)(samples.size() * sizeof(int16_t));
+        uint16_t blockAlign = MIXER_OUTPUT_CHANNELS * sizeof(int16_t);
+
+        auto fs = FileStream(path, FILE_MODE_WRITE);
+        fs.Write("RIFF", 4);
+        fs.WriteValue<uint32_t>(36 + dataLength);
+        fs.Write("WAVE", 4);
+        fs.Write("fmt ", 4);
+        fs.WriteValue<uint32_t>(16);
+        fs.WriteValue<uint16_t>(1); // PCM
+        fs.WriteValue<uint16_t>(MIXER_OUTPUT_CHANNELS);
+        fs.WriteValue<uint32_t>(MIXER_OUTPUT_FREQUENCY);
+        fs.WriteValue<uint32_t>(MIXER_OUTPUT_FREQUENCY * blockAlign);
+        fs.WriteValue<uint16_t>(blockAlign);
+        fs.WriteValue<uint16_t>(16);
+        fs.Write("data", 4);
+        fs.WriteValue<uint32_t>(dataLength);
+        fs.Write(samples.data(), dataLength);
+        Console::WriteLine("Mixed audio written to '%s'.", path);
+        return true;
+    }
+    catch (const std::exception& e)
+    {
+        Console::Error::WriteLine("Unable to write '%s': %s", path, e.what());
+        return false;
+    }
+}
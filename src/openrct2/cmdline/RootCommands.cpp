@@ -17,6 +17,7 @@
 #include "../core/Memory.hpp"
 #include "../core/Path.hpp"
 #include "../core/String.hpp"
+#include "../core/Trace.h"
 #include "../localisation/Language.h"
 #include "../network/network.h"
 #include "../object/ObjectRepository.h"
@@ -58,6 +59,7 @@ static utf8* _openrctDataPath = nullptr;
 static utf8* _rct1DataPath = nullptr;
 static utf8* _rct2DataPath = nullptr;
 static bool _silentBreakpad = false;
+static utf8* _tracePath = nullptr;
 
 // clang-format off
 static constexpr const CommandLineOptionDefinition StandardOptions[]
@@ -78,6 +80,7 @@ static constexpr const CommandLineOptionDefinition StandardOptions[]
     { CMDLINE_TYPE_STRING,  &_openrctDataPath, NAC, "openrct-data-path", "path to the OpenRCT2 data directory (containing languages)" },
     { CMDLINE_TYPE_STRING,  &_rct1DataPath,    NAC, "rct1-data-path",    "path to the RollerCoaster Tycoon 1 data directory (containing data/csg1.dat)" },
     { CMDLINE_TYPE_STRING,  &_rct2DataPath,    NAC, "rct2-data-path",    "path to the RollerCoaster Tycoon 2 data directory (containing data/g1.dat)" },
+    { CMDLINE_TYPE_STRING,  &_tracePath,       NAC, "trace-startup",     "write the duration of each start up stage to a Chrome trace file" },
 #ifdef USE_BREAKPAD
     { CMDLINE_TYPE_SWITCH,  &_silentBreakpad,  NAC, "silent-breakpad",   "make breakpad crash reporting silent"                       },
 #endif // USE_BREAKPAD
@@ -141,6 +144,7 @@ const CommandLineCommand CommandLine::RootCommands[]
     DefineSubCommand("benchgfx",        CommandLine::BenchGfxCommands         ),
     DefineSubCommand("benchspritesort", CommandLine::BenchSpriteSortCommands  ),
     DefineSubCommand("simulate",        CommandLine::SimulateCommands         ),
+    DefineSubCommand("benchaudio",      CommandLine::BenchAudioCommands       ),
     CommandTableEnd
 };
 
@@ -230,6 +234,15 @@ exitcode_t CommandLine::HandleCommandDefault()
         Memory::Free(_password);
     }
 
+    if (_tracePath != nullptr)
+    {
+        utf8 absolutePath[MAX_PATH]{};
+        Path::GetAbsolute(absolutePath, std::size(absolutePath), _tracePath);
+        String::Set(gStartupTracePath, std::size(gStartupTracePath), absolutePath);
+        Memory::Free(_tracePath);
+        Trace::Enable();
+    }
+
     return result;
 }
 
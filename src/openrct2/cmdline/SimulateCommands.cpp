@@ -13,16 +13,20 @@
 #include "../OpenRCT2.h"
 #include "../core/Console.hpp"
 #include "../network/network.h"
+#include "../peep/Peep.h"
 #include "../platform/platform.h"
 #include "../world/Sprite.h"
 #include "CommandLine.hpp"
 
+#include <algorithm>
 #include <cstdlib>
 #include <memory>
+#include <vector>
 
 using namespace OpenRCT2;
 
 static exitcode_t HandleSimulate(CommandLineArgEnumerator* argEnumerator);
+static void PrintPeepUpdateStats(const std::vector<PeepUpdateStats>& tickStats);
 
 const CommandLineCommand CommandLine::SimulateCommands[]{ // Main commands
                                                           DefineCommand("", "<ticks>", nullptr, HandleSimulate), CommandTableEnd
@@ -59,11 +63,15 @@ static exitcode_t HandleSimulate(CommandLineArgEnumerator* argEnumerator)
         }
 
         Console::WriteLine("Running %d ticks...", ticks);
+        std::vector<PeepUpdateStats> tickStats;
+        tickStats.reserve(ticks);
         for (uint32_t i = 0; i < ticks; i++)
         {
             context->GetGameState()->UpdateLogic();
+            tickStats.push_back(peep_update_all_get_stats());
         }
         Console::WriteLine("Completed: %s", sprite_checksum().ToString().c_str());
+        PrintPeepUpdateStats(tickStats);
     }
     else
     {
@@ -73,3 +81,33 @@ static exitcode_t HandleSimulate(CommandLineArgEnumerator* argEnumerator)
 
     return EXITCODE_OK;
 }
+
+static void PrintPeepUpdateStats(const std::vector<PeepUpdateStats>& tickStats)
+{
+    if (tickStats.empty())
+        return;
+
+    std::vector<double> durations;
+    uint32_t totalRideChoices = 0;
+    uint32_t maxRideChoices = 0;
+    uint32_t totalDeferredRideChoices = 0;
+    uint32_t totalPrecomputedSearches = 0;
+    for (const auto& stats : tickStats)
+    {
+        durations.push_back(stats.Milliseconds);
+        totalRideChoices += stats.RideChoices.Made;
+        maxRideChoices = std::max(maxRideChoices, stats.RideChoices.Made);
+        totalDeferredRideChoices += stats.RideChoices.Deferred;
+        totalPrecomputedSearches += stats.PrecomputedPathfindSearches;
+    }
+    std::sort(durations.begin(), durations.end());
+
+    auto percentile = [&durations](size_t percent) { return durations[(durations.size() - 1) * percent / 100]; };
+    Console::WriteLine(
+        "Peep update time per tick (ms): min %.3f, median %.3f, 95th percentile %.3f, 99th percentile %.3f, max %.3f",
+        durations.front(), percentile(50), percentile(95), percentile(99), durations.back());
+    Console::WriteLine(
+        "Guest ride choices: %u (at most %u per tick), %u deferred to a later tick", totalRideChoices, maxRideChoices,
+        totalDeferredRideChoices);
+    Console::WriteLine("Guest pathfinding searches run ahead of the guest updates: %u", totalPrecomputedSearches);
+}
@@ -32,6 +32,7 @@
 #include "IniReader.hpp"
 #include "IniWriter.hpp"
 
+#include <algorithm>
 #include <memory>
 
 using namespace OpenRCT2;
@@ -208,6 +209,8 @@ namespace Config
             model->show_guest_purchases = reader->GetBoolean("show_guest_purchases", false);
             model->show_real_names_of_guests = reader->GetBoolean("show_real_names_of_guests", true);
             model->allow_early_completion = reader->GetBoolean("allow_early_completion", false);
+            model->footpath_graph_pathfinding = reader->GetBoolean("footpath_graph_pathfinding", false);
+            model->guest_ride_choices_per_tick = reader->GetInt32("guest_ride_choices_per_tick", 0);
             model->transparent_screenshot = reader->GetBoolean("transparent_screenshot", true);
         }
     }
@@ -281,6 +284,8 @@ namespace Config
         writer->WriteBoolean("show_guest_purchases", model->show_guest_purchases);
         writer->WriteBoolean("show_real_names_of_guests", model->show_real_names_of_guests);
         writer->WriteBoolean("allow_early_completion", model->allow_early_completion);
+        writer->WriteBoolean("footpath_graph_pathfinding", model->footpath_graph_pathfinding);
+        writer->WriteInt32("guest_ride_choices_per_tick", model->guest_ride_choices_per_tick);
         writer->WriteEnum<int32_t>("virtual_floor_style", model->virtual_floor_style, Enum_VirtualFloorStyle);
         writer->WriteBoolean("transparent_screenshot", model->transparent_screenshot);
     }
@@ -337,6 +342,7 @@ namespace Config
             model->ride_music_enabled = reader->GetBoolean("ride_music", true);
             model->ride_music_volume = reader->GetInt32("ride_music_volume", 100);
             model->audio_focus = reader->GetBoolean("audio_focus", false);
+            model->stream_buffer_size = std::clamp(reader->GetInt32("stream_buffer_size", 256), 16, 16384);
         }
     }
 
@@ -353,6 +359,7 @@ namespace Config
         writer->WriteBoolean("ride_music", model->ride_music_enabled);
         writer->WriteInt32("ride_music_volume", model->ride_music_volume);
         writer->WriteBoolean("audio_focus", model->audio_focus);
+        writer->WriteInt32("stream_buffer_size", model->stream_buffer_size);
     }
 
     static void ReadNetwork(IIniReader* reader)
@@ -85,6 +85,8 @@ struct GeneralConfiguration
     bool steam_overlay_pause;
     bool show_real_names_of_guests;
     bool allow_early_completion;
+    bool footpath_graph_pathfinding;
+    int32_t guest_ride_choices_per_tick;
 
     // Loading and saving
     bool confirmation_prompt;
@@ -124,6 +126,7 @@ struct SoundConfiguration
     bool ride_music_enabled;
     uint8_t ride_music_volume;
     bool audio_focus;
+    int32_t stream_buffer_size;
 };
 
 struct TwitchConfiguration
@@ -17,10 +17,12 @@
 #include "JobPool.hpp"
 #include "Path.hpp"
 
+#include <atomic>
 #include <chrono>
-#include <list>
+#include <mutex>
 #include <string>
 #include <tuple>
+#include <unordered_map>
 #include <vector>
 
 template<typename TItem> class FileIndex
@@ -34,12 +36,19 @@ private:
         uint32_t PathChecksum = 0;
     };
 
+    struct ScannedFile
+    {
+        std::string Path;
+        uint64_t Size = 0;
+        uint64_t LastModified = 0;
+    };
+
     struct ScanResult
     {
         DirectoryStats const Stats;
-        std::vector<std::string> const Files;
+        std::vector<ScannedFile> const Files;
 
-        ScanResult(DirectoryStats stats, std::vector<std::string> files)
+        ScanResult(DirectoryStats stats, std::vector<ScannedFile> files)
             : Stats(stats)
             , Files(files)
         {
@@ -54,11 +63,37 @@ private:
         uint8_t VersionB = 0;
         uint16_t LanguageId = 0;
         DirectoryStats Stats;
-        uint32_t NumItems = 0;
+        uint32_t NumFiles = 0;
+    };
+
+    /**
+     * The size and modification time of an indexed file, followed in the index file by its serialised
+     * item if one could be created for it.
+     */
+#pragma pack(push, 1)
+    struct FileIndexEntryHeader
+    {
+        uint64_t Size = 0;
+        uint64_t LastModified = 0;
+        uint8_t HasItem = 0;
     };
+    assert_struct_size(FileIndexEntryHeader, 17);
+#pragma pack(pop)
+
+    /**
+     * A file as it was when the index was last written, along with the item that was created for it.
+     */
+    struct IndexedFile
+    {
+        uint64_t Size = 0;
+        uint64_t LastModified = 0;
+        std::tuple<bool, TItem> Item;
+    };
+
+    using IndexedFiles = std::unordered_map<std::string, IndexedFile>;
 
     // Index file format version which when incremented forces a rebuild
-    static constexpr uint8_t FILE_INDEX_VERSION = 4;
+    static constexpr uint8_t FILE_INDEX_VERSION = 5;
 
     std::string const _name;
     uint32_t const _magicNumber;
@@ -94,31 +129,30 @@ public:
     virtual ~FileIndex() = default;
 
     /**
-     * Queries and directories and loads the index header. If the index is up to date,
-     * the items are loaded from the index and returned, otherwise the index is rebuilt.
+     * Queries and directories and loads the index. If the index is up to date, the items are loaded
+     * from the index and returned, otherwise only the files that have been added or modified since
+     * the index was written are indexed again and files that no longer exist are dropped.
      */
     std::vector<TItem> LoadOrBuild(int32_t language) const
     {
-        std::vector<TItem> items;
         auto scanResult = Scan();
-        auto readIndexResult = ReadIndexFile(language, scanResult.Stats);
-        if (std::get<0>(readIndexResult))
+        IndexedFiles indexedFiles;
+        if (ReadIndexFile(language, scanResult.Stats, indexedFiles))
         {
-            // Index was loaded
-            items = std::get<1>(readIndexResult);
+            // Index was loaded and is up to date
+            return GetItems(scanResult, indexedFiles);
         }
         else
         {
-            // Index was not loaded
-            items = Build(language, scanResult);
+            // Index was not loaded or is out of date, index what has changed
+            return Build(language, scanResult, indexedFiles);
         }
-        return items;
     }
 
     std::vector<TItem> Rebuild(int32_t language) const
     {
         auto scanResult = Scan();
-        auto items = Build(language, scanResult);
+        auto items = Build(language, scanResult, {});
         return items;
     }
 
@@ -143,7 +177,7 @@ private:
     ScanResult Scan() const
     {
         DirectoryStats stats{};
-        std::vector<std::string> files;
+        std::vector<ScannedFile> files;
         for (const auto& directory : SearchPaths)
         {
             auto absoluteDirectory = Path::GetAbsolute(directory);
@@ -156,7 +190,7 @@ private:
                 auto fileInfo = scanner->GetFileInfo();
                 auto path = std::string(scanner->GetPath());
 
-                files.push_back(path);
+                files.push_back({ path, fileInfo->Size, fileInfo->LastModified });
 
                 stats.TotalFiles++;
                 stats.TotalFileSize += fileInfo->Size;
@@ -171,13 +205,12 @@ private:
     }
 
     void BuildRange(
-        int32_t language, const ScanResult& scanResult, size_t rangeStart, size_t rangeEnd, std::vector<TItem>& items,
-        std::atomic<size_t>& processed, std::mutex& printLock) const
+        int32_t language, const std::vector<const ScannedFile*>& files, size_t rangeStart, size_t rangeEnd,
+        std::vector<std::tuple<bool, TItem>>& items, std::atomic<size_t>& processed, std::mutex& printLock) const
     {
-        items.reserve(rangeEnd - rangeStart);
         for (size_t i = rangeStart; i < rangeEnd; i++)
         {
-            const auto& filePath = scanResult.Files.at(i);
+            const auto& filePath = files.at(i)->Path;
 
             if (_log_levels[DIAGNOSTIC_LEVEL_VERBOSE])
             {
@@ -185,31 +218,46 @@ private:
                 log_verbose("FileIndex:Indexing '%s'", filePath.c_str());
             }
 
-            auto item = Create(language, filePath);
-            if (std::get<0>(item))
-            {
-                items.push_back(std::get<1>(item));
-            }
+            items[i] = Create(language, filePath);
 
             processed++;
         }
     }
 
-    std::vector<TItem> Build(int32_t language, const ScanResult& scanResult) const
+    /**
+     * Creates the items for every scanned file that is not in the given set of indexed files or has
+     * changed since, then writes the new index.
+     */
+    std::vector<TItem> Build(int32_t language, const ScanResult& scanResult, IndexedFiles indexedFiles) const
     {
-        std::vector<TItem> allItems;
-        Console::WriteLine("Building %s (%zu items)", _name.c_str(), scanResult.Files.size());
+        std::vector<const ScannedFile*> changedFiles;
+        for (const auto& file : scanResult.Files)
+        {
+            auto it = indexedFiles.find(file.Path);
+            if (it == indexedFiles.end() || it->second.Size != file.Size || it->second.LastModified != file.LastModified)
+            {
+                changedFiles.push_back(&file);
+            }
+        }
+
+        if (indexedFiles.empty())
+        {
+            Console::WriteLine("Building %s (%zu items)", _name.c_str(), changedFiles.size());
+        }
+        else
+        {
+            Console::WriteLine("Updating %s (%zu of %zu items)", _name.c_str(), changedFiles.size(), scanResult.Files.size());
+        }
 
         auto startTime = std::chrono::high_resolution_clock::now();
 
-        const size_t totalCount = scanResult.Files.size();
+        const size_t totalCount = changedFiles.size();
+        std::vector<std::tuple<bool, TItem>> changedItems(totalCount);
         if (totalCount > 0)
         {
             JobPool jobPool;
             std::mutex printLock; // For verbose prints.
 
-            std::list<std::vector<TItem>> containers;
-
             size_t stepSize = 100; // Handpicked, seems to work well with 4/8 cores.
 
             std::atomic<size_t> processed = ATOMIC_VAR_INIT(0);
@@ -226,24 +274,24 @@ private:
                     stepSize = totalCount - rangeStart;
                 }
 
-                auto& items = containers.emplace_back();
-
                 jobPool.AddTask(std::bind(
-                    &FileIndex<TItem>::BuildRange, this, language, std::cref(scanResult), rangeStart, rangeStart + stepSize,
-                    std::ref(items), std::ref(processed), std::ref(printLock)));
+                    &FileIndex<TItem>::BuildRange, this, language, std::cref(changedFiles), rangeStart,
+                    rangeStart + stepSize, std::ref(changedItems), std::ref(processed), std::ref(printLock)));
 
                 reportProgress();
             }
 
             jobPool.Join(reportProgress);
+        }
 
-            for (auto&& itr : containers)
-            {
-                allItems.insert(allItems.end(), itr.begin(), itr.end());
-            }
+        for (size_t i = 0; i < totalCount; i++)
+        {
+            const auto& file = *changedFiles[i];
+            indexedFiles[file.Path] = { file.Size, file.LastModified, std::move(changedItems[i]) };
         }
 
-        WriteIndexFile(language, scanResult.Stats, allItems);
+        auto allItems = GetItems(scanResult, indexedFiles);
+        WriteIndexFile(language, scanResult, indexedFiles);
 
         auto endTime = std::chrono::high_resolution_clock::now();
         auto duration = (std::chrono::duration<float>)(endTime - startTime);
@@ -252,10 +300,31 @@ private:
         return allItems;
     }
 
-    std::tuple<bool, std::vector<TItem>> ReadIndexFile(int32_t language, const DirectoryStats& stats) const
+    /**
+     * Gets the items of the scanned files, in scan order.
+     */
+    static std::vector<TItem> GetItems(const ScanResult& scanResult, const IndexedFiles& indexedFiles)
     {
-        bool loadedItems = false;
         std::vector<TItem> items;
+        items.reserve(scanResult.Files.size());
+        for (const auto& file : scanResult.Files)
+        {
+            auto it = indexedFiles.find(file.Path);
+            if (it != indexedFiles.end() && std::get<0>(it->second.Item))
+            {
+                items.push_back(std::get<1>(it->second.Item));
+            }
+        }
+        return items;
+    }
+
+    /**
+     * Reads the files recorded in the index file. Returns true if the index is up to date with the
+     * given directory stats, otherwise the files that could be read are returned for an incremental build.
+     */
+    bool ReadIndexFile(int32_t language, const DirectoryStats& stats, IndexedFiles& indexedFiles) const
+    {
+        bool upToDate = false;
         if (File::Exists(_indexPath))
         {
             try
@@ -263,22 +332,34 @@ private:
                 log_verbose("FileIndex:Loading index: '%s'", _indexPath.c_str());
                 auto fs = FileStream(_indexPath, FILE_MODE_OPEN);
 
-                // Read header, check if we need to re-scan
+                // Read header, the files can only be reused if the items were created the same way
                 auto header = fs.ReadValue<FileIndexHeader>();
                 if (header.HeaderSize == sizeof(FileIndexHeader) && header.MagicNumber == _magicNumber
-                    && header.VersionA == FILE_INDEX_VERSION && header.VersionB == _version && header.LanguageId == language
-                    && header.Stats.TotalFiles == stats.TotalFiles && header.Stats.TotalFileSize == stats.TotalFileSize
-                    && header.Stats.FileDateModifiedChecksum == stats.FileDateModifiedChecksum
-                    && header.Stats.PathChecksum == stats.PathChecksum)
+                    && header.VersionA == FILE_INDEX_VERSION && header.VersionB == _version && header.LanguageId == language)
                 {
-                    items.reserve(header.NumItems);
-                    // Directory is the same, just read the saved items
-                    for (uint32_t i = 0; i < header.NumItems; i++)
+                    indexedFiles.reserve(header.NumFiles);
+                    for (uint32_t i = 0; i < header.NumFiles; i++)
                     {
-                        auto item = Deserialise(&fs);
-                        items.push_back(item);
+                        auto path = fs.ReadStdString();
+                        auto entryHeader = fs.ReadValue<FileIndexEntryHeader>();
+
+                        IndexedFile indexedFile;
+                        indexedFile.Size = entryHeader.Size;
+                        indexedFile.LastModified = entryHeader.LastModified;
+                        if (entryHeader.HasItem)
+                        {
+                            indexedFile.Item = std::make_tuple(true, Deserialise(&fs));
+                        }
+                        indexedFiles.emplace(std::move(path), std::move(indexedFile));
+                    }
+
+                    upToDate = header.Stats.TotalFiles == stats.TotalFiles && header.Stats.TotalFileSize == stats.TotalFileSize
+                        && header.Stats.FileDateModifiedChecksum == stats.FileDateModifiedChecksum
+                        && header.Stats.PathChecksum == stats.PathChecksum;
+                    if (!upToDate)
+                    {
+                        Console::WriteLine("%s out of date", _name.c_str());
                     }
-                    loadedItems = true;
                 }
                 else
                 {
@@ -289,12 +370,14 @@ private:
             {
                 Console::Error::WriteLine("Unable to load index: '%s'.", _indexPath.c_str());
                 Console::Error::WriteLine("%s", e.what());
+                indexedFiles.clear();
+                upToDate = false;
             }
         }
-        return std::make_tuple(loadedItems, items);
+        return upToDate;
     }
 
-    void WriteIndexFile(int32_t language, const DirectoryStats& stats, const std::vector<TItem>& items) const
+    void WriteIndexFile(int32_t language, const ScanResult& scanResult, const IndexedFiles& indexedFiles) const
     {
         try
         {
@@ -308,14 +391,26 @@ private:
             header.VersionA = FILE_INDEX_VERSION;
             header.VersionB = _version;
             header.LanguageId = language;
-            header.Stats = stats;
-            header.NumItems = (uint32_t)items.size();
+            header.Stats = scanResult.Stats;
+            header.NumFiles = (uint32_t)scanResult.Files.size();
             fs.WriteValue(header);
 
-            // Write items
-            for (const auto& item : items)
+            // Write files, only those that currently exist so deleted files are dropped from the index
+            for (const auto& file : scanResult.Files)
             {
-                Serialise(&fs, item);
+                const auto& indexedFile = indexedFiles.at(file.Path);
+
+                FileIndexEntryHeader entryHeader;
+                entryHeader.Size = indexedFile.Size;
+                entryHeader.LastModified = indexedFile.LastModified;
+                entryHeader.HasItem = std::get<0>(indexedFile.Item) ? 1 : 0;
+
+                fs.WriteString(file.Path);
+                fs.WriteValue(entryHeader);
+                if (entryHeader.HasItem)
+                {
+                    Serialise(&fs, std::get<1>(indexedFile.Item));
+                }
             }
         }
         catch (const std::exception& e)
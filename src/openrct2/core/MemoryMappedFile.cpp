@@ -0,0 +1,139 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2019 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#ifdef _WIN32
+#    define WIN32_LEAN_AND_MEAN
+#    include <windows.h>
+#else
+#    include <fcntl.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <unistd.h>
+#endif
+
+#include "IStream.hpp"
+#include "MemoryMappedFile.h"
+#include "String.hpp"
+
+MemoryMappedFile::MemoryMappedFile(const std::string& path)
+{
+#ifdef _WIN32
+    auto pathW = String::ToWideChar(path);
+    auto hFile = CreateFileW(pathW.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, 0, nullptr);
+    if (hFile == INVALID_HANDLE_VALUE)
+    {
+        throw IOException(String::StdFormat("Unable to open '%s'", path.c_str()));
+    }
+    _fileHandle = hFile;
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(hFile, &fileSize) || fileSize.QuadPart == 0)
+    {
+        Close();
+        throw IOException(String::StdFormat("Unable to map '%s'", path.c_str()));
+    }
+    _length = (size_t)fileSize.QuadPart;
+
+    _mappingHandle = CreateFileMappingW(hFile, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+    if (_mappingHandle != nullptr)
+    {
+        _data = MapViewOfFile(_mappingHandle, FILE_MAP_COPY, 0, 0, 0);
+    }
+    if (_data == nullptr)
+    {
+        Close();
+        throw IOException(String::StdFormat("Unable to map '%s'", path.c_str()));
+    }
+#else
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd == -1)
+    {
+        throw IOException(String::StdFormat("Unable to open '%s'", path.c_str()));
+    }
+
+    struct stat fileStat;
+    if (fstat(fd, &fileStat) != 0 || !S_ISREG(fileStat.st_mode) || fileStat.st_size == 0)
+    {
+        close(fd);
+        throw IOException(String::StdFormat("Unable to map '%s'", path.c_str()));
+    }
+    _length = (size_t)fileStat.st_size;
+
+    // The descriptor can be closed straight away, the mapping keeps its own reference to the file.
+    auto data = mmap(nullptr, _length, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED)
+    {
+        throw IOException(String::StdFormat("Unable to map '%s'", path.c_str()));
+    }
+    _data = data;
+#endif
+}
+
+MemoryMappedFile::~MemoryMappedFile()
+{
+    Close();
+}
+
+void MemoryMappedFile::Close()
+{
+#ifdef _WIN32
+    if (_data != nullptr)
+    {
+        UnmapViewOfFile(_data);
+    }
+    if (_mappingHandle != nullptr)
+    {
+        CloseHandle(_mappingHandle);
+    }
+    if (_fileHandle != nullptr)
+    {
+        CloseHandle(_fileHandle);
+    }
+    _mappingHandle = nullptr;
+    _fileHandle = nullptr;
+#else
+    if (_data != nullptr)
+    {
+        munmap(_data, _length);
+    }
+#endif
+    _data = nullptr;
+    _length = 0;
+}
+
+void MemoryMappedFile::Prefetch(const void* address, size_t length)
+{
+    if (address == nullptr || length == 0)
+    {
+        return;
+    }
+
+#ifdef _WIN32
+    // PrefetchVirtualMemory is only available from Windows 8, before that the pages are read in on first access instead
+    struct MemoryRangeEntry
+    {
+        PVOID VirtualAddress;
+        SIZE_T NumberOfBytes;
+    };
+    using PrefetchVirtualMemoryPtr = BOOL(WINAPI*)(HANDLE, ULONG_PTR, MemoryRangeEntry*, ULONG);
+    static const auto prefetchVirtualMemory = (PrefetchVirtualMemoryPtr)GetProcAddress(
+        GetModuleHandleA("kernel32.dll"), "PrefetchVirtualMemory");
+    if (prefetchVirtualMemory != nullptr)
+    {
+        MemoryRangeEntry range = { (PVOID)address, length };
+        prefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+    }
+#else
+    static const auto pageSize = (uintptr_t)sysconf(_SC_PAGESIZE);
+    auto begin = (uintptr_t)address & ~(pageSize - 1);
+    auto end = (uintptr_t)address + length;
+    madvise((void*)begin, end - begin, MADV_WILLNEED);
+#endif
+}
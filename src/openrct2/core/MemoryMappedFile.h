@@ -0,0 +1,58 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2019 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "../common.h"
+
+#include <string>
+
+/**
+ * A read-only view of a whole file mapped into the address space of the process.
+ * Pages are only brought into memory when they are accessed. The mapping is
+ * private (copy-on-write), so writes to the view are never written back to disk.
+ */
+class MemoryMappedFile final
+{
+private:
+    void* _data = nullptr;
+    size_t _length = 0;
+#ifdef _WIN32
+    void* _fileHandle = nullptr;
+    void* _mappingHandle = nullptr;
+#endif
+
+public:
+    explicit MemoryMappedFile(const std::string& path);
+    MemoryMappedFile(const MemoryMappedFile&) = delete;
+    MemoryMappedFile& operator=(const MemoryMappedFile&) = delete;
+    ~MemoryMappedFile();
+
+    const uint8_t* GetData() const
+    {
+        return static_cast<const uint8_t*>(_data);
+    }
+    uint8_t* GetData()
+    {
+        return static_cast<uint8_t*>(_data);
+    }
+    size_t GetLength() const
+    {
+        return _length;
+    }
+
+    /**
+     * Advises the OS that the given range of mapped memory will be accessed soon, so it can start
+     * reading it in the background. This is only a hint, the range does not need to be page aligned.
+     */
+    static void Prefetch(const void* address, size_t length);
+
+private:
+    void Close();
+};
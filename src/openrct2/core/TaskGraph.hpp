@@ -0,0 +1,104 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2019 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "Trace.h"
+
+#include <exception>
+#include <functional>
+#include <future>
+#include <string>
+#include <vector>
+
+/**
+ * Runs named tasks concurrently, each one starting as soon as the tasks it depends on have finished.
+ * A task can only depend on tasks added before it, so the graph can never contain a cycle.
+ */
+class TaskGraph final
+{
+public:
+    using TaskId = size_t;
+
+private:
+    std::vector<std::shared_future<void>> _tasks;
+
+public:
+    TaskGraph() = default;
+    TaskGraph(const TaskGraph&) = delete;
+    TaskGraph& operator=(const TaskGraph&) = delete;
+
+    ~TaskGraph()
+    {
+        // Never leave a task running with references to the caller's state
+        for (auto& task : _tasks)
+        {
+            task.wait();
+        }
+    }
+
+    /**
+     * Starts the given work on a new thread once all of the given dependencies have finished.
+     * If a dependency throws an exception, the task does not run and rethrows it instead.
+     */
+    TaskId Add(std::string name, std::function<void()> work, std::vector<TaskId> dependencies = {})
+    {
+        std::vector<std::shared_future<void>> dependencyTasks;
+        for (auto dependency : dependencies)
+        {
+            dependencyTasks.push_back(_tasks.at(dependency));
+        }
+
+        auto id = _tasks.size();
+        _tasks.push_back(std::async(std::launch::async, [name, work, dependencyTasks]() {
+                             for (const auto& dependencyTask : dependencyTasks)
+                             {
+                                 dependencyTask.get();
+                             }
+
+                             Trace::Scope traceScope(name.c_str());
+                             work();
+                         }).share());
+        return id;
+    }
+
+    /**
+     * Waits for the given task to finish, rethrowing any exception it threw.
+     */
+    void Wait(TaskId id) const
+    {
+        _tasks.at(id).get();
+    }
+
+    /**
+     * Waits for every task to finish, then rethrows the first exception thrown by any of them.
+     */
+    void WaitAll() const
+    {
+        std::exception_ptr firstException;
+        for (const auto& task : _tasks)
+        {
+            try
+            {
+                task.get();
+            }
+            catch (...)
+            {
+                if (firstException == nullptr)
+                {
+                    firstException = std::current_exception();
+                }
+            }
+        }
+        if (firstException != nullptr)
+        {
+            std::rethrow_exception(firstException);
+        }
+    }
+};
@@ -0,0 +1,92 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2019 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "Trace.h"
+
+#include "Json.hpp"
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+namespace Trace
+{
+    static std::atomic<bool> _enabled = ATOMIC_VAR_INIT(false);
+    static std::chrono::steady_clock::time_point _epoch;
+    static std::mutex _eventsMutex;
+    static std::vector<Event> _events;
+    static std::unordered_map<std::thread::id, uint32_t> _threadIds;
+
+    Scope::Scope(const char* name)
+        : _name(name)
+        , _enabled(IsEnabled())
+    {
+        if (_enabled)
+        {
+            _start = std::chrono::steady_clock::now();
+        }
+    }
+
+    Scope::~Scope()
+    {
+        if (_enabled)
+        {
+            auto end = std::chrono::steady_clock::now();
+
+            std::lock_guard<std::mutex> lock(_eventsMutex);
+            auto threadId = _threadIds.emplace(std::this_thread::get_id(), (uint32_t)_threadIds.size()).first->second;
+            _events.push_back({ _name, threadId, std::chrono::duration_cast<std::chrono::microseconds>(_start - _epoch),
+                                std::chrono::duration_cast<std::chrono::microseconds>(end - _start) });
+        }
+    }
+
+    void Enable()
+    {
+        if (!_enabled)
+        {
+            _epoch = std::chrono::steady_clock::now();
+            _enabled = true;
+        }
+    }
+
+    bool IsEnabled()
+    {
+        return _enabled;
+    }
+
+    std::vector<Event> GetEvents()
+    {
+        std::lock_guard<std::mutex> lock(_eventsMutex);
+        return _events;
+    }
+
+    void WriteChromeTrace(const std::string& path)
+    {
+        json_t* traceEvents = json_array();
+        for (const auto& e : GetEvents())
+        {
+            json_t* traceEvent = json_object();
+            json_object_set_new(traceEvent, "name", json_string(e.Name.c_str()));
+            json_object_set_new(traceEvent, "cat", json_string("openrct2"));
+            json_object_set_new(traceEvent, "ph", json_string("X"));
+            json_object_set_new(traceEvent, "ts", json_integer(e.Start.count()));
+            json_object_set_new(traceEvent, "dur", json_integer(e.Duration.count()));
+            json_object_set_new(traceEvent, "pid", json_integer(1));
+            json_object_set_new(traceEvent, "tid", json_integer(e.ThreadId));
+            json_array_append_new(traceEvents, traceEvent);
+        }
+
+        json_t* root = json_object();
+        json_object_set_new(root, "traceEvents", traceEvents);
+        json_object_set_new(root, "displayTimeUnit", json_string("ms"));
+        Json::WriteToFile(path.c_str(), root, JSON_INDENT(2));
+        json_decref(root);
+    }
+} // namespace Trace
@@ -0,0 +1,58 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2019 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "../common.h"
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+/**
+ * Records how long named stages take, e.g. the stages of start up. Recording is disabled until
+ * Trace::Enable is called so scopes cost next to nothing otherwise.
+ */
+namespace Trace
+{
+    struct Event
+    {
+        std::string Name;
+        uint32_t ThreadId;
+        std::chrono::microseconds Start;
+        std::chrono::microseconds Duration;
+    };
+
+    /**
+     * Records the time between construction and destruction as an event.
+     */
+    class Scope final
+    {
+    private:
+        const char* _name;
+        bool _enabled;
+        std::chrono::steady_clock::time_point _start;
+
+    public:
+        explicit Scope(const char* name);
+        ~Scope();
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    };
+
+    void Enable();
+    bool IsEnabled();
+    std::vector<Event> GetEvents();
+
+    /**
+     * Writes the recorded events to a file in the Chrome trace event format, which can be opened
+     * in chrome://tracing or https://ui.perfetto.dev.
+     */
+    void WriteChromeTrace(const std::string& path);
+} // namespace Trace
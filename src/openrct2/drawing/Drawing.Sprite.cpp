@@ -11,7 +11,8 @@
 #include "../OpenRCT2.h"
 #include "../PlatformEnvironment.h"
 #include "../config/Config.h"
-#include "../core/FileStream.hpp"
+#include "../core/Guard.hpp"
+#include "../core/MemoryMappedFile.h"
 #include "../core/Path.hpp"
 #include "../platform/platform.h"
 #include "../sprites.h"
@@ -20,6 +21,7 @@
 #include "Drawing.h"
 
 #include <algorithm>
+#include <cstring>
 #include <memory>
 #include <stdexcept>
 #include <vector>
@@ -40,7 +42,8 @@ struct rct_gx
 {
     rct_g1_header header;
     std::vector<rct_g1_element> elements;
-    void* data;
+    // Element pixel data is referenced in place from the mapped file(s)
+    std::unique_ptr<MemoryMappedFile> file;
 };
 
 // clang-format off
@@ -83,10 +86,9 @@ static inline uint32_t rctc_to_rct2_index(uint32_t image)
 }
 // clang-format on
 
-static void read_and_convert_gxdat(IStream* stream, size_t count, bool is_rctc, rct_g1_element* elements)
+static void read_and_convert_gxdat(
+    const rct_g1_element_32bit* g1Elements32, size_t count, bool is_rctc, rct_g1_element* elements)
 {
-    auto g1Elements32 = std::make_unique<rct_g1_element_32bit[]>(count);
-    stream->Read(g1Elements32.get(), count * sizeof(rct_g1_element_32bit));
     if (is_rctc)
     {
         // Process RCTC's g1.dat file
@@ -217,6 +219,35 @@ static std::string gfx_get_csg_data_path()
     return path;
 }
 
+static rct_g1_header gfx_read_gx_header(const MemoryMappedFile& file)
+{
+    if (file.GetLength() < sizeof(rct_g1_header))
+    {
+        throw std::runtime_error("Graphics file is too small");
+    }
+
+    rct_g1_header header;
+    std::memcpy(&header, file.GetData(), sizeof(rct_g1_header));
+
+    uint64_t expectedSize = sizeof(rct_g1_header) + ((uint64_t)header.num_entries * sizeof(rct_g1_element_32bit))
+        + header.total_size;
+    if (file.GetLength() < expectedSize)
+    {
+        throw std::runtime_error("Graphics file is truncated");
+    }
+    return header;
+}
+
+static const rct_g1_element_32bit* gfx_get_gx_elements(const MemoryMappedFile& file)
+{
+    return reinterpret_cast<const rct_g1_element_32bit*>(file.GetData() + sizeof(rct_g1_header));
+}
+
+static uint8_t* gfx_get_gx_data(MemoryMappedFile& file, const rct_g1_header& header)
+{
+    return file.GetData() + sizeof(rct_g1_header) + (header.num_entries * sizeof(rct_g1_element_32bit));
+}
+
 static rct_gx _g1 = {};
 static rct_gx _g2 = {};
 static rct_gx _csg = {};
@@ -236,8 +267,8 @@ bool gfx_load_g1(const IPlatformEnvironment& env)
     try
     {
         auto path = Path::Combine(env.GetDirectoryPath(DIRBASE::RCT2, DIRID::DATA), "g1.dat");
-        auto fs = FileStream(path, FILE_MODE_OPEN);
-        _g1.header = fs.ReadValue<rct_g1_header>();
+        _g1.file = std::make_unique<MemoryMappedFile>(path);
+        _g1.header = gfx_read_gx_header(*_g1.file);
 
         log_verbose("g1.dat, number of entries: %u", _g1.header.num_entries);
 
@@ -246,24 +277,23 @@ bool gfx_load_g1(const IPlatformEnvironment& env)
             throw std::runtime_error("Not enough elements in g1.dat");
         }
 
-        // Read element headers
+        // Convert element headers
         bool is_rctc = _g1.header.num_entries == SPR_RCTC_G1_END;
         _g1.elements.resize(_g1.header.num_entries);
-        read_and_convert_gxdat(&fs, _g1.header.num_entries, is_rctc, _g1.elements.data());
+        read_and_convert_gxdat(gfx_get_gx_elements(*_g1.file), _g1.header.num_entries, is_rctc, _g1.elements.data());
         gTinyFontAntiAliased = is_rctc;
 
-        // Read element data
-        _g1.data = fs.ReadArray<uint8_t>(_g1.header.total_size);
-
         // Fix entry data offsets
+        uint8_t* data = gfx_get_gx_data(*_g1.file, _g1.header);
         for (uint32_t i = 0; i < _g1.header.num_entries; i++)
         {
-            _g1.elements[i].offset += (uintptr_t)_g1.data;
+            _g1.elements[i].offset += (uintptr_t)data;
         }
         return true;
     }
     catch (const std::exception&)
     {
+        _g1.file = nullptr;
         _g1.elements.clear();
         _g1.elements.shrink_to_fit();
 
@@ -279,21 +309,21 @@ bool gfx_load_g1(const IPlatformEnvironment& env)
 
 void gfx_unload_g1()
 {
-    SafeFree(_g1.data);
+    _g1.file = nullptr;
     _g1.elements.clear();
     _g1.elements.shrink_to_fit();
 }
 
 void gfx_unload_g2()
 {
-    SafeFree(_g2.data);
+    _g2.file = nullptr;
     _g2.elements.clear();
     _g2.elements.shrink_to_fit();
 }
 
 void gfx_unload_csg()
 {
-    SafeFree(_csg.data);
+    _csg.file = nullptr;
     _csg.elements.clear();
     _csg.elements.shrink_to_fit();
 }
@@ -308,25 +338,24 @@ bool gfx_load_g2()
     safe_strcat_path(path, "g2.dat", MAX_PATH);
     try
     {
-        auto fs = FileStream(path, FILE_MODE_OPEN);
-        _g2.header = fs.ReadValue<rct_g1_header>();
+        _g2.file = std::make_unique<MemoryMappedFile>(path);
+        _g2.header = gfx_read_gx_header(*_g2.file);
 
-        // Read element headers
+        // Convert element headers
         _g2.elements.resize(_g2.header.num_entries);
-        read_and_convert_gxdat(&fs, _g2.header.num_entries, false, _g2.elements.data());
-
-        // Read element data
-        _g2.data = fs.ReadArray<uint8_t>(_g2.header.total_size);
+        read_and_convert_gxdat(gfx_get_gx_elements(*_g2.file), _g2.header.num_entries, false, _g2.elements.data());
 
         // Fix entry data offsets
+        uint8_t* data = gfx_get_gx_data(*_g2.file, _g2.header);
         for (uint32_t i = 0; i < _g2.header.num_entries; i++)
         {
-            _g2.elements[i].offset += (uintptr_t)_g2.data;
+            _g2.elements[i].offset += (uintptr_t)data;
         }
         return true;
     }
     catch (const std::exception&)
     {
+        _g2.file = nullptr;
         _g2.elements.clear();
         _g2.elements.shrink_to_fit();
 
@@ -354,10 +383,11 @@ bool gfx_load_csg()
     auto pathDataPath = gfx_get_csg_data_path();
     try
     {
-        auto fileHeader = FileStream(pathHeaderPath, FILE_MODE_OPEN);
-        auto fileData = FileStream(pathDataPath, FILE_MODE_OPEN);
+        // Only the element data needs to stay mapped, the headers are converted straight away
+        auto fileHeader = MemoryMappedFile(pathHeaderPath);
+        _csg.file = std::make_unique<MemoryMappedFile>(pathDataPath);
         size_t fileHeaderSize = fileHeader.GetLength();
-        size_t fileDataSize = fileData.GetLength();
+        size_t fileDataSize = _csg.file->GetLength();
 
         _csg.header.num_entries = (uint32_t)(fileHeaderSize / sizeof(rct_g1_element_32bit));
         _csg.header.total_size = (uint32_t)fileDataSize;
@@ -365,20 +395,21 @@ bool gfx_load_csg()
         if (_csg.header.num_entries < 69917)
         {
             log_warning("Cannot load CSG1.DAT, it has too few entries. Only CSG1.DAT from Loopy Landscapes will work.");
+            _csg.file = nullptr;
             return false;
         }
 
-        // Read element headers
+        // Convert element headers
         _csg.elements.resize(_csg.header.num_entries);
-        read_and_convert_gxdat(&fileHeader, _csg.header.num_entries, false, _csg.elements.data());
-
-        // Read element data
-        _csg.data = fileData.ReadArray<uint8_t>(_csg.header.total_size);
+        read_and_convert_gxdat(
+            reinterpret_cast<const rct_g1_element_32bit*>(fileHeader.GetData()), _csg.header.num_entries, false,
+            _csg.elements.data());
 
         // Fix entry data offsets
+        uint8_t* data = _csg.file->GetData();
         for (uint32_t i = 0; i < _csg.header.num_entries; i++)
         {
-            _csg.elements[i].offset += (uintptr_t)_csg.data;
+            _csg.elements[i].offset += (uintptr_t)data;
             // RCT1 used zoomed offsets that counted from the beginning of the file, rather than from the current sprite.
             if (_csg.elements[i].flags & G1_FLAG_HAS_ZOOM_SPRITE)
             {
@@ -390,6 +421,7 @@ bool gfx_load_csg()
     }
     catch (const std::exception&)
     {
+        _csg.file = nullptr;
         _csg.elements.clear();
         _csg.elements.shrink_to_fit();
 
@@ -17,8 +17,11 @@
 #include "../sprites.h"
 #include "../util/Util.h"
 #include "TTF.h"
+#include "TextLayoutCache.h"
 
 #include <algorithm>
+#include <cstring>
+#include <string>
 
 enum : uint32_t
 {
@@ -71,32 +74,21 @@ int32_t gfx_get_string_width_new_lined(utf8* text)
  */
 int32_t gfx_get_string_width(const utf8* buffer)
 {
-    return ttf_get_string_width(buffer);
+    TextLayout layout;
+    if (!text_layout_cache_get(TextLayoutKind::Width, buffer, 0, &layout))
+    {
+        layout.Width = ttf_get_string_width(buffer);
+        text_layout_cache_add(TextLayoutKind::Width, buffer, 0, layout);
+    }
+    return layout.Width;
 }
 
 /**
- * Clip the text in buffer to width, add ellipsis and return the new width of the clipped string
- *
- *  rct2: 0x006C2460
- * buffer (esi)
- * width (edi)
+ * Clips the text that is wider than width, measuring the string without the layout cache as every clipped prefix is
+ * measured on the way.
  */
-int32_t gfx_clip_string(utf8* text, int32_t width)
+static int32_t gfx_clip_string_uncached(utf8* text, int32_t width, int32_t clippedWidth)
 {
-    int32_t clippedWidth;
-
-    if (width < 6)
-    {
-        *text = 0;
-        return 0;
-    }
-
-    clippedWidth = gfx_get_string_width(text);
-    if (clippedWidth <= width)
-    {
-        return clippedWidth;
-    }
-
     utf8 backup[4];
     utf8* ch = text;
     utf8* nextCh = text;
@@ -121,7 +113,7 @@ int32_t gfx_clip_string(utf8* text, int32_t width)
         }
         nextCh[3] = 0;
 
-        int32_t queryWidth = gfx_get_string_width(text);
+        int32_t queryWidth = ttf_get_string_width(text);
         if (queryWidth < width)
         {
             clipCh = nextCh;
@@ -143,23 +135,50 @@ int32_t gfx_clip_string(utf8* text, int32_t width)
         };
         ch = nextCh;
     }
-    return gfx_get_string_width(text);
+    return ttf_get_string_width(text);
 }
 
 /**
- * Wrap the text in buffer to width, returns width of longest line.
- *
- * Inserts NULL where line should break (as \n is used for something else),
- * so the number of lines is returned in num_lines. font_height seems to be
- * a control character for line height.
+ * Clip the text in buffer to width, add ellipsis and return the new width of the clipped string
  *
- *  rct2: 0x006C21E2
+ *  rct2: 0x006C2460
  * buffer (esi)
- * width (edi) - in
- * num_lines (edi) - out
- * font_height (ebx) - out
+ * width (edi)
  */
-int32_t gfx_wrap_string(utf8* text, int32_t width, int32_t* outNumLines, int32_t* outFontHeight)
+int32_t gfx_clip_string(utf8* text, int32_t width)
+{
+    if (width < 6)
+    {
+        *text = 0;
+        return 0;
+    }
+
+    int32_t clippedWidth = gfx_get_string_width(text);
+    if (clippedWidth <= width)
+    {
+        return clippedWidth;
+    }
+
+    TextLayout layout;
+    if (text_layout_cache_get(TextLayoutKind::Clip, text, width, &layout))
+    {
+        std::memcpy(text, layout.Text.c_str(), layout.Text.size() + 1);
+        return layout.Width;
+    }
+
+    // The layout is cached under the string as it was before clipping
+    std::string unclippedText = text;
+    layout.Width = gfx_clip_string_uncached(text, width, clippedWidth);
+    layout.Text = text;
+    text_layout_cache_add(TextLayoutKind::Clip, unclippedText.c_str(), width, layout);
+    return layout.Width;
+}
+
+/**
+ * Wraps the text to width, measuring the string without the layout cache as every line is measured a character at a
+ * time.
+ */
+static int32_t gfx_wrap_string_uncached(utf8* text, int32_t width, int32_t* outNumLines)
 {
     int32_t lineWidth = 0;
     int32_t maxWidth = 0;
@@ -204,7 +223,7 @@ int32_t gfx_wrap_string(utf8* text, int32_t width, int32_t* outNumLines, int32_t
 
         uint8_t saveCh = *nextCh;
         *nextCh = 0;
-        lineWidth = gfx_get_string_width(firstCh);
+        lineWidth = ttf_get_string_width(firstCh);
         *nextCh = saveCh;
 
         if (lineWidth <= width || numCharactersOnLine == 0)
@@ -237,10 +256,49 @@ int32_t gfx_wrap_string(utf8* text, int32_t width, int32_t* outNumLines, int32_t
         }
     }
     maxWidth = std::max(maxWidth, lineWidth);
-    *outFontHeight = gCurrentFontSpriteBase;
     return maxWidth == 0 ? lineWidth : maxWidth;
 }
 
+/**
+ * Wrap the text in buffer to width, returns width of longest line.
+ *
+ * Inserts NULL where line should break (as \n is used for something else),
+ * so the number of lines is returned in num_lines. font_height seems to be
+ * a control character for line height.
+ *
+ *  rct2: 0x006C21E2
+ * buffer (esi)
+ * width (edi) - in
+ * num_lines (edi) - out
+ * font_height (ebx) - out
+ */
+int32_t gfx_wrap_string(utf8* text, int32_t width, int32_t* outNumLines, int32_t* outFontHeight)
+{
+    TextLayout layout;
+    if (text_layout_cache_get(TextLayoutKind::Wrap, text, width, &layout))
+    {
+        std::memcpy(text, layout.Text.data(), layout.Text.size());
+    }
+    else
+    {
+        // The layout is cached under the string as it was before wrapping
+        std::string unwrappedText = text;
+        layout.Width = gfx_wrap_string_uncached(text, width, &layout.NumLines);
+
+        // Keep all the lines along with the null terminators that separate them
+        const utf8* end = text;
+        for (int32_t i = 0; i <= layout.NumLines; i++)
+        {
+            end += std::strlen(end) + 1;
+        }
+        layout.Text.assign(text, end - text);
+        text_layout_cache_add(TextLayoutKind::Wrap, unwrappedText.c_str(), width, layout);
+    }
+    *outNumLines = layout.NumLines;
+    *outFontHeight = gCurrentFontSpriteBase;
+    return layout.Width;
+}
+
 /**
  * Draws text that is left aligned and vertically centred.
  */
@@ -537,7 +595,7 @@ static void ttf_draw_string_raw_ttf(rct_drawpixelinfo* dpi, const utf8* text, te
     else
     {
         uint8_t colour = info->palette[1];
-        TTFSurface* surface = ttf_surface_cache_get_or_add(fontDesc->font, text);
+        const TTFSurface* surface = ttf_surface_compose(fontDesc->font, text);
         if (surface == nullptr)
             return;
 
@@ -13,6 +13,7 @@
 #include "../OpenRCT2.h"
 #include "../common.h"
 #include "../core/Guard.hpp"
+#include "../interface/Window.h"
 #include "../object/Object.h"
 #include "../platform/platform.h"
 #include "../sprites.h"
@@ -601,6 +602,7 @@ void load_palette()
  */
 void gfx_invalidate_screen()
 {
+    window_invalidate_all_render_caches();
     gfx_set_dirty_blocks(0, 0, context_get_width(), context_get_height());
 }
 
@@ -15,6 +15,7 @@
 #include "../sprites.h"
 #include "Drawing.h"
 #include "TTF.h"
+#include "TextLayoutCache.h"
 
 #include <iterator>
 #include <unordered_map>
@@ -252,6 +253,7 @@ void font_sprite_initialise_characters()
     }
 
     scrolling_text_initialise_bitmaps();
+    text_layout_cache_clear();
 }
 
 int32_t font_sprite_get_codepoint_offset(int32_t codepoint)
@@ -1588,7 +1588,7 @@ static void scrolling_text_set_bitmap_for_ttf(
     }
     *dstCh = 0;
 
-    TTFSurface* surface = ttf_surface_cache_get_or_add(fontDesc->font, text);
+    const TTFSurface* surface = ttf_surface_compose(fontDesc->font, text);
     if (surface == nullptr)
     {
         return;
@@ -9,8 +9,11 @@
 
 #ifndef NO_TTF
 
+#    include <algorithm>
 #    include <atomic>
 #    include <mutex>
+#    include <unordered_map>
+#    include <vector>
 #    pragma clang diagnostic push
 #    pragma clang diagnostic ignored "-Wdocumentation"
 #    include <ft2build.h>
@@ -23,18 +26,39 @@
 #    include "../localisation/LocalisationService.h"
 #    include "../platform/platform.h"
 #    include "TTF.h"
+#    include "TextLayoutCache.h"
 
 static bool _ttfInitialised = false;
 
-#    define TTF_SURFACE_CACHE_SIZE 256
+#    define TTF_GLYPH_ATLAS_SIZE (1024 * 1024)
 #    define TTF_GETWIDTH_CACHE_SIZE 1024
 
-struct ttf_cache_entry
+/**
+ * A glyph copied into the atlas of its font, its rows are stored one after the other without any padding.
+ */
+struct ttf_atlas_glyph
 {
-    TTFSurface* surface;
-    TTF_Font* font;
-    utf8* text;
-    uint32_t lastUseTick;
+    uint32_t offset;
+    uint32_t index;
+    int32_t width;
+    int32_t rows;
+    int32_t minx;
+    int32_t maxx;
+    int32_t miny;
+    int32_t yoffset;
+    int32_t advance;
+};
+
+struct ttf_glyph_atlas
+{
+    std::unordered_map<uint16_t, ttf_atlas_glyph> glyphs;
+    std::vector<uint8_t> pixels;
+};
+
+struct ttf_placed_glyph
+{
+    const ttf_atlas_glyph* glyph;
+    int32_t x;
 };
 
 struct ttf_getwidth_cache_entry
@@ -45,10 +69,12 @@ struct ttf_getwidth_cache_entry
     uint32_t lastUseTick;
 };
 
-static ttf_cache_entry _ttfSurfaceCache[TTF_SURFACE_CACHE_SIZE] = {};
-static int32_t _ttfSurfaceCacheCount = 0;
-static int32_t _ttfSurfaceCacheHitCount = 0;
-static int32_t _ttfSurfaceCacheMissCount = 0;
+static std::unordered_map<TTF_Font*, ttf_glyph_atlas> _ttfGlyphAtlases;
+
+// The string being composed, which is drawn after the font lock has been released
+static thread_local std::vector<ttf_placed_glyph> _ttfPlacedGlyphs;
+static thread_local std::vector<uint8_t> _ttfComposedPixels;
+static thread_local TTFSurface _ttfComposedSurface;
 
 static ttf_getwidth_cache_entry _ttfGetWidthCache[TTF_GETWIDTH_CACHE_SIZE] = {};
 static int32_t _ttfGetWidthCacheCount = 0;
@@ -59,13 +85,11 @@ static std::mutex _mutex;
 
 static TTF_Font* ttf_open_font(const utf8* fontPath, int32_t ptSize);
 static void ttf_close_font(TTF_Font* font);
-static uint32_t ttf_surface_cache_hash(TTF_Font* font, const utf8* text);
-static void ttf_surface_cache_dispose(ttf_cache_entry* entry);
-static void ttf_surface_cache_dispose_all();
+static uint32_t ttf_getwidth_cache_hash(TTF_Font* font, const utf8* text);
 static void ttf_getwidth_cache_dispose_all();
+static bool ttf_glyph_atlas_layout(TTF_Font* font, const utf8* text, int32_t* outWidth, int32_t* outHeight);
 static bool ttf_get_size(TTF_Font* font, const utf8* text, int32_t* width, int32_t* height);
 static void ttf_toggle_hinting(bool);
-static TTFSurface* ttf_render(TTF_Font* font, const utf8* text);
 
 template<typename T> class FontLockHelper
 {
@@ -101,10 +125,8 @@ static void ttf_toggle_hinting(bool)
         TTF_SetFontHinting(fontDesc->font, use_hinting ? 1 : 0);
     }
 
-    if (_ttfSurfaceCacheCount)
-    {
-        ttf_surface_cache_dispose_all();
-    }
+    // The glyphs were rasterised with the old hinting
+    _ttfGlyphAtlases.clear();
 }
 
 bool ttf_initialise()
@@ -140,6 +162,7 @@ bool ttf_initialise()
     }
 
     ttf_toggle_hinting(true);
+    text_layout_cache_clear();
 
     _ttfInitialised = true;
 
@@ -153,7 +176,7 @@ void ttf_dispose()
     if (!_ttfInitialised)
         return;
 
-    ttf_surface_cache_dispose_all();
+    _ttfGlyphAtlases.clear();
     ttf_getwidth_cache_dispose_all();
 
     for (int32_t i = 0; i < FONT_SIZE_COUNT; i++)
@@ -167,6 +190,7 @@ void ttf_dispose()
     }
 
     TTF_Quit();
+    text_layout_cache_clear();
 
     _ttfInitialised = false;
 }
@@ -181,7 +205,7 @@ static void ttf_close_font(TTF_Font* font)
     TTF_CloseFont(font);
 }
 
-static uint32_t ttf_surface_cache_hash(TTF_Font* font, const utf8* text)
+static uint32_t ttf_getwidth_cache_hash(TTF_Font* font, const utf8* text)
 {
     uint32_t hash = (uint32_t)((((uintptr_t)font * 23) ^ 0xAAAAAAAA) & 0xFFFFFFFF);
     for (const utf8* ch = text; *ch != 0; ch++)
@@ -191,87 +215,11 @@ static uint32_t ttf_surface_cache_hash(TTF_Font* font, const utf8* text)
     return hash;
 }
 
-static void ttf_surface_cache_dispose(ttf_cache_entry* entry)
-{
-    if (entry->surface != nullptr)
-    {
-        ttf_free_surface(entry->surface);
-        free(entry->text);
-
-        entry->surface = nullptr;
-        entry->font = nullptr;
-        entry->text = nullptr;
-    }
-}
-
-static void ttf_surface_cache_dispose_all()
-{
-    for (int32_t i = 0; i < TTF_SURFACE_CACHE_SIZE; i++)
-    {
-        ttf_surface_cache_dispose(&_ttfSurfaceCache[i]);
-        _ttfSurfaceCacheCount--;
-    }
-}
-
 void ttf_toggle_hinting()
 {
     FontLockHelper<std::mutex> lock(_mutex);
     ttf_toggle_hinting(true);
-}
-
-TTFSurface* ttf_surface_cache_get_or_add(TTF_Font* font, const utf8* text)
-{
-    ttf_cache_entry* entry;
-
-    uint32_t hash = ttf_surface_cache_hash(font, text);
-    int32_t index = hash % TTF_SURFACE_CACHE_SIZE;
-
-    FontLockHelper<std::mutex> lock(_mutex);
-
-    for (int32_t i = 0; i < TTF_SURFACE_CACHE_SIZE; i++)
-    {
-        entry = &_ttfSurfaceCache[index];
-
-        // Check if entry is a hit
-        if (entry->surface == nullptr)
-            break;
-        if (entry->font == font && strcmp(entry->text, text) == 0)
-        {
-            _ttfSurfaceCacheHitCount++;
-            entry->lastUseTick = gCurrentDrawCount;
-            return entry->surface;
-        }
-
-        // If entry hasn't been used for a while, replace it
-        if (entry->lastUseTick < gCurrentDrawCount - 64)
-        {
-            break;
-        }
-
-        // Check if next entry is a hit
-        if (++index >= TTF_SURFACE_CACHE_SIZE)
-            index = 0;
-    }
-
-    // Cache miss, replace entry with new surface
-    entry = &_ttfSurfaceCache[index];
-    ttf_surface_cache_dispose(entry);
-
-    TTFSurface* surface = ttf_render(font, text);
-    if (surface == nullptr)
-    {
-        return nullptr;
-    }
-
-    _ttfSurfaceCacheMissCount++;
-    // printf("CACHE HITS: %d   MISSES: %d)\n", _ttfSurfaceCacheHitCount, _ttfSurfaceCacheMissCount);
-
-    _ttfSurfaceCacheCount++;
-    entry->surface = surface;
-    entry->font = font;
-    entry->text = _strdup(text);
-    entry->lastUseTick = gCurrentDrawCount;
-    return entry->surface;
+    text_layout_cache_clear();
 }
 
 static void ttf_getwidth_cache_dispose(ttf_getwidth_cache_entry* entry)
@@ -299,7 +247,7 @@ uint32_t ttf_getwidth_cache_get_or_add(TTF_Font* font, const utf8* text)
 {
     ttf_getwidth_cache_entry* entry;
 
-    uint32_t hash = ttf_surface_cache_hash(font, text);
+    uint32_t hash = ttf_getwidth_cache_hash(font, text);
     int32_t index = hash % TTF_GETWIDTH_CACHE_SIZE;
 
     FontLockHelper<std::mutex> lock(_mutex);
@@ -359,25 +307,143 @@ bool ttf_provides_glyph(const TTF_Font* font, codepoint_t codepoint)
 
 static bool ttf_get_size(TTF_Font* font, const utf8* text, int32_t* outWidth, int32_t* outHeight)
 {
-    return TTF_SizeUTF8(font, text, outWidth, outHeight);
+    if (!ttf_glyph_atlas_layout(font, text, outWidth, outHeight))
+    {
+        *outWidth = 0;
+        *outHeight = 0;
+        return false;
+    }
+    return true;
 }
 
-static TTFSurface* ttf_render(TTF_Font* font, const utf8* text)
+/**
+ * Looks up the glyphs of the string in the atlas of the font, copying the ones that are missing from FreeType, and
+ * places them into _ttfPlacedGlyphs. The size of the string is measured the same way as TTF_SizeUTF8. The fonts are
+ * never given a style, so there is no emboldening or underlining to do. The font lock must be held.
+ */
+static bool ttf_glyph_atlas_layout(TTF_Font* font, const utf8* text, int32_t* outWidth, int32_t* outHeight)
 {
-    if (TTF_GetFontHinting(font) != 0)
+    auto& atlas = _ttfGlyphAtlases[font];
+    if (atlas.pixels.size() >= TTF_GLYPH_ATLAS_SIZE)
     {
-        return TTF_RenderUTF8_Shaded(font, text, 0x000000FF, 0x000000FF);
+        // Only fonts with many characters get this far, start again rather than tracking when each glyph was used
+        atlas.glyphs.clear();
+        atlas.pixels.clear();
+    }
+
+    // The hinted glyphs are anti-aliased and the others are monochrome, like ttf_render used to choose
+    bool pixmap = TTF_GetFontHinting(font) != 0;
+    int32_t x = 0;
+    int32_t minx = 0;
+    int32_t maxx = 0;
+    int32_t miny = 0;
+    int32_t offsetX = 0;
+    uint32_t prevIndex = 0;
+    _ttfPlacedGlyphs.clear();
+
+    uint32_t codepoint;
+    while ((codepoint = utf8_get_next(text, &text)) != 0)
+    {
+        // Like the FreeType port, only the basic multilingual plane is supported and byte order marks are skipped
+        auto ch = (uint16_t)codepoint;
+        if (ch == 0xFEFF || ch == 0xFFFE)
+        {
+            continue;
+        }
+
+        auto it = atlas.glyphs.find(ch);
+        if (it == atlas.glyphs.end())
+        {
+            TTFGlyph src;
+            if (TTF_GetGlyph(font, ch, pixmap, &src) != 0)
+            {
+                return false;
+            }
+
+            ttf_atlas_glyph glyph = { (uint32_t)atlas.pixels.size(), src.index, src.width, src.rows, src.minx,
+                                      src.maxx, src.miny, src.yoffset, src.advance };
+            for (int32_t row = 0; row < src.rows; row++)
+            {
+                const uint8_t* srcRow = src.pixels + row * src.pitch;
+                atlas.pixels.insert(atlas.pixels.end(), srcRow, srcRow + src.width);
+            }
+            it = atlas.glyphs.emplace(ch, glyph).first;
+        }
+
+        // The atlas is a node based map, so the glyph stays where it is as more glyphs are added
+        const auto& glyph = it->second;
+        x += TTF_GetKerning(font, prevIndex, glyph.index);
+        if (_ttfPlacedGlyphs.empty() && glyph.minx < 0)
+        {
+            // Move the string to the right so the first glyph is not cut off
+            offsetX = -glyph.minx;
+        }
+        _ttfPlacedGlyphs.push_back({ &glyph, x });
+
+        minx = std::min(minx, x + glyph.minx);
+        maxx = std::max(maxx, x + std::max(glyph.advance, glyph.maxx));
+        miny = std::min(miny, glyph.miny);
+        x += glyph.advance;
+        prevIndex = glyph.index;
     }
-    else
+
+    for (auto& placed : _ttfPlacedGlyphs)
     {
-        return TTF_RenderUTF8_Solid(font, text, 0x000000FF);
+        placed.x += offsetX;
     }
+
+    // Some fonts descend below the font height
+    *outWidth = maxx - minx;
+    *outHeight = std::max(TTF_FontAscent(font) - miny, TTF_FontHeight(font));
+    return true;
 }
 
-void ttf_free_surface(TTFSurface* surface)
+/**
+ * Composes the string from the glyphs in the atlas of the font. The surface belongs to the calling thread and is only
+ * valid until it composes another string.
+ */
+const TTFSurface* ttf_surface_compose(TTF_Font* font, const utf8* text)
 {
-    free((void*)surface->pixels);
-    free(surface);
+    FontLockHelper<std::mutex> lock(_mutex);
+
+    int32_t width, height;
+    if (!ttf_glyph_atlas_layout(font, text, &width, &height) || width <= 0)
+    {
+        return nullptr;
+    }
+
+    _ttfComposedPixels.assign((size_t)width * height, 0);
+    uint8_t* pixels = _ttfComposedPixels.data();
+    const uint8_t* pixelsEnd = pixels + _ttfComposedPixels.size();
+    const uint8_t* atlasPixels = _ttfGlyphAtlases[font].pixels.data();
+    for (const auto& placed : _ttfPlacedGlyphs)
+    {
+        const auto& glyph = *placed.glyph;
+        const uint8_t* src = atlasPixels + glyph.offset;
+        for (int32_t row = 0; row < glyph.rows; row++, src += glyph.width)
+        {
+            int32_t y = row + glyph.yoffset;
+            if (y < 0 || y >= height)
+            {
+                continue;
+            }
+
+            uint8_t* dst = pixels + y * width + placed.x + glyph.minx;
+            for (int32_t col = 0; col < glyph.width && dst < pixelsEnd; col++, dst++)
+            {
+                if (dst >= pixels)
+                {
+                    *dst |= src[col];
+                }
+            }
+        }
+    }
+
+    _ttfComposedSurface.pixels = pixels;
+    _ttfComposedSurface.w = width;
+    _ttfComposedSurface.h = height;
+    _ttfComposedSurface.pitch = width;
+    return &_ttfComposedSurface;
 }
 
 #else
@@ -24,23 +24,42 @@ struct TTFSurface
     int32_t pitch;
 };
 
+/**
+ * A glyph rasterised by FreeType, the pixels belong to the font's glyph cache and are only valid until the next glyph
+ * is loaded from the font.
+ */
+struct TTFGlyph
+{
+    const uint8_t* pixels;
+    int32_t width;
+    int32_t rows;
+    int32_t pitch;
+    uint32_t index;
+    int32_t minx;
+    int32_t maxx;
+    int32_t miny;
+    int32_t yoffset;
+    int32_t advance;
+};
+
 TTFFontDescriptor* ttf_get_font_from_sprite_base(uint16_t spriteBase);
 void ttf_toggle_hinting();
-TTFSurface* ttf_surface_cache_get_or_add(TTF_Font* font, const utf8* text);
+const TTFSurface* ttf_surface_compose(TTF_Font* font, const utf8* text);
 uint32_t ttf_getwidth_cache_get_or_add(TTF_Font* font, const utf8* text);
 bool ttf_provides_glyph(const TTF_Font* font, codepoint_t codepoint);
-void ttf_free_surface(TTFSurface* surface);
 
 // TTF_SDLPORT
 int TTF_Init(void);
 TTF_Font* TTF_OpenFont(const char* file, int ptsize);
 int TTF_GlyphIsProvided(const TTF_Font* font, codepoint_t ch);
 int TTF_SizeUTF8(TTF_Font* font, const char* text, int* w, int* h);
-TTFSurface* TTF_RenderUTF8_Solid(TTF_Font* font, const char* text, uint32_t colour);
-TTFSurface* TTF_RenderUTF8_Shaded(TTF_Font* font, const char* text, uint32_t fg, uint32_t bg);
 void TTF_CloseFont(TTF_Font* font);
 void TTF_SetFontHinting(TTF_Font* font, int hinting);
 int TTF_GetFontHinting(const TTF_Font* font);
+int TTF_GetGlyph(TTF_Font* font, uint16_t ch, bool pixmap, TTFGlyph* outGlyph);
+int TTF_GetKerning(TTF_Font* font, uint32_t prev_index, uint32_t index);
+int TTF_FontHeight(const TTF_Font* font);
+int TTF_FontAscent(const TTF_Font* font);
 void TTF_Quit(void);
 
 #endif // NO_TTF
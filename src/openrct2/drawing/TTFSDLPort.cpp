@@ -190,6 +190,7 @@ static int TTF_underline_bottom_row(TTF_Font* font)
     return row;
 }
 
+#    ifdef DEBUG_FONTS
 /* Gets the top row of the strikethrough. The outline
 is taken into account.
 */
@@ -199,70 +200,7 @@ static int TTF_strikethrough_top_row(TTF_Font* font)
     /* So, we don't have to remove the top part of the outline height. */
     return font->height / 2;
 }
-
-static void TTF_initLineMectrics(const TTF_Font* font, const TTFSurface* textbuf, const int row, uint8_t** pdst, int* pheight)
-{
-    uint8_t* dst;
-    int height;
-
-    dst = (uint8_t*)textbuf->pixels;
-    if (row > 0)
-    {
-        dst += row * textbuf->pitch;
-    }
-
-    height = font->underline_height;
-    /* Take outline into account */
-    if (font->outline > 0)
-    {
-        height += font->outline * 2;
-    }
-    *pdst = dst;
-    *pheight = height;
-}
-
-/* Draw a solid line of underline_height (+ optional outline)
-at the given row. The row value must take the
-outline into account.
-*/
-static void TTF_drawLine_Solid(const TTF_Font* font, const TTFSurface* textbuf, const int row)
-{
-    int line;
-    uint8_t* dst_check = (uint8_t*)textbuf->pixels + textbuf->pitch * textbuf->h;
-    uint8_t* dst;
-    int height;
-
-    TTF_initLineMectrics(font, textbuf, row, &dst, &height);
-
-    /* Draw line */
-    for (line = height; line > 0 && dst < dst_check; --line)
-    {
-        /* 1 because 0 is the bg color */
-        std::fill_n(dst, textbuf->w, 0x01);
-        dst += textbuf->pitch;
-    }
-}
-
-/* Draw a shaded line of underline_height (+ optional outline)
-   at the given row. The row value must take the
-   outline into account.
-*/
-static void TTF_drawLine_Shaded(const TTF_Font* font, const TTFSurface* textbuf, const int row)
-{
-    int line;
-    uint8_t* dst_check = (uint8_t*)textbuf->pixels + textbuf->pitch * textbuf->h;
-    uint8_t* dst;
-    int height;
-
-    TTF_initLineMectrics(font, textbuf, row, &dst, &height);
-
-    /* Draw line */
-    for (line = height; line > 0 && dst < dst_check; --line)
-    {
-        std::fill_n(dst, textbuf->w, NUM_GRAYS - 1);
-        dst += textbuf->pitch;
-    }
-}
+#    endif
 
 static void TTF_SetFTError(const char* msg, [[maybe_unused]] FT_Error error)
 {
@@ -1255,299 +1193,88 @@ int TTF_SizeUTF8(TTF_Font* font, const char* text, int* w, int* h)
     return status;
 }
 
-TTFSurface* TTF_RenderUTF8_Solid(TTF_Font* font, const char* text, [[maybe_unused]] uint32_t colour)
+void TTF_SetFontHinting(TTF_Font* font, int hinting)
 {
-    bool first;
-    int xstart;
-    int width;
-    int height;
-    TTFSurface* textbuf;
-    uint8_t* src;
-    uint8_t* dst;
-    uint8_t* dst_check;
-    unsigned int row, col;
-    c_glyph* glyph;
-
-    FT_Bitmap* current;
-    FT_Error error;
-    FT_Long use_kerning;
-    FT_UInt prev_index = 0;
-    size_t textlen;
-
-    TTF_CHECKPOINTER(text, NULL);
-
-    /* Get the dimensions of the text surface */
-    if ((TTF_SizeUTF8(font, text, &width, &height) < 0) || !width)
-    {
-        TTF_SetError("Text has zero width");
-        return NULL;
-    }
-
-    /* Create the target surface */
-    textbuf = (TTFSurface*)calloc(1, sizeof(TTFSurface));
-    if (textbuf == NULL)
-    {
-        return NULL;
-    }
-    textbuf->w = width;
-    textbuf->h = height;
-    textbuf->pitch = width;
-    textbuf->pixels = calloc(1, width * height);
-
-    /* Adding bound checking to avoid all kinds of memory corruption errors
-    that may occur. */
-    dst_check = (uint8_t*)textbuf->pixels + textbuf->pitch * textbuf->h;
-
-    /* check kerning */
-    use_kerning = FT_HAS_KERNING(font->face) && font->kerning;
-
-    /* Load and render each character */
-    textlen = strlen(text);
-    first = true;
-    xstart = 0;
-    while (textlen > 0)
-    {
-        uint16_t c = UTF8_getch(&text, &textlen);
-        if (c == UNICODE_BOM_NATIVE || c == UNICODE_BOM_SWAPPED)
-        {
-            continue;
-        }
-
-        error = Find_Glyph(font, c, CACHED_METRICS | CACHED_BITMAP);
-        if (error)
-        {
-            TTF_SetFTError("Couldn't find glyph", error);
-            ttf_free_surface(textbuf);
-            return NULL;
-        }
-        glyph = font->current;
-        current = &glyph->bitmap;
-        /* Ensure the width of the pixmap is correct. On some cases,
-         * freetype may report a larger pixmap than possible.*/
-        width = current->width;
-        if (font->outline <= 0 && width > glyph->maxx - glyph->minx)
-        {
-            width = glyph->maxx - glyph->minx;
-        }
-        /* do kerning, if possible AC-Patch */
-        if (use_kerning && prev_index && glyph->index)
-        {
-            FT_Vector delta;
-            FT_Get_Kerning(font->face, prev_index, glyph->index, ft_kerning_default, &delta);
-            xstart += delta.x >> 6;
-        }
-        /* Compensate for wrap around bug with negative minx's */
-        if (first && (glyph->minx < 0))
-        {
-            xstart -= glyph->minx;
-        }
-        first = false;
-
-        for (row = 0; row < current->rows; ++row)
-        {
-            /* Make sure we don't go either over, or under the
-             * limit */
-            if ((signed)row + glyph->yoffset < 0)
-            {
-                continue;
-            }
-            if ((signed)row + glyph->yoffset >= textbuf->h)
-            {
-                continue;
-            }
-            dst = (uint8_t*)textbuf->pixels + (row + glyph->yoffset) * textbuf->pitch + xstart + glyph->minx;
-            src = current->buffer + row * current->pitch;
-
-            for (col = width; col > 0 && dst < dst_check; --col)
-            {
-                *dst++ |= *src++;
-            }
-        }
-
-        xstart += glyph->advance;
-        if (TTF_HANDLE_STYLE_BOLD(font))
-        {
-            xstart += font->glyph_overhang;
-        }
-        prev_index = glyph->index;
-    }
+    if (hinting == TTF_HINTING_LIGHT)
+        font->hinting = FT_LOAD_TARGET_LIGHT;
+    else if (hinting == TTF_HINTING_MONO)
+        font->hinting = FT_LOAD_TARGET_MONO;
+    else if (hinting == TTF_HINTING_NONE)
+        font->hinting = FT_LOAD_NO_HINTING;
+    else
+        font->hinting = 0;
 
-    /* Handle the underline style */
-    if (TTF_HANDLE_STYLE_UNDERLINE(font))
-    {
-        row = TTF_underline_top_row(font);
-        TTF_drawLine_Solid(font, textbuf, row);
-    }
+    Flush_Cache(font);
+}
 
-    /* Handle the strikethrough style */
-    if (TTF_HANDLE_STYLE_STRIKETHROUGH(font))
-    {
-        row = TTF_strikethrough_top_row(font);
-        TTF_drawLine_Solid(font, textbuf, row);
-    }
-    return textbuf;
+int TTF_GetFontHinting(const TTF_Font* font)
+{
+    if (font->hinting == FT_LOAD_TARGET_LIGHT)
+        return TTF_HINTING_LIGHT;
+    else if (font->hinting == FT_LOAD_TARGET_MONO)
+        return TTF_HINTING_MONO;
+    else if (font->hinting == FT_LOAD_NO_HINTING)
+        return TTF_HINTING_NONE;
+    return 0;
 }
 
-TTFSurface* TTF_RenderUTF8_Shaded(TTF_Font* font, const char* text, [[maybe_unused]] uint32_t fg, [[maybe_unused]] uint32_t bg)
+int TTF_GetGlyph(TTF_Font* font, uint16_t ch, bool pixmap, TTFGlyph* outGlyph)
 {
-    bool first;
-    int xstart;
-    int width;
-    int height;
-    TTFSurface* textbuf;
-    uint8_t* src;
-    uint8_t* dst;
-    uint8_t* dst_check;
-    unsigned int row, col;
-    FT_Bitmap* current;
     c_glyph* glyph;
+    FT_Bitmap* current;
     FT_Error error;
-    FT_Long use_kerning;
-    FT_UInt prev_index = 0;
-    size_t textlen;
-
-    TTF_CHECKPOINTER(text, NULL);
+    int width;
 
-    /* Get the dimensions of the text surface */
-    if ((TTF_SizeUTF8(font, text, &width, &height) < 0) || !width)
+    error = Find_Glyph(font, ch, CACHED_METRICS | (pixmap ? CACHED_PIXMAP : CACHED_BITMAP));
+    if (error)
     {
-        TTF_SetError("Text has zero width");
-        return NULL;
+        TTF_SetFTError("Couldn't find glyph", error);
+        return -1;
     }
+    glyph = font->current;
+    current = pixmap ? &glyph->pixmap : &glyph->bitmap;
 
-    /* Create the target surface */
-    textbuf = (TTFSurface*)calloc(1, sizeof(TTFSurface));
-    if (textbuf == NULL)
+    /* Ensure the width of the pixmap is correct. On some cases,
+     * freetype may report a larger pixmap than possible.*/
+    width = current->width;
+    if (font->outline <= 0 && width > glyph->maxx - glyph->minx)
     {
-        return NULL;
+        width = std::max(glyph->maxx - glyph->minx, 0);
     }
-    textbuf->w = width;
-    textbuf->h = height;
-    textbuf->pitch = width;
-    textbuf->pixels = calloc(1, width * height);
-
-    /* Adding bound checking to avoid all kinds of memory corruption errors
-       that may occur. */
-    dst_check = (uint8_t*)textbuf->pixels + textbuf->pitch * textbuf->h;
-
-    /* check kerning */
-    use_kerning = FT_HAS_KERNING(font->face) && font->kerning;
-
-    /* Load and render each character */
-    textlen = strlen(text);
-    first = true;
-    xstart = 0;
-    while (textlen > 0)
-    {
-        uint16_t c = UTF8_getch(&text, &textlen);
-        if (c == UNICODE_BOM_NATIVE || c == UNICODE_BOM_SWAPPED)
-        {
-            continue;
-        }
-
-        error = Find_Glyph(font, c, CACHED_METRICS | CACHED_PIXMAP);
-        if (error)
-        {
-            TTF_SetFTError("Couldn't find glyph", error);
-            ttf_free_surface(textbuf);
-            return NULL;
-        }
-
-        glyph = font->current;
-
-        /* Ensure the width of the pixmap is correct. On some cases,
-         * freetype may report a larger pixmap than possible.*/
-        width = glyph->pixmap.width;
-        if (font->outline <= 0 && width > glyph->maxx - glyph->minx)
-        {
-            width = glyph->maxx - glyph->minx;
-        }
-
-        /* do kerning, if possible AC-Patch */
-        if (use_kerning && prev_index && glyph->index)
-        {
-            FT_Vector delta;
-            FT_Get_Kerning(font->face, prev_index, glyph->index, ft_kerning_default, &delta);
-            xstart += delta.x >> 6;
-        }
-
-        /* Compensate for the wrap around with negative minx's */
-        if (first && (glyph->minx < 0))
-        {
-            xstart -= glyph->minx;
-        }
-        first = false;
-
-        current = &glyph->pixmap;
-        for (row = 0; row < current->rows; ++row)
-        {
-            /* Make sure we don't go either over, or under the
-             * limit */
-            if ((signed)row + glyph->yoffset < 0)
-            {
-                continue;
-            }
-            if ((signed)row + glyph->yoffset >= textbuf->h)
-            {
-                continue;
-            }
-
-            dst = (uint8_t*)textbuf->pixels + (row + glyph->yoffset) * textbuf->pitch + xstart + glyph->minx;
-            src = current->buffer + row * current->pitch;
 
-            for (col = width; col > 0 && dst < dst_check; --col)
-            {
-                *dst++ |= *src++;
-            }
-        }
-
-        xstart += glyph->advance;
-        if (TTF_HANDLE_STYLE_BOLD(font))
-        {
-            xstart += font->glyph_overhang;
-        }
-        prev_index = glyph->index;
-    }
+    outGlyph->pixels = current->buffer;
+    outGlyph->width = width;
+    outGlyph->rows = current->rows;
+    outGlyph->pitch = current->pitch;
+    outGlyph->index = glyph->index;
+    outGlyph->minx = glyph->minx;
+    outGlyph->maxx = glyph->maxx;
+    outGlyph->miny = glyph->miny;
+    outGlyph->yoffset = glyph->yoffset;
+    outGlyph->advance = glyph->advance;
+    return 0;
+}
 
-    /* Handle the underline style */
-    if (TTF_HANDLE_STYLE_UNDERLINE(font))
-    {
-        row = TTF_underline_top_row(font);
-        TTF_drawLine_Shaded(font, textbuf, row);
-    }
+int TTF_GetKerning(TTF_Font* font, uint32_t prev_index, uint32_t index)
+{
+    FT_Vector delta;
 
-    /* Handle the strikethrough style */
-    if (TTF_HANDLE_STYLE_STRIKETHROUGH(font))
+    if (!FT_HAS_KERNING(font->face) || !font->kerning || !prev_index || !index)
     {
-        row = TTF_strikethrough_top_row(font);
-        TTF_drawLine_Shaded(font, textbuf, row);
+        return 0;
     }
-    return textbuf;
+    FT_Get_Kerning(font->face, prev_index, index, ft_kerning_default, &delta);
+    return delta.x >> 6;
 }
 
-void TTF_SetFontHinting(TTF_Font* font, int hinting)
+int TTF_FontHeight(const TTF_Font* font)
 {
-    if (hinting == TTF_HINTING_LIGHT)
-        font->hinting = FT_LOAD_TARGET_LIGHT;
-    else if (hinting == TTF_HINTING_MONO)
-        font->hinting = FT_LOAD_TARGET_MONO;
-    else if (hinting == TTF_HINTING_NONE)
-        font->hinting = FT_LOAD_NO_HINTING;
-    else
-        font->hinting = 0;
-
-    Flush_Cache(font);
+    return font->height;
 }
 
-int TTF_GetFontHinting(const TTF_Font* font)
+int TTF_FontAscent(const TTF_Font* font)
 {
-    if (font->hinting == FT_LOAD_TARGET_LIGHT)
-        return TTF_HINTING_LIGHT;
-    else if (font->hinting == FT_LOAD_TARGET_MONO)
-        return TTF_HINTING_MONO;
-    else if (font->hinting == FT_LOAD_NO_HINTING)
-        return TTF_HINTING_NONE;
-    return 0;
+    return font->ascent;
 }
 
 void TTF_Quit(void)
@@ -0,0 +1,110 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2019 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "TextLayoutCache.h"
+
+#include "../localisation/LocalisationService.h"
+#include "Drawing.h"
+
+#include <iterator>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+static constexpr size_t TEXT_LAYOUT_CACHE_SIZE = 2048;
+
+struct TextLayoutCacheEntry
+{
+    std::string Key;
+    TextLayout Layout;
+};
+
+// The most recently used entries are at the front
+static std::list<TextLayoutCacheEntry> _entries;
+static std::unordered_map<std::string, std::list<TextLayoutCacheEntry>::iterator> _entriesByKey;
+static TextLayoutCacheStats _stats;
+static std::string _keyBuffer;
+// Strings are also measured while painting viewports on the worker threads
+static std::mutex _mutex;
+
+/**
+ * Writes the key for the string into _keyBuffer, which is reused to avoid allocating for every look up. Everything
+ * besides the string that changes how it is laid out is put in front of it.
+ */
+static const std::string& text_layout_cache_make_key(TextLayoutKind kind, const utf8* text, int32_t width)
+{
+    auto append = [](const auto& value) { _keyBuffer.append((const char*)&value, sizeof(value)); };
+
+    _keyBuffer.clear();
+    append(kind);
+    append(LocalisationService_UseTrueTypeFont());
+    append(gCurrentFontSpriteBase);
+    append(gCurrentFontFlags);
+    append(width);
+    _keyBuffer.append(text);
+    return _keyBuffer;
+}
+
+bool text_layout_cache_get(TextLayoutKind kind, const utf8* text, int32_t width, TextLayout* outLayout)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    auto it = _entriesByKey.find(text_layout_cache_make_key(kind, text, width));
+    if (it == _entriesByKey.end())
+    {
+        _stats.Misses++;
+        return false;
+    }
+
+    _stats.Hits++;
+    _entries.splice(_entries.begin(), _entries, it->second);
+    *outLayout = it->second->Layout;
+    return true;
+}
+
+void text_layout_cache_add(TextLayoutKind kind, const utf8* text, int32_t width, const TextLayout& layout)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    const auto& key = text_layout_cache_make_key(kind, text, width);
+    if (_entriesByKey.find(key) != _entriesByKey.end())
+    {
+        return;
+    }
+
+    if (_entries.size() >= TEXT_LAYOUT_CACHE_SIZE)
+    {
+        // Reuse the least recently used entry and its string buffers
+        _entriesByKey.erase(_entries.back().Key);
+        _entries.splice(_entries.begin(), _entries, std::prev(_entries.end()));
+        _entries.front().Key = key;
+        _entries.front().Layout = layout;
+    }
+    else
+    {
+        _entries.push_front({ key, layout });
+    }
+    _entriesByKey.emplace(key, _entries.begin());
+}
+
+void text_layout_cache_clear()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _entriesByKey.clear();
+    _entries.clear();
+    _stats = {};
+}
+
+TextLayoutCacheStats text_layout_cache_get_stats()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto stats = _stats;
+    stats.Entries = _entries.size();
+    return stats;
+}
@@ -0,0 +1,61 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2019 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "../common.h"
+
+#include <string>
+
+enum class TextLayoutKind : uint8_t
+{
+    // The width of the string, see gfx_get_string_width
+    Width,
+    // The string with its line breaks, see gfx_wrap_string
+    Wrap,
+    // The string shortened with an ellipsis, see gfx_clip_string
+    Clip,
+};
+
+/**
+ * The result of laying out a string with the sprite or TrueType font.
+ */
+struct TextLayout
+{
+    int32_t Width = 0;
+    int32_t NumLines = 0;
+    // The laid out string for wrapping and clipping, which can contain null terminators between the lines
+    std::string Text;
+};
+
+struct TextLayoutCacheStats
+{
+    uint32_t Hits;
+    uint32_t Misses;
+    size_t Entries;
+};
+
+/**
+ * Looks up the layout of the formatted string in the current font, returns false if it has not been cached. Layouts are
+ * keyed on the formatted string, the current font and flags and the available width, and the least recently used ones
+ * are evicted once the cache is full.
+ */
+bool text_layout_cache_get(TextLayoutKind kind, const utf8* text, int32_t width, TextLayout* outLayout);
+
+/**
+ * Stores the layout of the formatted string in the current font.
+ */
+void text_layout_cache_add(TextLayoutKind kind, const utf8* text, int32_t width, const TextLayout& layout);
+
+/**
+ * Forgets all layouts, for when the fonts have been loaded or changed.
+ */
+void text_layout_cache_clear();
+
+TextLayoutCacheStats text_layout_cache_get_stats();
@@ -25,6 +25,7 @@
 #include "../core/String.hpp"
 #include "../drawing/Drawing.h"
 #include "../drawing/Font.h"
+#include "../drawing/TextLayoutCache.h"
 #include "../interface/Chat.h"
 #include "../interface/Colour.h"
 #include "../interface/Window_internal.h"
@@ -36,9 +37,12 @@
 #include "../object/ObjectList.h"
 #include "../object/ObjectManager.h"
 #include "../object/ObjectRepository.h"
+#include "../peep/MechanicDispatch.h"
 #include "../peep/Staff.h"
+#include "../platform/platform.h"
 #include "../ride/Ride.h"
 #include "../ride/RideData.h"
+#include "../ride/RideRatings.h"
 #include "../util/Util.h"
 #include "../windows/Intent.h"
 #include "../world/Climate.h"
@@ -419,10 +423,21 @@ static int32_t cc_rides(InteractiveConsole& console, const arguments_t& argv)
                 }
             }
         }
+        else if (argv[0] == "ratings")
+        {
+            std::vector<ride_id_t> rideIndexes;
+            for (const auto& ride : GetRideManager())
+            {
+                rideIndexes.push_back(ride.id);
+            }
+            auto startTicks = platform_get_ticks();
+            ride_ratings_update_rides(rideIndexes);
+            console.WriteFormatLine("Ride ratings calculated in %u ms", platform_get_ticks() - startTicks);
+        }
     }
     else
     {
-        console.WriteFormatLine("subcommands: list, set");
+        console.WriteFormatLine("subcommands: list, set, ratings");
     }
     return 0;
 }
@@ -505,10 +520,21 @@ static int32_t cc_staff(InteractiveConsole& console, const arguments_t& argv)
                 GameActions::Execute(&staffSetCostumeAction);
             }
         }
+        else if (argv[0] == "dispatch")
+        {
+            if (argv.size() > 1 && argv[1] == "reset")
+            {
+                mechanic_dispatch_reset_stats();
+            }
+            auto stats = mechanic_dispatch_get_stats();
+            console.WriteFormatLine(
+                "mechanic dispatch: %u requests, %u mechanics checked, %u path distance lookups in %u ticks", stats.Requests,
+                stats.MechanicsChecked, stats.PathDistanceQueries, stats.Ticks);
+        }
     }
     else
     {
-        console.WriteFormatLine("subcommands: list, set");
+        console.WriteFormatLine("subcommands: list, set, dispatch [reset]");
     }
     return 0;
 }
@@ -1218,8 +1244,7 @@ static int32_t cc_remove_park_fences(InteractiveConsole& console, [[maybe_unused
 
 static int32_t cc_show_limits(InteractiveConsole& console, [[maybe_unused]] const arguments_t& argv)
 {
-    map_reorganise_elements();
-    int32_t tileElementCount = gNextFreeTileElement - gTileElements - 1;
+    int32_t tileElementCount = static_cast<int32_t>(map_get_tile_element_count());
 
     int32_t rideCount = ride_get_count();
     int32_t spriteCount = 0;
@@ -1256,6 +1281,20 @@ static int32_t cc_show_limits(InteractiveConsole& console, [[maybe_unused]] cons
     return 0;
 }
 
+static int32_t cc_text_layout_cache(InteractiveConsole& console, const arguments_t& argv)
+{
+    if (!argv.empty() && argv[0] == "clear")
+    {
+        text_layout_cache_clear();
+    }
+    auto stats = text_layout_cache_get_stats();
+    auto lookups = stats.Hits + stats.Misses;
+    console.WriteFormatLine(
+        "text layout cache: %u hits, %u misses (%.1f%% hit rate), %u entries", stats.Hits, stats.Misses,
+        lookups == 0 ? 0.0 : stats.Hits * 100.0 / lookups, (uint32_t)stats.Entries);
+    return 0;
+}
+
 static int32_t cc_for_date([[maybe_unused]] InteractiveConsole& console, [[maybe_unused]] const arguments_t& argv)
 {
     int32_t year = 0;
@@ -1687,6 +1726,7 @@ static constexpr const console_command console_command_table[] = {
     { "show_limits", cc_show_limits, "Shows the map data counts and limits.", "show_limits" },
     { "staff", cc_staff, "Staff management.", "staff <subcommand>" },
     { "terminate", cc_terminate, "Calls std::terminate(), for testing purposes only.", "terminate" },
+    { "text_layout_cache", cc_text_layout_cache, "Shows the hit rate of the text layout cache.", "text_layout_cache [clear]" },
     { "twitch", cc_twitch, "Twitch API", "twitch" },
     { "variables", cc_variables, "Lists all the variables that can be used with get and sometimes set.", "variables" },
     { "windows", cc_windows, "Lists all the windows that can be opened.", "windows" },
@@ -17,7 +17,10 @@
 #include "../core/Guard.hpp"
 #include "../core/JobPool.hpp"
 #include "../drawing/Drawing.h"
+#include "../object/Object.h"
+#include "../object/ObjectManager.h"
 #include "../paint/Paint.h"
+#include "../platform/platform.h"
 #include "../peep/Staff.h"
 #include "../ride/Ride.h"
 #include "../ride/TrackDesign.h"
@@ -32,6 +35,7 @@
 
 #include <algorithm>
 #include <cstring>
+#include <unordered_set>
 
 using namespace OpenRCT2;
 
@@ -45,6 +49,12 @@ rct_viewport* g_music_tracking_viewport;
 
 static std::unique_ptr<JobPool> _paintJobs;
 
+static std::unique_ptr<JobPool> _imagePrefetchJobs;
+static CoordsXY _lastImagePrefetchLocation;
+static uint32_t _lastImagePrefetchTicks;
+static bool _imagePrefetchPending;
+static int32_t _imagePrefetchRadius;
+
 int16_t gSavedViewX;
 int16_t gSavedViewY;
 uint8_t gSavedViewZoom;
@@ -519,6 +529,105 @@ static void viewport_set_underground_flag(int32_t underground, rct_window* windo
     }
 }
 
+/**
+ * Requests the image data of the objects around the given location to be prefetched the next time the main
+ * viewport is painted. A margin around the viewport is included so that objects are already prefetched when the
+ * viewport scrolls towards them.
+ */
+static void viewport_request_object_image_prefetch(const rct_viewport* viewport, const CoordsXY& centre)
+{
+    constexpr int32_t RefreshDistance = 8 * COORDS_XY_STEP;
+    constexpr uint32_t RefreshTicks = 10000;
+    constexpr int32_t MarginTiles = 8;
+
+    auto currentTicks = platform_get_ticks();
+    if (std::abs(centre.x - _lastImagePrefetchLocation.x) < RefreshDistance
+        && std::abs(centre.y - _lastImagePrefetchLocation.y) < RefreshDistance
+        && currentTicks - _lastImagePrefetchTicks < RefreshTicks)
+    {
+        return;
+    }
+    _lastImagePrefetchLocation = centre;
+    _lastImagePrefetchTicks = currentTicks;
+    _imagePrefetchPending = true;
+    _imagePrefetchRadius = std::min((viewport->view_width / 64) + MarginTiles, MAXIMUM_MAP_SIZE_TECHNICAL / 2);
+}
+
+/**
+ * Starts reading in the image data of the objects on the tiles around the given location in the background, so it
+ * is resident by the time it is drawn. Only image tables that are mapped from the object cache can be prefetched.
+ * This runs on the prefetch thread while the viewport is painted, when the map is not modified.
+ */
+static void viewport_prefetch_object_images(const CoordsXY& centre, int32_t radius)
+{
+    auto& objectManager = GetContext()->GetObjectManager();
+    std::unordered_set<const Object*> objects;
+    auto addObject = [&objectManager, &objects](int32_t objectType, size_t index) {
+        auto object = objectManager.GetLoadedObject(objectType, index);
+        if (object != nullptr)
+        {
+            objects.insert(object);
+        }
+    };
+
+    auto centreTile = TileCoordsXY(centre);
+    for (int32_t y = std::max(0, centreTile.y - radius); y <= std::min(gMapSize - 1, centreTile.y + radius); y++)
+    {
+        for (int32_t x = std::max(0, centreTile.x - radius); x <= std::min(gMapSize - 1, centreTile.x + radius); x++)
+        {
+            auto tileElement = map_get_first_element_at(TileCoordsXY{ x, y }.ToCoordsXY());
+            if (tileElement == nullptr)
+                continue;
+            do
+            {
+                switch (tileElement->GetType())
+                {
+                    case TILE_ELEMENT_TYPE_SURFACE:
+                        addObject(OBJECT_TYPE_TERRAIN_SURFACE, tileElement->AsSurface()->GetSurfaceStyle());
+                        addObject(OBJECT_TYPE_TERRAIN_EDGE, tileElement->AsSurface()->GetEdgeStyle());
+                        break;
+                    case TILE_ELEMENT_TYPE_PATH:
+                        addObject(OBJECT_TYPE_PATHS, tileElement->AsPath()->GetPathEntryIndex());
+                        if (tileElement->AsPath()->HasAddition())
+                        {
+                            addObject(OBJECT_TYPE_PATH_BITS, tileElement->AsPath()->GetAdditionEntryIndex());
+                        }
+                        break;
+                    case TILE_ELEMENT_TYPE_TRACK:
+                    {
+                        auto ride = get_ride(tileElement->AsTrack()->GetRideIndex());
+                        if (ride != nullptr)
+                        {
+                            addObject(OBJECT_TYPE_RIDE, ride->subtype);
+                        }
+                        break;
+                    }
+                    case TILE_ELEMENT_TYPE_SMALL_SCENERY:
+                        addObject(OBJECT_TYPE_SMALL_SCENERY, tileElement->AsSmallScenery()->GetEntryIndex());
+                        break;
+                    case TILE_ELEMENT_TYPE_LARGE_SCENERY:
+                        addObject(OBJECT_TYPE_LARGE_SCENERY, tileElement->AsLargeScenery()->GetEntryIndex());
+                        break;
+                    case TILE_ELEMENT_TYPE_WALL:
+                        addObject(OBJECT_TYPE_WALLS, tileElement->AsWall()->GetEntryIndex());
+                        break;
+                    case TILE_ELEMENT_TYPE_ENTRANCE:
+                        if (tileElement->AsEntrance()->GetEntranceType() == ENTRANCE_TYPE_PARK_ENTRANCE)
+                        {
+                            addObject(OBJECT_TYPE_PARK_ENTRANCE, 0);
+                        }
+                        break;
+                }
+            } while (!(tileElement++)->IsLastForTile());
+        }
+    }
+
+    for (auto object : objects)
+    {
+        object->GetImageTable().Prefetch();
+    }
+}
+
 /**
  *
  *  rct2: 0x006E7A3A
@@ -584,6 +693,11 @@ void viewport_update_position(rct_window* window)
         }
     }
 
+    if (window->classification == WC_MAIN_WINDOW && !gOpenRCT2NoGraphics)
+    {
+        viewport_request_object_image_prefetch(viewport, mapCoord);
+    }
+
     x = window->saved_view_x;
     y = window->saved_view_y;
     if (window->flags & WF_SCROLLING_TO_LOCATION)
@@ -918,6 +1032,21 @@ void viewport_paint(
     if (window_get_main() != nullptr && viewport != window_get_main()->viewport)
         useMultithreading = false;
 
+    // The tiles around the view are scanned for objects to prefetch on another thread while this viewport is painted
+    bool prefetchingImages = false;
+    if (_imagePrefetchPending && window_get_main() != nullptr && viewport == window_get_main()->viewport)
+    {
+        if (_imagePrefetchJobs == nullptr)
+        {
+            _imagePrefetchJobs = std::make_unique<JobPool>(1);
+        }
+        _imagePrefetchJobs->AddTask([centre = _lastImagePrefetchLocation, radius = _imagePrefetchRadius]() -> void {
+            viewport_prefetch_object_images(centre, radius);
+        });
+        _imagePrefetchPending = false;
+        prefetchingImages = true;
+    }
+
     if (useMultithreading && _paintJobs == nullptr)
     {
         _paintJobs = std::make_unique<JobPool>();
@@ -972,6 +1101,11 @@ void viewport_paint(
     {
         viewport_paint_column(column);
     }
+
+    if (prefetchingImages)
+    {
+        _imagePrefetchJobs->Join();
+    }
 }
 
 static void viewport_paint_weather_gloom(rct_drawpixelinfo* dpi)
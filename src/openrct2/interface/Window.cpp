@@ -18,6 +18,7 @@
 #include "../config/Config.h"
 #include "../core/Guard.hpp"
 #include "../drawing/Drawing.h"
+#include "../drawing/IDrawingEngine.h"
 #include "../interface/Cursors.h"
 #include "../localisation/Localisation.h"
 #include "../localisation/StringIds.h"
@@ -34,11 +35,13 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstring>
+#include <deque>
 #include <functional>
 #include <iterator>
-#include <list>
+#include <vector>
 
-std::list<std::shared_ptr<rct_window>> g_window_list;
+std::vector<std::shared_ptr<rct_window>> g_window_list;
 rct_window* gWindowAudioExclusive;
 
 uint16_t TextInputDescriptionArgs[4];
@@ -84,24 +87,47 @@ namespace WindowCloseFlags
     static constexpr uint32_t CloseSingle = (1 << 1);
 } // namespace WindowCloseFlags
 
+// Copies of the window list for visits that can open or close windows, one for each level of nested visits. They are
+// kept for reuse so visiting the windows does not allocate.
+static std::deque<std::vector<std::shared_ptr<rct_window>>> _windowListSnapshots;
+static size_t _windowListSnapshotDepth;
+
 static int32_t window_draw_split(
     rct_drawpixelinfo* dpi, rct_window* w, int32_t left, int32_t top, int32_t right, int32_t bottom);
 static void window_draw_single(rct_drawpixelinfo* dpi, rct_window* w, int32_t left, int32_t top, int32_t right, int32_t bottom);
 
-std::list<std::shared_ptr<rct_window>>::iterator window_get_iterator(const rct_window* w)
+std::vector<std::shared_ptr<rct_window>>::iterator window_get_iterator(const rct_window* w)
 {
     return std::find_if(g_window_list.begin(), g_window_list.end(), [w](const std::shared_ptr<rct_window>& w2) -> bool {
         return w == w2.get();
     });
 }
 
-void window_visit_each(std::function<void(rct_window*)> func)
+/**
+ * Calls func with a copy of the window list, which stays valid when windows are opened or closed by func.
+ */
+template<typename TFunc> static void window_visit_snapshot(TFunc func)
 {
-    auto windowList = g_window_list;
-    for (auto& w : windowList)
+    if (_windowListSnapshotDepth == _windowListSnapshots.size())
     {
-        func(w.get());
+        _windowListSnapshots.emplace_back();
     }
+    auto& windowList = _windowListSnapshots[_windowListSnapshotDepth++];
+    windowList.assign(g_window_list.begin(), g_window_list.end());
+    func(windowList);
+    // Release the windows but keep the capacity for the next visit
+    windowList.clear();
+    _windowListSnapshotDepth--;
+}
+
+void window_visit_each(std::function<void(rct_window*)> func)
+{
+    window_visit_snapshot([&func](const std::vector<std::shared_ptr<rct_window>>& windowList) {
+        for (auto& w : windowList)
+        {
+            func(w.get());
+        }
+    });
 }
 
 /**
@@ -273,11 +299,12 @@ template<typename _TPred> static void window_close_by_condition(_TPred pred, uin
 
         // The closest to something like for_each_if is using find_if in order to avoid duplicate code
         // to change the loop direction.
-        auto windowList = g_window_list;
-        if ((flags & WindowCloseFlags::IterateReverse) != 0)
-            listUpdated = std::find_if(windowList.rbegin(), windowList.rend(), closeSingle) != windowList.rend();
-        else
-            listUpdated = std::find_if(windowList.begin(), windowList.end(), closeSingle) != windowList.end();
+        window_visit_snapshot([&](const std::vector<std::shared_ptr<rct_window>>& windowList) {
+            if ((flags & WindowCloseFlags::IterateReverse) != 0)
+                listUpdated = std::find_if(windowList.rbegin(), windowList.rend(), closeSingle) != windowList.rend();
+            else
+                listUpdated = std::find_if(windowList.begin(), windowList.end(), closeSingle) != windowList.end();
+        });
 
         // If requested to close only a single window and a new window was created during close
         // we ignore it.
@@ -500,7 +527,21 @@ void window_invalidate_by_number(rct_windowclass cls, rct_windownumber number)
  */
 void window_invalidate_all()
 {
-    window_visit_each([](rct_window* w) { w->Invalidate(); });
+    for (auto& w : g_window_list)
+    {
+        w->Invalidate();
+    }
+}
+
+/**
+ * Marks the render caches of all windows to be painted again, without invalidating the screen.
+ */
+void window_invalidate_all_render_caches()
+{
+    for (auto& w : g_window_list)
+    {
+        w->render_cache.Invalidate(0, 0, w->width, w->height);
+    }
 }
 
 /**
@@ -523,6 +564,7 @@ void widget_invalidate(rct_window* w, rct_widgetindex widgetIndex)
     if (widget->left == -2)
         return;
 
+    w->render_cache.Invalidate(widget->left, widget->top, widget->right + 1, widget->bottom + 1);
     gfx_set_dirty_blocks(w->x + widget->left, w->y + widget->top, w->x + widget->right + 1, w->y + widget->bottom + 1);
 }
 
@@ -658,7 +700,10 @@ rct_window* window_bring_to_front(rct_window* w)
                 }
             }
 
-            g_window_list.splice(itDestPos, g_window_list, itSourcePos);
+            if (itSourcePos < itDestPos)
+                std::rotate(itSourcePos, std::next(itSourcePos), itDestPos);
+            else
+                std::rotate(itDestPos, itSourcePos, std::next(itSourcePos));
             w->Invalidate();
 
             if (w->x + w->width < 20)
@@ -1117,11 +1162,11 @@ void window_draw(rct_drawpixelinfo* dpi, rct_window* w, int32_t left, int32_t to
     if (top >= bottom)
         return;
 
-    // Draw the window in this region
-    for (auto it = window_get_iterator(w); it != g_window_list.end(); it++)
+    // Draw the window in this region, by index as painting could open a window and move the others in the list
+    for (auto i = (size_t)std::distance(g_window_list.begin(), window_get_iterator(w)); i < g_window_list.size(); i++)
     {
         // Don't draw overlapping opaque windows, they won't have changed
-        auto v = (*it).get();
+        auto v = g_window_list[i].get();
         if ((w == v || (v->flags & WF_TRANSPARENT)) && window_is_visible(v))
         {
             window_draw_single(dpi, v, left, top, right, bottom);
@@ -1183,6 +1228,95 @@ static int32_t window_draw_split(
     return 0;
 }
 
+/**
+ * Whether the window can be drawn from its render cache. The window must paint every pixel of its area without
+ * blending with what is underneath it, and must not contain a viewport, which is redrawn without invalidating the
+ * window. The cache is only used by the software drawing engines, which are the only ones that draw dirty blocks.
+ */
+static bool window_can_use_render_cache(rct_drawpixelinfo* dpi, rct_window* w)
+{
+    if (dpi->DrawingEngine == nullptr || !(dpi->DrawingEngine->GetFlags() & DEF_DIRTY_OPTIMISATIONS))
+        return false;
+    if (dpi->zoom_level != 0 || w->viewport != nullptr || (w->flags & WF_NO_BACKGROUND))
+        return false;
+    if (w->widgets == nullptr || w->widgets[0].type != WWT_FRAME)
+        return false;
+    for (auto colour : w->colours)
+    {
+        if (colour & COLOUR_FLAG_TRANSLUCENT)
+            return false;
+    }
+    return true;
+}
+
+static void window_paint(rct_drawpixelinfo* dpi, rct_window* w)
+{
+    // Invalidate modifies the window colours so first get the correct
+    // colour before setting the global variables for the string painting
+    window_event_invalidate_call(w);
+
+    // Text colouring
+    gCurrentWindowColours[0] = NOT_TRANSLUCENT(w->colours[0]);
+    gCurrentWindowColours[1] = NOT_TRANSLUCENT(w->colours[1]);
+    gCurrentWindowColours[2] = NOT_TRANSLUCENT(w->colours[2]);
+    gCurrentWindowColours[3] = NOT_TRANSLUCENT(w->colours[3]);
+
+    window_event_paint_call(w, dpi);
+}
+
+/**
+ * Paints the invalidated part of the window's render cache and copies the part of the cache within the dpi. Returns
+ * false if the window turned out not to be suitable for caching once painted, in which case it has to be drawn
+ * directly.
+ */
+static bool window_draw_from_render_cache(rct_drawpixelinfo* dpi, rct_window* w)
+{
+    auto& cache = w->render_cache;
+    if (cache.Width != w->width || cache.Height != w->height)
+    {
+        cache.Bits.assign((size_t)std::max(0, w->width * w->height), 0);
+        cache.Width = w->width;
+        cache.Height = w->height;
+        cache.Invalidate(0, 0, cache.Width, cache.Height);
+    }
+
+    int32_t dirtyLeft = std::max(cache.DirtyLeft, 0);
+    int32_t dirtyTop = std::max(cache.DirtyTop, 0);
+    int32_t dirtyRight = std::min(cache.DirtyRight, cache.Width);
+    int32_t dirtyBottom = std::min(cache.DirtyBottom, cache.Height);
+    cache.DirtyLeft = cache.DirtyRight = 0;
+    if (dirtyLeft < dirtyRight && dirtyTop < dirtyBottom)
+    {
+        rct_drawpixelinfo cacheDPI = *dpi;
+        cacheDPI.bits = cache.Bits.data() + dirtyLeft + dirtyTop * cache.Width;
+        cacheDPI.x = w->x + dirtyLeft;
+        cacheDPI.y = w->y + dirtyTop;
+        cacheDPI.width = dirtyRight - dirtyLeft;
+        cacheDPI.height = dirtyBottom - dirtyTop;
+        cacheDPI.pitch = cache.Width - cacheDPI.width;
+        window_paint(&cacheDPI, w);
+
+        if (!window_can_use_render_cache(&cacheDPI, w))
+        {
+            w->render_cache = {};
+            return false;
+        }
+    }
+
+    // Copy the part of the window within the dpi
+    int32_t left = std::max<int32_t>(dpi->x, w->x);
+    int32_t top = std::max<int32_t>(dpi->y, w->y);
+    int32_t right = std::min<int32_t>(dpi->x + dpi->width, w->x + cache.Width);
+    int32_t bottom = std::min<int32_t>(dpi->y + dpi->height, w->y + cache.Height);
+    for (int32_t y = top; y < bottom; y++)
+    {
+        const uint8_t* src = cache.Bits.data() + (left - w->x) + (y - w->y) * cache.Width;
+        uint8_t* dst = dpi->bits + (left - dpi->x) + (y - dpi->y) * (dpi->width + dpi->pitch);
+        std::memcpy(dst, src, std::max(0, right - left));
+    }
+    return true;
+}
+
 static void window_draw_single(rct_drawpixelinfo* dpi, rct_window* w, int32_t left, int32_t top, int32_t right, int32_t bottom)
 {
     // Copy dpi so we can crop it
@@ -1231,17 +1365,18 @@ static void window_draw_single(rct_drawpixelinfo* dpi, rct_window* w, int32_t le
             return;
     }
 
-    // Invalidate modifies the window colours so first get the correct
-    // colour before setting the global variables for the string painting
-    window_event_invalidate_call(w);
-
-    // Text colouring
-    gCurrentWindowColours[0] = NOT_TRANSLUCENT(w->colours[0]);
-    gCurrentWindowColours[1] = NOT_TRANSLUCENT(w->colours[1]);
-    gCurrentWindowColours[2] = NOT_TRANSLUCENT(w->colours[2]);
-    gCurrentWindowColours[3] = NOT_TRANSLUCENT(w->colours[3]);
+    if (window_can_use_render_cache(dpi, w))
+    {
+        if (window_draw_from_render_cache(dpi, w))
+            return;
+    }
+    else if (!w->render_cache.Bits.empty())
+    {
+        // Free the cache of a window that has gained a viewport or become translucent
+        w->render_cache = {};
+    }
 
-    window_event_paint_call(w, dpi);
+    window_paint(dpi, w);
 }
 
 /**
@@ -1266,8 +1401,8 @@ void window_move_position(rct_window* w, ScreenCoordsXY deltaCoords)
     if (deltaCoords.x == 0 && deltaCoords.y == 0)
         return;
 
-    // Invalidate old region
-    w->Invalidate();
+    // Invalidate old region, the render cache is relative to the window so it does not need painting again
+    gfx_set_dirty_blocks(w->x, w->y, w->x + w->width, w->y + w->height);
 
     // Translate window and viewport
     w->x += deltaCoords.x;
@@ -1279,7 +1414,7 @@ void window_move_position(rct_window* w, ScreenCoordsXY deltaCoords)
     }
 
     // Invalidate new region
-    w->Invalidate();
+    gfx_set_dirty_blocks(w->x, w->y, w->x + w->width, w->y + w->height);
 }
 
 void window_resize(rct_window* w, int32_t dw, int32_t dh)
@@ -2044,15 +2179,18 @@ void window_draw_all(rct_drawpixelinfo* dpi, int16_t left, int16_t top, int16_t
     windowDPI.pitch = dpi->width + dpi->pitch + left - right;
     windowDPI.zoom_level = 0;
 
-    window_visit_each([&windowDPI, left, top, right, bottom](rct_window* w) {
+    // Painting does not close windows, so the list is walked without a copy, by index in case a window is opened
+    for (size_t i = 0; i < g_window_list.size(); i++)
+    {
+        auto w = g_window_list[i].get();
         if (w->flags & WF_TRANSPARENT)
-            return;
+            continue;
         if (right <= w->x || bottom <= w->y)
-            return;
+            continue;
         if (left >= w->x + w->width || top >= w->y + w->height)
-            return;
+            continue;
         window_draw(&windowDPI, w, left, top, right, bottom);
-    });
+    }
 }
 
 rct_viewport* window_get_previous_viewport(rct_viewport* current)
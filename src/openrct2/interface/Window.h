@@ -16,8 +16,8 @@
 
 #include <functional>
 #include <limits>
-#include <list>
 #include <memory>
+#include <vector>
 
 struct rct_drawpixelinfo;
 struct rct_window;
@@ -622,7 +622,7 @@ extern colour_t gCurrentWindowColours[4];
 
 extern bool gDisableErrorWindowSound;
 
-std::list<std::shared_ptr<rct_window>>::iterator window_get_iterator(const rct_window* w);
+std::vector<std::shared_ptr<rct_window>>::iterator window_get_iterator(const rct_window* w);
 void window_visit_each(std::function<void(rct_window*)> func);
 
 void window_dispatch_update_all();
@@ -652,6 +652,7 @@ rct_widgetindex window_find_widget_from_point(rct_window* w, ScreenCoordsXY scre
 void window_invalidate_by_class(rct_windowclass cls);
 void window_invalidate_by_number(rct_windowclass cls, rct_windownumber number);
 void window_invalidate_all();
+void window_invalidate_all_render_caches();
 void widget_invalidate(rct_window* w, rct_widgetindex widgetIndex);
 void widget_invalidate_by_class(rct_windowclass cls, rct_widgetindex widgetIndex);
 void widget_invalidate_by_number(rct_windowclass cls, rct_windownumber number, rct_widgetindex widgetIndex);
@@ -2,6 +2,8 @@
 
 #include "../world/Sprite.h"
 
+#include <algorithm>
+
 void rct_window::SetLocation(int32_t newX, int32_t newY, int32_t newZ)
 {
     window_scroll_to_location(this, newX, newY, newZ);
@@ -38,5 +40,27 @@ void rct_window::ScrollToViewport()
 
 void rct_window::Invalidate()
 {
+    render_cache.Invalidate(0, 0, width, height);
     gfx_set_dirty_blocks(x, y, x + width, y + height);
 }
+
+void WindowRenderCache::Invalidate(int32_t left, int32_t top, int32_t right, int32_t bottom)
+{
+    if (left >= right || top >= bottom)
+        return;
+
+    if (DirtyLeft >= DirtyRight)
+    {
+        DirtyLeft = left;
+        DirtyTop = top;
+        DirtyRight = right;
+        DirtyBottom = bottom;
+    }
+    else
+    {
+        DirtyLeft = std::min(DirtyLeft, left);
+        DirtyTop = std::min(DirtyTop, top);
+        DirtyRight = std::max(DirtyRight, right);
+        DirtyBottom = std::max(DirtyBottom, bottom);
+    }
+}
@@ -11,12 +11,30 @@
 
 #include "Window.h"
 
-#include <list>
 #include <memory>
+#include <vector>
 
 struct ResearchItem;
 struct rct_object_entry;
 
+/**
+ * The pixels of a window without a viewport, painted off screen so dirty blocks overlapping the window are copied from
+ * it instead of painting the window's widgets again. Only the invalidated part of the window is painted again.
+ */
+struct WindowRenderCache
+{
+    std::vector<uint8_t> Bits;
+    int32_t Width = 0;
+    int32_t Height = 0;
+    // The part that has to be painted again, relative to the window, empty if DirtyLeft >= DirtyRight
+    int32_t DirtyLeft = 0;
+    int32_t DirtyTop = 0;
+    int32_t DirtyRight = 0;
+    int32_t DirtyBottom = 0;
+
+    void Invalidate(int32_t left, int32_t top, int32_t right, int32_t bottom);
+};
+
 /**
  * Window structure
  * size: 0x4C0
@@ -101,6 +119,7 @@ struct rct_window
     uint8_t colours[6];                    // 0x4BA
     uint8_t visibility;                    // VISIBILITY_CACHE
     uint16_t viewport_smart_follow_sprite; // Smart following of sprites. Handles setting viewport target sprite etc
+    WindowRenderCache render_cache;
 
     void SetLocation(int32_t x, int32_t y, int32_t z);
     void ScrollToViewport();
@@ -108,4 +127,4 @@ struct rct_window
 };
 
 // rct2: 0x01420078
-extern std::list<std::shared_ptr<rct_window>> g_window_list;
+extern std::vector<std::shared_ptr<rct_window>> g_window_list;
@@ -11,6 +11,7 @@
 
 #include "../OpenRCT2.h"
 #include "../core/IStream.hpp"
+#include "../core/MemoryMappedFile.h"
 #include "Object.h"
 
 #include <algorithm>
@@ -19,7 +20,7 @@
 
 ImageTable::~ImageTable()
 {
-    if (_data == nullptr)
+    if (_data == nullptr && _mappedDataOwner == nullptr)
     {
         for (auto& entry : _entries)
         {
@@ -49,15 +50,32 @@ void ImageTable::Read(IReadObjectContext* context, IStream* stream)
         }
 
         auto dataSize = (size_t)imageDataSize;
-        auto data = std::make_unique<uint8_t[]>(dataSize);
-        if (data == nullptr)
+
+        // If the data being read outlives the read (i.e. it is mapped from the object cache), reference
+        // the image data in place instead of copying it. It then only gets paged in when it is drawn.
+        auto dataOwner = context->GetDataOwner();
+        auto streamData = static_cast<const uint8_t*>(stream->GetData());
+        bool useMappedData = dataOwner != nullptr && streamData != nullptr
+            && stream->GetLength() - stream->GetPosition() >= headerTableSize + dataSize;
+
+        std::unique_ptr<uint8_t[]> data;
+        uintptr_t imageDataBase;
+        if (useMappedData)
+        {
+            imageDataBase = (uintptr_t)(streamData + stream->GetPosition() + headerTableSize);
+        }
+        else
         {
-            context->LogError(OBJECT_ERROR_BAD_IMAGE_TABLE, "Image table too large.");
-            throw std::runtime_error("Image table too large.");
+            data = std::make_unique<uint8_t[]>(dataSize);
+            if (data == nullptr)
+            {
+                context->LogError(OBJECT_ERROR_BAD_IMAGE_TABLE, "Image table too large.");
+                throw std::runtime_error("Image table too large.");
+            }
+            imageDataBase = (uintptr_t)data.get();
         }
 
         // Read g1 element headers
-        uintptr_t imageDataBase = (uintptr_t)data.get();
         std::vector<rct_g1_element> newEntries;
         for (uint32_t i = 0; i < numImages; i++)
         {
@@ -76,6 +94,17 @@ void ImageTable::Read(IReadObjectContext* context, IStream* stream)
             newEntries.push_back(g1Element);
         }
 
+        if (useMappedData)
+        {
+            stream->Seek(dataSize, STREAM_SEEK_CURRENT);
+
+            _mappedDataOwner = std::move(dataOwner);
+            _mappedData = (const uint8_t*)imageDataBase;
+            _mappedDataSize = dataSize;
+            _entries.insert(_entries.end(), newEntries.begin(), newEntries.end());
+            return;
+        }
+
         // Read g1 element data
         size_t readBytes = (size_t)stream->TryRead(data.get(), dataSize);
 
@@ -97,6 +126,14 @@ void ImageTable::Read(IReadObjectContext* context, IStream* stream)
     }
 }
 
+void ImageTable::Prefetch() const
+{
+    if (_mappedDataOwner != nullptr)
+    {
+        MemoryMappedFile::Prefetch(_mappedData, _mappedDataSize);
+    }
+}
+
 void ImageTable::AddImage(const rct_g1_element* g1)
 {
     rct_g1_element newg1 = *g1;
@@ -24,6 +24,12 @@ private:
     std::unique_ptr<uint8_t[]> _data;
     std::vector<rct_g1_element> _entries;
 
+    // Image data that is referenced in place rather than copied, e.g. from a memory-mapped object cache entry.
+    // The pages are only read in when an image is first drawn.
+    std::shared_ptr<const void> _mappedDataOwner;
+    const uint8_t* _mappedData = nullptr;
+    size_t _mappedDataSize = 0;
+
 public:
     ImageTable() = default;
     ImageTable(const ImageTable&) = delete;
@@ -40,4 +46,10 @@ public:
         return (uint32_t)_entries.size();
     }
     void AddImage(const rct_g1_element* g1);
+
+    /**
+     * Starts reading in the image data of a memory-mapped image table in the background, so that it is
+     * resident by the time the images are drawn.
+     */
+    void Prefetch() const;
 };
@@ -13,6 +13,7 @@
 #include "ImageTable.h"
 #include "StringTable.h"
 
+#include <memory>
 #include <string_view>
 #include <vector>
 
@@ -138,6 +139,7 @@ assert_struct_size(rct_object_filters, 3);
 
 interface IObjectRepository;
 interface IStream;
+class ObjectCache;
 struct ObjectRepositoryItem;
 struct rct_drawpixelinfo;
 struct json_t;
@@ -147,6 +149,9 @@ interface IReadObjectContext
     virtual ~IReadObjectContext() = default;
 
     virtual IObjectRepository& GetObjectRepository() abstract;
+    virtual const ObjectCache* GetObjectCache() abstract;
+    // Keeps the data being read alive after reading, nullptr if the data is only temporary.
+    virtual std::shared_ptr<const void> GetDataOwner() abstract;
     virtual bool ShouldLoadImages() abstract;
     virtual std::vector<uint8_t> GetData(const std::string_view& path) abstract;
 
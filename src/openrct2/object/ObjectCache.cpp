@@ -0,0 +1,193 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2019 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "ObjectCache.h"
+
+#include "../core/File.h"
+#include "../core/FileScanner.h"
+#include "../core/FileStream.hpp"
+#include "../core/MemoryMappedFile.h"
+#include "../core/Path.hpp"
+#include "../core/String.hpp"
+#include "../platform/platform.h"
+#include "Object.h"
+#include "ObjectRepository.h"
+
+#include <atomic>
+#include <cstring>
+
+#pragma pack(push, 1)
+struct ObjectCacheHeader
+{
+    uint32_t MagicNumber;
+    uint16_t Version;
+    rct_object_entry Entry;
+    uint64_t SourceSize;
+    uint64_t SourceLastModified;
+    uint64_t DataSize;
+};
+assert_struct_size(ObjectCacheHeader, 46);
+#pragma pack(pop)
+
+static constexpr uint32_t OBJECT_CACHE_MAGIC_NUMBER = 0x4843424F; // OBCH
+static constexpr uint16_t OBJECT_CACHE_VERSION = 1;
+
+static uint64_t GetSourceSize(const std::string& path)
+{
+    try
+    {
+        auto fs = FileStream(path, FILE_MODE_OPEN);
+        return fs.GetLength();
+    }
+    catch (const std::exception&)
+    {
+        return 0;
+    }
+}
+
+CachedObjectData::CachedObjectData() = default;
+CachedObjectData::CachedObjectData(CachedObjectData&&) noexcept = default;
+CachedObjectData::~CachedObjectData() = default;
+
+ObjectCache::ObjectCache(const std::string& directory)
+    : _directory(directory)
+{
+}
+
+std::unique_ptr<CachedObjectData> ObjectCache::Get(const rct_object_entry& entry, const std::string& sourcePath) const
+{
+    auto path = GetPath(entry);
+    if (!File::Exists(path))
+    {
+        return nullptr;
+    }
+
+    try
+    {
+        auto file = std::make_unique<MemoryMappedFile>(path);
+        if (file->GetLength() < sizeof(ObjectCacheHeader))
+        {
+            return nullptr;
+        }
+
+        ObjectCacheHeader header;
+        std::memcpy(&header, file->GetData(), sizeof(header));
+        if (header.MagicNumber != OBJECT_CACHE_MAGIC_NUMBER || header.Version != OBJECT_CACHE_VERSION
+            || !object_entry_compare(&header.Entry, &entry) || header.SourceSize != GetSourceSize(sourcePath)
+            || header.SourceLastModified != File::GetLastModified(sourcePath)
+            || header.DataSize != file->GetLength() - sizeof(ObjectCacheHeader))
+        {
+            log_verbose("Object cache entry '%s' is out of date", path.c_str());
+            return nullptr;
+        }
+
+        auto result = std::make_unique<CachedObjectData>();
+        result->Data = file->GetData() + sizeof(ObjectCacheHeader);
+        result->Length = (size_t)header.DataSize;
+        result->File = std::move(file);
+        return result;
+    }
+    catch (const std::exception& e)
+    {
+        log_verbose("Unable to read object cache entry '%s': %s", path.c_str(), e.what());
+        return nullptr;
+    }
+}
+
+void ObjectCache::Set(const rct_object_entry& entry, const std::string& sourcePath, const void* data, size_t dataSize) const
+{
+    // Objects can be loaded on several threads at once, so write to a unique temporary
+    // file first and move it into place when it is complete.
+    static std::atomic<uint32_t> tempFileCounter;
+    auto path = GetPath(entry);
+    auto tempPath = String::StdFormat("%s.%u.tmp", path.c_str(), tempFileCounter++);
+    try
+    {
+        platform_ensure_directory_exists(_directory.c_str());
+
+        ObjectCacheHeader header{};
+        header.MagicNumber = OBJECT_CACHE_MAGIC_NUMBER;
+        header.Version = OBJECT_CACHE_VERSION;
+        header.Entry = entry;
+        header.SourceSize = GetSourceSize(sourcePath);
+        header.SourceLastModified = File::GetLastModified(sourcePath);
+        header.DataSize = dataSize;
+        {
+            auto fs = FileStream(tempPath, FILE_MODE_WRITE);
+            fs.WriteValue(header);
+            fs.Write(data, dataSize);
+        }
+        if (!File::Move(tempPath, path))
+        {
+            // Some platforms will not move over an existing (out of date) entry
+            File::Delete(path);
+            if (!File::Move(tempPath, path))
+            {
+                File::Delete(tempPath);
+            }
+        }
+    }
+    catch (const std::exception& e)
+    {
+        log_warning("Unable to write object cache entry '%s': %s", path.c_str(), e.what());
+        File::Delete(tempPath);
+    }
+}
+
+void ObjectCache::Prune(const IObjectRepository& repository) const
+{
+    if (!Path::DirectoryExists(_directory))
+    {
+        return;
+    }
+
+    size_t numPruned = 0;
+    auto scanner = std::unique_ptr<IFileScanner>(Path::ScanDirectory(Path::Combine(_directory, "*.dat"), false));
+    while (scanner->Next())
+    {
+        std::string path = scanner->GetPath();
+        bool isStale = true;
+        try
+        {
+            auto fs = FileStream(path, FILE_MODE_OPEN);
+            auto header = fs.ReadValue<ObjectCacheHeader>();
+            if (header.MagicNumber == OBJECT_CACHE_MAGIC_NUMBER && header.Version == OBJECT_CACHE_VERSION)
+            {
+                auto ori = repository.FindObject(&header.Entry);
+                isStale = ori == nullptr || header.SourceSize != GetSourceSize(ori->Path)
+                    || header.SourceLastModified != File::GetLastModified(ori->Path);
+            }
+        }
+        catch (const std::exception&)
+        {
+        }
+
+        if (isStale && File::Delete(path))
+        {
+            numPruned++;
+        }
+    }
+    if (numPruned != 0)
+    {
+        log_verbose("Pruned %zu out of date object cache entries", numPruned);
+    }
+}
+
+std::string ObjectCache::GetPath(const rct_object_entry& entry) const
+{
+    // Object names can contain characters that are not valid in file names, so encode the whole entry
+    std::string fileName;
+    auto bytes = reinterpret_cast<const uint8_t*>(&entry);
+    for (size_t i = 0; i < sizeof(rct_object_entry); i++)
+    {
+        fileName += String::StdFormat("%02X", bytes[i]);
+    }
+    fileName += ".dat";
+    return Path::Combine(_directory, fileName);
+}
@@ -0,0 +1,71 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2019 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "../common.h"
+
+#include <memory>
+#include <string>
+
+interface IObjectRepository;
+class MemoryMappedFile;
+struct rct_object_entry;
+
+/**
+ * Decoded object data that has been mapped from the object cache.
+ */
+struct CachedObjectData
+{
+    std::unique_ptr<MemoryMappedFile> File;
+    const uint8_t* Data{};
+    size_t Length{};
+
+    CachedObjectData();
+    CachedObjectData(CachedObjectData&&) noexcept;
+    ~CachedObjectData();
+};
+
+/**
+ * An on-disk cache of decoded legacy (.DAT) object data, keyed by object entry (flags, name and checksum).
+ * Each object is stored in its own file, so it can be memory-mapped and read without running the
+ * sawyer decoding again. An entry is only valid while the size and modification time of the source
+ * object file match the ones recorded when it was written.
+ *
+ * Only the decoded chunk is cached. Each object still reads its properties, string table and image
+ * headers from the chunk every time it is loaded, and JSON and .parkobj objects are still parsed.
+ */
+class ObjectCache final
+{
+private:
+    std::string _directory;
+
+public:
+    explicit ObjectCache(const std::string& directory);
+
+    /**
+     * Gets the decoded data for the given object, or nullptr if the object is not cached or
+     * the cached data is out of date.
+     */
+    std::unique_ptr<CachedObjectData> Get(const rct_object_entry& entry, const std::string& sourcePath) const;
+
+    /**
+     * Stores the decoded data for the given object. Failures are logged and otherwise ignored.
+     */
+    void Set(const rct_object_entry& entry, const std::string& sourcePath, const void* data, size_t dataSize) const;
+
+    /**
+     * Deletes the entries of objects that are no longer in the repository or whose source file has changed since
+     * they were written.
+     */
+    void Prune(const IObjectRepository& repository) const;
+
+private:
+    std::string GetPath(const rct_object_entry& entry) const;
+};
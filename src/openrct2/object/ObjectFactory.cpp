@@ -26,6 +26,7 @@
 #include "FootpathObject.h"
 #include "LargeSceneryObject.h"
 #include "Object.h"
+#include "ObjectCache.h"
 #include "ObjectLimits.h"
 #include "ObjectList.h"
 #include "RideObject.h"
@@ -86,6 +87,8 @@ class ReadObjectContext : public IReadObjectContext
 private:
     IObjectRepository& _objectRepository;
     const IFileDataRetriever* _fileDataRetriever;
+    const ObjectCache* _objectCache;
+    std::shared_ptr<const void> _dataOwner;
 
     std::string _objectName;
     bool _loadImages;
@@ -105,9 +108,10 @@ public:
 
     ReadObjectContext(
         IObjectRepository& objectRepository, const std::string& objectName, bool loadImages,
-        const IFileDataRetriever* fileDataRetriever)
+        const IFileDataRetriever* fileDataRetriever, const ObjectCache* objectCache = nullptr)
         : _objectRepository(objectRepository)
         , _fileDataRetriever(fileDataRetriever)
+        , _objectCache(objectCache)
         , _objectName(objectName)
         , _loadImages(loadImages)
     {
@@ -118,6 +122,21 @@ public:
         return _objectRepository;
     }
 
+    const ObjectCache* GetObjectCache() override
+    {
+        return _objectCache;
+    }
+
+    std::shared_ptr<const void> GetDataOwner() override
+    {
+        return _dataOwner;
+    }
+
+    void SetDataOwner(std::shared_ptr<const void> dataOwner)
+    {
+        _dataOwner = std::move(dataOwner);
+    }
+
     bool ShouldLoadImages() override
     {
         return _loadImages;
@@ -156,7 +175,8 @@ public:
 namespace ObjectFactory
 {
     static Object* CreateObjectFromJson(
-        IObjectRepository& objectRepository, const json_t* jRoot, const IFileDataRetriever* fileRetriever);
+        IObjectRepository& objectRepository, const json_t* jRoot, const IFileDataRetriever* fileRetriever,
+        const ObjectCache* objectCache);
 
     static uint8_t ParseSourceGame(const std::string& s)
     {
@@ -191,7 +211,8 @@ namespace ObjectFactory
         }
     }
 
-    Object* CreateObjectFromLegacyFile(IObjectRepository& objectRepository, const utf8* path)
+    Object* CreateObjectFromLegacyFile(
+        IObjectRepository& objectRepository, const utf8* path, const ObjectCache* objectCache)
     {
         log_verbose("CreateObjectFromLegacyFile(..., \"%s\")", path);
 
@@ -211,11 +232,32 @@ namespace ObjectFactory
                 object_entry_get_name_fixed(objectName, sizeof(objectName), &entry);
                 log_verbose("  entry: { 0x%08X, \"%s\", 0x%08X }", entry.flags, objectName, entry.checksum);
 
-                auto chunk = chunkReader.ReadChunk();
-                log_verbose("  size: %zu", chunk->GetLength());
+                // Use the already decoded chunk from the object cache if it is still valid
+                std::shared_ptr<CachedObjectData> cachedData;
+                std::shared_ptr<SawyerChunk> chunk;
+                if (objectCache != nullptr)
+                {
+                    cachedData = objectCache->Get(entry, path);
+                }
+                if (cachedData == nullptr)
+                {
+                    chunk = chunkReader.ReadChunk();
+                    if (objectCache != nullptr)
+                    {
+                        // Read the object from the entry that was just written, so its images are mapped like
+                        // those of every other cached object instead of being copied
+                        objectCache->Set(entry, path, chunk->GetData(), chunk->GetLength());
+                        cachedData = objectCache->Get(entry, path);
+                    }
+                }
+
+                auto chunkStream = cachedData != nullptr ? MemoryStream(cachedData->Data, cachedData->Length)
+                                                         : MemoryStream(chunk->GetData(), chunk->GetLength());
+                log_verbose("  size: %zu", (size_t)chunkStream.GetLength());
 
-                auto chunkStream = MemoryStream(chunk->GetData(), chunk->GetLength());
-                auto readContext = ReadObjectContext(objectRepository, objectName, !gOpenRCT2NoGraphics, nullptr);
+                auto readContext = ReadObjectContext(
+                    objectRepository, objectName, !gOpenRCT2NoGraphics, nullptr, objectCache);
+                readContext.SetDataOwner(cachedData);
                 ReadObjectLegacy(result, &readContext, &chunkStream);
                 if (readContext.WasError())
                 {
@@ -347,7 +389,8 @@ namespace ObjectFactory
         return 0xFF;
     }
 
-    Object* CreateObjectFromZipFile(IObjectRepository& objectRepository, const std::string_view& path)
+    Object* CreateObjectFromZipFile(
+        IObjectRepository& objectRepository, const std::string_view& path, const ObjectCache* objectCache)
     {
         Object* result = nullptr;
         try
@@ -367,7 +410,7 @@ namespace ObjectFactory
             }
 
             auto fileDataRetriever = ZipDataRetriever(*archive);
-            Object* obj = CreateObjectFromJson(objectRepository, jRoot, &fileDataRetriever);
+            Object* obj = CreateObjectFromJson(objectRepository, jRoot, &fileDataRetriever, objectCache);
             json_decref(jRoot);
             return obj;
         }
@@ -381,7 +424,8 @@ namespace ObjectFactory
         return result;
     }
 
-    Object* CreateObjectFromJsonFile(IObjectRepository& objectRepository, const std::string& path)
+    Object* CreateObjectFromJsonFile(
+        IObjectRepository& objectRepository, const std::string& path, const ObjectCache* objectCache)
     {
         log_verbose("CreateObjectFromJsonFile(\"%s\")", path.c_str());
 
@@ -390,7 +434,7 @@ namespace ObjectFactory
         {
             auto jRoot = Json::ReadFromFile(path.c_str());
             auto fileDataRetriever = FileSystemDataRetriever(Path::GetDirectory(path));
-            result = CreateObjectFromJson(objectRepository, jRoot, &fileDataRetriever);
+            result = CreateObjectFromJson(objectRepository, jRoot, &fileDataRetriever, objectCache);
             json_decref(jRoot);
         }
         catch (const std::runtime_error& err)
@@ -404,7 +448,8 @@ namespace ObjectFactory
     }
 
     Object* CreateObjectFromJson(
-        IObjectRepository& objectRepository, const json_t* jRoot, const IFileDataRetriever* fileRetriever)
+        IObjectRepository& objectRepository, const json_t* jRoot, const IFileDataRetriever* fileRetriever,
+        const ObjectCache* objectCache)
     {
         log_verbose("CreateObjectFromJson(...)");
 
@@ -430,7 +475,8 @@ namespace ObjectFactory
                 std::memcpy(entry.name, originalName.c_str(), minLength);
 
                 result = CreateObject(entry);
-                auto readContext = ReadObjectContext(objectRepository, id, !gOpenRCT2NoGraphics, fileRetriever);
+                auto readContext = ReadObjectContext(
+                    objectRepository, id, !gOpenRCT2NoGraphics, fileRetriever, objectCache);
                 result->ReadJson(&readContext, jRoot);
                 if (readContext.WasError())
                 {
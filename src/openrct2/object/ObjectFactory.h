@@ -15,15 +15,19 @@
 
 interface IObjectRepository;
 class Object;
+class ObjectCache;
 struct rct_object_entry;
 
 namespace ObjectFactory
 {
-    Object* CreateObjectFromLegacyFile(IObjectRepository& objectRepository, const utf8* path);
+    Object* CreateObjectFromLegacyFile(
+        IObjectRepository& objectRepository, const utf8* path, const ObjectCache* objectCache = nullptr);
     Object* CreateObjectFromLegacyData(
         IObjectRepository& objectRepository, const rct_object_entry* entry, const void* data, size_t dataSize);
-    Object* CreateObjectFromZipFile(IObjectRepository& objectRepository, const std::string_view& path);
+    Object* CreateObjectFromZipFile(
+        IObjectRepository& objectRepository, const std::string_view& path, const ObjectCache* objectCache = nullptr);
     Object* CreateObject(const rct_object_entry& entry);
 
-    Object* CreateObjectFromJsonFile(IObjectRepository& objectRepository, const std::string& path);
+    Object* CreateObjectFromJsonFile(
+        IObjectRepository& objectRepository, const std::string& path, const ObjectCache* objectCache = nullptr);
 } // namespace ObjectFactory
@@ -32,6 +32,7 @@
 #include "../util/SawyerCoding.h"
 #include "../util/Util.h"
 #include "Object.h"
+#include "ObjectCache.h"
 #include "ObjectFactory.h"
 #include "ObjectList.h"
 #include "ObjectManager.h"
@@ -212,6 +213,7 @@ class ObjectRepository final : public IObjectRepository
 {
     std::shared_ptr<IPlatformEnvironment> const _env;
     ObjectFileIndex const _fileIndex;
+    ObjectCache const _objectCache;
     std::vector<ObjectRepositoryItem> _items;
     ObjectEntryMap _itemMap;
 
@@ -219,6 +221,7 @@ public:
     explicit ObjectRepository(const std::shared_ptr<IPlatformEnvironment>& env)
         : _env(env)
         , _fileIndex(*this, *env)
+        , _objectCache(env->GetFilePath(PATHID::CACHE_OBJECT_DATA))
     {
     }
 
@@ -233,6 +236,7 @@ public:
         auto items = _fileIndex.LoadOrBuild(language);
         AddItems(items);
         SortItems();
+        _objectCache.Prune(*this);
     }
 
     void Construct(int32_t language) override
@@ -240,6 +244,7 @@ public:
         auto items = _fileIndex.Rebuild(language);
         AddItems(items);
         SortItems();
+        _objectCache.Prune(*this);
     }
 
     size_t GetNumObjects() const override
@@ -284,15 +289,15 @@ public:
         auto extension = Path::GetExtension(ori->Path);
         if (String::Equals(extension, ".json", true))
         {
-            return ObjectFactory::CreateObjectFromJsonFile(*this, ori->Path);
+            return ObjectFactory::CreateObjectFromJsonFile(*this, ori->Path, &_objectCache);
         }
         else if (String::Equals(extension, ".parkobj", true))
         {
-            return ObjectFactory::CreateObjectFromZipFile(*this, ori->Path);
+            return ObjectFactory::CreateObjectFromZipFile(*this, ori->Path, &_objectCache);
         }
         else
         {
-            return ObjectFactory::CreateObjectFromLegacyFile(*this, ori->Path.c_str());
+            return ObjectFactory::CreateObjectFromLegacyFile(*this, ori->Path.c_str(), &_objectCache);
         }
     }
 
@@ -0,0 +1,537 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2019 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "FootpathGraph.h"
+
+#include "../Context.h"
+#include "../ReplayManager.h"
+#include "../config/Config.h"
+#include "../network/network.h"
+#include "../ride/Ride.h"
+#include "../util/Util.h"
+#include "../world/Entrance.h"
+#include "../world/Footpath.h"
+#include "../world/Map.h"
+#include "../world/TileElementStorage.h"
+#include "Peep.h"
+
+#include <algorithm>
+#include <deque>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * A path element guests can walk on. Only the properties that decide where guests can walk are stored, so that a
+ * rebuilt graph can be compared with the previous one.
+ */
+struct FootpathGraphNode
+{
+    uint8_t X;
+    uint8_t Y;
+    uint8_t Z;
+    // The edges guests may leave the path by, i.e. without a 'no entry' sign
+    uint8_t Edges;
+    // INVALID_DIRECTION if the path is flat
+    Direction SlopeDirection;
+    // The ride of a queue that guests heading for another ride will not walk through, otherwise RIDE_ID_NULL
+    ride_id_t QueueRideIndex;
+
+    bool operator==(const FootpathGraphNode& other) const
+    {
+        return X == other.X && Y == other.Y && Z == other.Z && Edges == other.Edges && SlopeDirection == other.SlopeDirection
+            && QueueRideIndex == other.QueueRideIndex;
+    }
+};
+
+// The nodes of each tile are stored together, _tileNodeStart[i] is the first node of tile i
+static std::vector<FootpathGraphNode> _nodes;
+static std::vector<uint32_t> _tileNodeStart;
+// The entrances and tracks guests can walk into from a path, packed with their height and direction
+static std::vector<uint32_t> _destinations;
+static std::vector<uint32_t> _tileDestinationStart;
+static bool _graphIsValid;
+
+// The tiles that have changed since the graph was built, which are read again before the graph is next used
+static std::vector<uint32_t> _dirtyTiles;
+static std::vector<bool> _tileIsDirty;
+// Past this many changed tiles, e.g. after a large map edit, the whole graph is built again instead
+static constexpr size_t MAX_DIRTY_TILES = 4096;
+
+// Distance fields (in tiles, per node) keyed by goal and queue ride
+static std::unordered_map<uint64_t, std::vector<uint16_t>> _distanceFields;
+static constexpr size_t MAX_DISTANCE_FIELDS = 256;
+
+bool footpath_graph_is_enabled()
+{
+    if (!gConfigGeneral.footpath_graph_pathfinding || network_get_mode() != NETWORK_MODE_NONE)
+        return false;
+
+    // Replays have to play back the same way whatever the config of whoever watches them
+    auto context = OpenRCT2::GetContext();
+    auto replayManager = context != nullptr ? context->GetReplayManager() : nullptr;
+    return replayManager == nullptr || (!replayManager->IsRecording() && !replayManager->IsReplaying());
+}
+
+static size_t footpath_graph_tile_index(int32_t x, int32_t y)
+{
+    return y * MAXIMUM_MAP_SIZE_TECHNICAL + x;
+}
+
+static bool footpath_graph_is_on_map(int32_t x, int32_t y)
+{
+    return x >= 0 && y >= 0 && x < MAXIMUM_MAP_SIZE_TECHNICAL && y < MAXIMUM_MAP_SIZE_TECHNICAL;
+}
+
+static void footpath_graph_clear_dirty_tiles()
+{
+    for (auto tile : _dirtyTiles)
+    {
+        _tileIsDirty[tile] = false;
+    }
+    _dirtyTiles.clear();
+}
+
+void footpath_graph_invalidate()
+{
+    _graphIsValid = false;
+    footpath_graph_clear_dirty_tiles();
+}
+
+void footpath_graph_invalidate_tile(const TileCoordsXY& loc)
+{
+    // There is nothing to update until the graph has been built
+    if (!_graphIsValid || !footpath_graph_is_on_map(loc.x, loc.y))
+        return;
+
+    size_t tile = footpath_graph_tile_index(loc.x, loc.y);
+    if (_tileIsDirty[tile])
+        return;
+
+    if (_dirtyTiles.size() >= MAX_DIRTY_TILES)
+    {
+        footpath_graph_invalidate();
+        return;
+    }
+    _tileIsDirty[tile] = true;
+    _dirtyTiles.push_back((uint32_t)tile);
+}
+
+void footpath_graph_invalidate_element(const TileElement* tileElement)
+{
+    if (!_graphIsValid)
+        return;
+
+    // Elements that are not on the map, e.g. those used to draw construction previews, can be ignored
+    TileCoordsXY loc;
+    if (tile_element_storage_get_tile(tileElement, &loc))
+    {
+        footpath_graph_invalidate_tile(loc);
+    }
+}
+
+void footpath_graph_reset()
+{
+    _nodes = {};
+    _tileNodeStart = {};
+    _destinations = {};
+    _tileDestinationStart = {};
+    _dirtyTiles = {};
+    _tileIsDirty = {};
+    _distanceFields = {};
+    _graphIsValid = false;
+}
+
+/**
+ * Appends the paths of the tile, and the entrances and tracks guests can walk into from them.
+ */
+static void footpath_graph_read_tile(
+    int32_t x, int32_t y, std::vector<FootpathGraphNode>& nodes, std::vector<uint32_t>& destinations)
+{
+    TileElement* tileElement = map_get_first_element_at(TileCoordsXY{ x, y }.ToCoordsXY());
+    if (tileElement == nullptr)
+        return;
+    do
+    {
+        if (tileElement->IsGhost())
+            continue;
+        if (tileElement->GetType() == TILE_ELEMENT_TYPE_ENTRANCE || tileElement->GetType() == TILE_ELEMENT_TYPE_TRACK)
+        {
+            destinations.push_back((tileElement->base_height << 8) | tileElement->GetType() | tileElement->GetDirection());
+            continue;
+        }
+        if (tileElement->GetType() != TILE_ELEMENT_TYPE_PATH)
+            continue;
+
+        auto pathElement = tileElement->AsPath();
+        FootpathGraphNode node;
+        node.X = (uint8_t)x;
+        node.Y = (uint8_t)y;
+        node.Z = tileElement->base_height;
+        node.Edges = path_get_permitted_edges(false, pathElement);
+        node.SlopeDirection = pathElement->IsSloped() ? pathElement->GetSlopeDirection() : INVALID_DIRECTION;
+        node.QueueRideIndex = RIDE_ID_NULL;
+        if (pathElement->IsQueue() && bitcount(pathElement->GetEdges()) == 2)
+        {
+            node.QueueRideIndex = pathElement->GetRideIndex();
+        }
+        nodes.push_back(node);
+    } while (!(tileElement++)->IsLastForTile());
+}
+
+static void footpath_graph_build()
+{
+    std::vector<FootpathGraphNode> nodes;
+    std::vector<uint32_t> tileNodeStart;
+    std::vector<uint32_t> destinations;
+    std::vector<uint32_t> tileDestinationStart;
+    nodes.reserve(_nodes.size());
+    tileNodeStart.reserve(MAX_TILE_TILE_ELEMENT_POINTERS + 1);
+    destinations.reserve(_destinations.size());
+    tileDestinationStart.reserve(MAX_TILE_TILE_ELEMENT_POINTERS + 1);
+
+    for (int32_t y = 0; y < MAXIMUM_MAP_SIZE_TECHNICAL; y++)
+    {
+        for (int32_t x = 0; x < MAXIMUM_MAP_SIZE_TECHNICAL; x++)
+        {
+            tileNodeStart.push_back((uint32_t)nodes.size());
+            tileDestinationStart.push_back((uint32_t)destinations.size());
+            footpath_graph_read_tile(x, y, nodes, destinations);
+        }
+    }
+    tileNodeStart.push_back((uint32_t)nodes.size());
+    tileDestinationStart.push_back((uint32_t)destinations.size());
+
+    // Map edits that do not change where guests can walk (e.g. ghosts or scenery) keep the distance fields
+    if (nodes != _nodes || tileNodeStart != _tileNodeStart || destinations != _destinations
+        || tileDestinationStart != _tileDestinationStart)
+    {
+        _nodes = std::move(nodes);
+        _tileNodeStart = std::move(tileNodeStart);
+        _destinations = std::move(destinations);
+        _tileDestinationStart = std::move(tileDestinationStart);
+        _distanceFields.clear();
+    }
+    _tileIsDirty.assign(MAX_TILE_TILE_ELEMENT_POINTERS, false);
+    _dirtyTiles.clear();
+    _graphIsValid = true;
+}
+
+/**
+ * Replaces the items of one tile in a list where the items of each tile are stored together, returns false if the
+ * items are the same.
+ */
+template<typename T>
+static bool footpath_graph_replace_tile_items(
+    std::vector<T>& items, std::vector<uint32_t>& tileStart, size_t tile, const std::vector<T>& newItems)
+{
+    auto begin = items.begin() + tileStart[tile];
+    auto end = items.begin() + tileStart[tile + 1];
+    if (std::equal(begin, end, newItems.begin(), newItems.end()))
+        return false;
+
+    int32_t delta = (int32_t)newItems.size() - (int32_t)(end - begin);
+    items.insert(items.erase(begin, end), newItems.begin(), newItems.end());
+    if (delta != 0)
+    {
+        for (size_t i = tile + 1; i < tileStart.size(); i++)
+        {
+            tileStart[i] += delta;
+        }
+    }
+    return true;
+}
+
+/**
+ * Reads the tiles that have changed again. The distance fields are only discarded if where guests can walk changed.
+ */
+static void footpath_graph_update_dirty_tiles()
+{
+    std::vector<FootpathGraphNode> nodes;
+    std::vector<uint32_t> destinations;
+    bool changed = false;
+    for (auto tile : _dirtyTiles)
+    {
+        nodes.clear();
+        destinations.clear();
+        footpath_graph_read_tile(tile % MAXIMUM_MAP_SIZE_TECHNICAL, tile / MAXIMUM_MAP_SIZE_TECHNICAL, nodes, destinations);
+        changed |= footpath_graph_replace_tile_items(_nodes, _tileNodeStart, tile, nodes);
+        changed |= footpath_graph_replace_tile_items(_destinations, _tileDestinationStart, tile, destinations);
+    }
+    footpath_graph_clear_dirty_tiles();
+
+    if (changed)
+    {
+        _distanceFields.clear();
+    }
+}
+
+static void footpath_graph_update()
+{
+    if (!_graphIsValid)
+    {
+        footpath_graph_build();
+    }
+    else if (!_dirtyTiles.empty())
+    {
+        footpath_graph_update_dirty_tiles();
+    }
+}
+
+/**
+ * The height at which a guest leaves the path by the given edge, i.e. raised by a step if walking up a slope.
+ */
+static int32_t footpath_graph_get_exit_z(const FootpathGraphNode& node, Direction direction)
+{
+    return node.SlopeDirection == direction ? node.Z + 2 : node.Z;
+}
+
+/**
+ * Whether a guest walking in the given direction at height z can walk onto the path, like
+ * is_valid_path_z_and_direction.
+ */
+static bool footpath_graph_can_enter(const FootpathGraphNode& node, int32_t z, Direction direction)
+{
+    if (node.SlopeDirection == INVALID_DIRECTION || node.SlopeDirection == direction)
+        return z == node.Z;
+    return direction_reverse(node.SlopeDirection) == direction && z == node.Z + 2;
+}
+
+/**
+ * Whether a guest heading for queueRideIndex can walk through the path on the way to somewhere else.
+ */
+static bool footpath_graph_can_pass(const FootpathGraphNode& node, ride_id_t queueRideIndex)
+{
+    return node.QueueRideIndex == RIDE_ID_NULL || node.QueueRideIndex == queueRideIndex;
+}
+
+static uint64_t footpath_graph_get_field_key(const TileCoordsXYZ& goal, ride_id_t queueRideIndex)
+{
+    return ((uint64_t)(uint16_t)goal.x << 40) | ((uint64_t)(uint16_t)goal.y << 24) | ((uint64_t)(uint16_t)goal.z << 8)
+        | queueRideIndex;
+}
+
+/**
+ * Whether a guest leaving a path in the given direction at height z reaches a goal that is not a path, i.e. a ride
+ * entrance or exit facing the path, a park entrance or a shop.
+ */
+static bool footpath_graph_is_goal_reached(const TileCoordsXYZ& goal, int32_t z, Direction direction)
+{
+    if (z != goal.z)
+        return false;
+
+    TileElement* tileElement = map_get_first_element_at(goal.ToCoordsXY());
+    if (tileElement == nullptr)
+        return false;
+    do
+    {
+        if (tileElement->IsGhost() || tileElement->base_height != goal.z)
+            continue;
+
+        switch (tileElement->GetType())
+        {
+            case TILE_ELEMENT_TYPE_TRACK:
+            {
+                auto ride = get_ride(tileElement->AsTrack()->GetRideIndex());
+                if (ride != nullptr && ride_type_has_flag(ride->type, RIDE_TYPE_FLAG_IS_SHOP))
+                    return true;
+                break;
+            }
+            case TILE_ELEMENT_TYPE_ENTRANCE:
+                switch (tileElement->AsEntrance()->GetEntranceType())
+                {
+                    case ENTRANCE_TYPE_RIDE_ENTRANCE:
+                    case ENTRANCE_TYPE_RIDE_EXIT:
+                        if (tileElement->GetDirection() == direction)
+                            return true;
+                        break;
+                    case ENTRANCE_TYPE_PARK_ENTRANCE:
+                        return true;
+                }
+                break;
+        }
+    } while (!(tileElement++)->IsLastForTile());
+    return false;
+}
+
+/**
+ * Computes the distance from every path to the goal with a breadth first search backwards from the goal.
+ */
+static std::vector<uint16_t> footpath_graph_compute_distances(const TileCoordsXYZ& goal, ride_id_t queueRideIndex)
+{
+    std::vector<uint16_t> distances(_nodes.size(), FOOTPATH_GRAPH_UNREACHABLE);
+    std::deque<uint32_t> queue;
+
+    if (!footpath_graph_is_on_map(goal.x, goal.y))
+        return distances;
+
+    // The goal is either a path itself or next to the paths leading to it
+    bool goalIsPath = false;
+    size_t goalTile = footpath_graph_tile_index(goal.x, goal.y);
+    for (uint32_t i = _tileNodeStart[goalTile]; i < _tileNodeStart[goalTile + 1]; i++)
+    {
+        if (_nodes[i].Z == goal.z)
+        {
+            distances[i] = 0;
+            queue.push_back(i);
+            goalIsPath = true;
+        }
+    }
+    if (!goalIsPath)
+    {
+        for (Direction direction : ALL_DIRECTIONS)
+        {
+            int32_t x = goal.x - TileDirectionDelta[direction].x;
+            int32_t y = goal.y - TileDirectionDelta[direction].y;
+            if (!footpath_graph_is_on_map(x, y))
+                continue;
+
+            size_t tile = footpath_graph_tile_index(x, y);
+            for (uint32_t i = _tileNodeStart[tile]; i < _tileNodeStart[tile + 1]; i++)
+            {
+                const auto& node = _nodes[i];
+                if (distances[i] == FOOTPATH_GRAPH_UNREACHABLE && (node.Edges & (1 << direction))
+                    && footpath_graph_is_goal_reached(goal, footpath_graph_get_exit_z(node, direction), direction))
+                {
+                    distances[i] = 1;
+                    queue.push_back(i);
+                }
+            }
+        }
+    }
+
+    while (!queue.empty())
+    {
+        uint32_t current = queue.front();
+        queue.pop_front();
+
+        const auto& node = _nodes[current];
+        uint16_t distance = distances[current] + 1;
+        if (distance == FOOTPATH_GRAPH_UNREACHABLE)
+            continue;
+
+        // Find the paths that lead onto this one
+        for (Direction direction : ALL_DIRECTIONS)
+        {
+            int32_t x = node.X - TileDirectionDelta[direction].x;
+            int32_t y = node.Y - TileDirectionDelta[direction].y;
+            if (!footpath_graph_is_on_map(x, y))
+                continue;
+
+            size_t tile = footpath_graph_tile_index(x, y);
+            for (uint32_t i = _tileNodeStart[tile]; i < _tileNodeStart[tile + 1]; i++)
+            {
+                const auto& previous = _nodes[i];
+                if (distances[i] != FOOTPATH_GRAPH_UNREACHABLE || !(previous.Edges & (1 << direction))
+                    || !footpath_graph_can_pass(previous, queueRideIndex)
+                    || !footpath_graph_can_enter(node, footpath_graph_get_exit_z(previous, direction), direction))
+                {
+                    continue;
+                }
+                distances[i] = distance;
+                queue.push_back(i);
+            }
+        }
+    }
+    return distances;
+}
+
+static const std::vector<uint16_t>& footpath_graph_get_distances(const TileCoordsXYZ& goal, ride_id_t queueRideIndex)
+{
+    auto key = footpath_graph_get_field_key(goal, queueRideIndex);
+    auto it = _distanceFields.find(key);
+    if (it == _distanceFields.end())
+    {
+        if (_distanceFields.size() >= MAX_DISTANCE_FIELDS)
+        {
+            _distanceFields.clear();
+        }
+        it = _distanceFields.emplace(key, footpath_graph_compute_distances(goal, queueRideIndex)).first;
+    }
+    return it->second;
+}
+
+static int32_t footpath_graph_find_node(const TileCoordsXYZ& loc)
+{
+    if (!footpath_graph_is_on_map(loc.x, loc.y))
+        return -1;
+
+    size_t tile = footpath_graph_tile_index(loc.x, loc.y);
+    for (uint32_t i = _tileNodeStart[tile]; i < _tileNodeStart[tile + 1]; i++)
+    {
+        if (_nodes[i].Z == loc.z)
+            return (int32_t)i;
+    }
+    return -1;
+}
+
+/**
+ * Gets the distance to the goal after leaving the path in the given direction.
+ */
+static uint16_t footpath_graph_get_distance_in_direction(
+    const std::vector<uint16_t>& distances, const FootpathGraphNode& node, const TileCoordsXYZ& goal, Direction direction)
+{
+    int32_t x = node.X + TileDirectionDelta[direction].x;
+    int32_t y = node.Y + TileDirectionDelta[direction].y;
+    if (!footpath_graph_is_on_map(x, y))
+        return FOOTPATH_GRAPH_UNREACHABLE;
+
+    int32_t z = footpath_graph_get_exit_z(node, direction);
+    if (x == goal.x && y == goal.y && footpath_graph_is_goal_reached(goal, z, direction))
+        return 0;
+
+    uint16_t best = FOOTPATH_GRAPH_UNREACHABLE;
+    size_t tile = footpath_graph_tile_index(x, y);
+    for (uint32_t i = _tileNodeStart[tile]; i < _tileNodeStart[tile + 1]; i++)
+    {
+        if (footpath_graph_can_enter(_nodes[i], z, direction) && distances[i] < best)
+        {
+            best = distances[i];
+        }
+    }
+    return best;
+}
+
+uint16_t footpath_graph_get_distance(const TileCoordsXYZ& loc, const TileCoordsXYZ& goal, ride_id_t queueRideIndex)
+{
+    footpath_graph_update();
+
+    int32_t node = footpath_graph_find_node(loc);
+    if (node == -1)
+        return FOOTPATH_GRAPH_UNREACHABLE;
+    return footpath_graph_get_distances(goal, queueRideIndex)[node];
+}
+
+Direction footpath_graph_choose_direction(
+    const TileCoordsXYZ& loc, const TileCoordsXYZ& goal, ride_id_t queueRideIndex, uint8_t edges)
+{
+    footpath_graph_update();
+
+    int32_t nodeIndex = footpath_graph_find_node(loc);
+    if (nodeIndex == -1)
+        return INVALID_DIRECTION;
+
+    const auto& distances = footpath_graph_get_distances(goal, queueRideIndex);
+    const auto& node = _nodes[nodeIndex];
+
+    Direction chosenDirection = INVALID_DIRECTION;
+    uint16_t chosenDistance = FOOTPATH_GRAPH_UNREACHABLE;
+    for (Direction direction : ALL_DIRECTIONS)
+    {
+        if (!(edges & (1 << direction)))
+            continue;
+
+        uint16_t distance = footpath_graph_get_distance_in_direction(distances, node, goal, direction);
+        if (distance < chosenDistance)
+        {
+            chosenDirection = direction;
+            chosenDistance = distance;
+        }
+    }
+    return chosenDirection;
+}
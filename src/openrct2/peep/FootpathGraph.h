@@ -0,0 +1,58 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2019 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "../common.h"
+#include "../ride/RideTypes.h"
+#include "../world/Location.hpp"
+
+struct TileElement;
+
+constexpr const uint16_t FOOTPATH_GRAPH_UNREACHABLE = 0xFFFF;
+
+/**
+ * Whether guests should choose their direction using the footpath graph instead of the heuristic search. The graph
+ * gives different (shortest path) results to the original game, so it is never used in network games or replays.
+ */
+bool footpath_graph_is_enabled();
+
+/**
+ * Marks the whole footpath graph as out of date. It is rebuilt the next time it is used, and the distance fields are
+ * discarded if the rebuilt graph differs.
+ */
+void footpath_graph_invalidate();
+
+/**
+ * Marks the paths on one tile as out of date. Only that tile is read again the next time the graph is used.
+ */
+void footpath_graph_invalidate_tile(const TileCoordsXY& loc);
+
+/**
+ * Marks the tile the element is on as out of date.
+ */
+void footpath_graph_invalidate_element(const TileElement* tileElement);
+
+/**
+ * Frees the footpath graph and all distance fields, for when a different map is loaded.
+ */
+void footpath_graph_reset();
+
+/**
+ * Gets the number of tiles a guest has to walk from the path at loc to reach goal without walking through the queues of
+ * rides other than queueRideIndex, or FOOTPATH_GRAPH_UNREACHABLE.
+ */
+uint16_t footpath_graph_get_distance(const TileCoordsXYZ& loc, const TileCoordsXYZ& goal, ride_id_t queueRideIndex);
+
+/**
+ * Chooses which of the given edges of the path at loc takes a guest to goal the quickest, or returns
+ * INVALID_DIRECTION if the goal can not be reached using any of them.
+ */
+Direction footpath_graph_choose_direction(
+    const TileCoordsXYZ& loc, const TileCoordsXYZ& goal, ride_id_t queueRideIndex, uint8_t edges);
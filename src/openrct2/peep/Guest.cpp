@@ -10,6 +10,7 @@
 #include "../Context.h"
 #include "../Game.h"
 #include "../OpenRCT2.h"
+#include "../ReplayManager.h"
 #include "../audio/audio.h"
 #include "../config/Config.h"
 #include "../core/Guard.hpp"
@@ -30,16 +31,21 @@
 #include "../world/Climate.h"
 #include "../world/Footpath.h"
 #include "../world/LargeScenery.h"
+#include "../world/LitterIndex.h"
 #include "../world/Map.h"
+#include "../world/MapAreaSummary.h"
 #include "../world/Park.h"
 #include "../world/Scenery.h"
 #include "../world/Sprite.h"
 #include "../world/Surface.h"
+#include "GuestSummary.h"
 #include "Peep.h"
 #include "Staff.h"
 
 #include <algorithm>
 #include <iterator>
+#include <limits>
+#include <vector>
 
 // Locations of the spiral slide platform that a peep walks from the entrance of the ride to the
 // entrance of the slide. Up to 4 waypoints for each 4 sides that an ride entrance can be located
@@ -397,6 +403,7 @@ static void peep_decide_whether_to_leave_park(Peep* peep);
 static void peep_leave_park(Peep* peep);
 static void peep_head_for_nearest_ride_type(Guest* peep, int32_t rideType);
 static void peep_head_for_nearest_ride_with_flags(Guest* peep, int32_t rideTypeFlags);
+static void guest_pick_ride_to_go_on_within_budget(Guest* guest);
 bool loc_690FD0(Peep* peep, uint8_t* rideToView, uint8_t* rideSeatToView, TileElement* tileElement);
 
 bool Guest::GuestHasValidXY() const
@@ -630,6 +637,7 @@ void Guest::HandleEasterEggName()
     {
         peep_flags |= PEEP_FLAGS_LEAVING_PARK;
         peep_flags &= ~PEEP_FLAGS_PARK_ENTRANCE_CHOSEN;
+        guest_summary_invalidate_guest(this);
     }
 
     peep_flags &= ~PEEP_FLAGS_PURPLE;
@@ -824,7 +832,7 @@ void Guest::Tick128UpdateGuest(int32_t index)
 
         if ((scenario_rand() & 0xFFFF) <= ((item_standard_flags & PEEP_ITEM_MAP) ? 8192U : 2184U))
         {
-            PickRideToGoOn();
+            guest_pick_ride_to_go_on_within_budget(this);
         }
 
         if ((uint32_t)(index & 0x3FF) == (gCurrentTicks & 0x3FF))
@@ -1432,6 +1440,7 @@ void Guest::CheckCantFindRide()
         return;
 
     guest_heading_to_ride_id = RIDE_ID_NULL;
+    guest_summary_invalidate_guest(this);
     rct_window* w = window_find_by_number(WC_PEEP, sprite_index);
 
     if (w)
@@ -1804,6 +1813,7 @@ void Guest::OnExitRide(ride_id_t rideIndex)
         peep_is_lost_countdown = 200;
         peep_reset_pathfind_goal(this);
         window_invalidate_flags |= PEEP_INVALIDATE_PEEP_ACTION;
+        guest_summary_invalidate_guest(this);
     }
 
     if (peep_should_preferred_intensity_increase(this))
@@ -1867,6 +1877,7 @@ void Guest::PickRideToGoOn()
         peep_is_lost_countdown = 200;
         peep_reset_pathfind_goal(this);
         window_invalidate_flags |= PEEP_INVALIDATE_PEEP_ACTION;
+        guest_summary_invalidate_guest(this);
 
         // Make peep look at their map if they have one
         if (item_standard_flags & PEEP_ITEM_MAP)
@@ -1876,6 +1887,92 @@ void Guest::PickRideToGoOn()
     }
 }
 
+static GuestRideChoiceStats _rideChoiceStats;
+// The number of guests marked with PEEP_FLAGS_RIDE_CHOICE_PENDING. It can be too high (e.g. after a waiting guest has
+// left the park) until the guests are counted again, but never too low.
+static uint32_t _numPendingRideChoices = std::numeric_limits<uint32_t>::max();
+
+/**
+ * Gets how many guests may look for a ride to go on, because they felt like it, each tick. Any more have to wait for
+ * a later tick. The budget changes the game, so it is not used in network games or replays.
+ */
+static uint32_t guest_ride_choices_get_budget()
+{
+    if (network_get_mode() != NETWORK_MODE_NONE || gConfigGeneral.guest_ride_choices_per_tick <= 0)
+        return 0;
+
+    auto context = OpenRCT2::GetContext();
+    auto replayManager = context != nullptr ? context->GetReplayManager() : nullptr;
+    if (replayManager != nullptr && (replayManager->IsRecording() || replayManager->IsReplaying()))
+        return 0;
+    return gConfigGeneral.guest_ride_choices_per_tick;
+}
+
+void guest_ride_choices_invalidate()
+{
+    _numPendingRideChoices = std::numeric_limits<uint32_t>::max();
+}
+
+/**
+ * Lets the guests that had to wait in earlier ticks look for a ride to go on, as far as the budget allows, or all of
+ * them when there is no budget (any more). Waiting guests are marked with PEEP_FLAGS_RIDE_CHOICE_PENDING, so they are
+ * saved with the park and go in sprite list order.
+ */
+void guest_ride_choices_begin_tick()
+{
+    _rideChoiceStats = {};
+    if (_numPendingRideChoices == 0)
+        return;
+
+    auto budget = guest_ride_choices_get_budget();
+    uint16_t spriteIndex;
+    Peep* peep;
+    FOR_ALL_GUESTS (spriteIndex, peep)
+    {
+        if (peep->peep_flags & PEEP_FLAGS_RIDE_CHOICE_PENDING)
+        {
+            if (budget == 0 || _rideChoiceStats.Made < budget)
+            {
+                peep->peep_flags &= ~PEEP_FLAGS_RIDE_CHOICE_PENDING;
+                _rideChoiceStats.Made++;
+                // Does nothing if the guest no longer wants to find a ride, e.g. because they have started leaving
+                peep->AsGuest()->PickRideToGoOn();
+            }
+            else
+            {
+                _rideChoiceStats.Pending++;
+            }
+        }
+    }
+    _numPendingRideChoices = _rideChoiceStats.Pending;
+}
+
+GuestRideChoiceStats guest_ride_choices_get_stats()
+{
+    return _rideChoiceStats;
+}
+
+static void guest_pick_ride_to_go_on_within_budget(Guest* guest)
+{
+    auto budget = guest_ride_choices_get_budget();
+    if (budget != 0 && _rideChoiceStats.Made >= budget)
+    {
+        if (!(guest->peep_flags & PEEP_FLAGS_RIDE_CHOICE_PENDING))
+        {
+            guest->peep_flags |= PEEP_FLAGS_RIDE_CHOICE_PENDING;
+            _rideChoiceStats.Deferred++;
+            _rideChoiceStats.Pending++;
+            if (_numPendingRideChoices != std::numeric_limits<uint32_t>::max())
+                _numPendingRideChoices++;
+        }
+        return;
+    }
+
+    guest->peep_flags &= ~PEEP_FLAGS_RIDE_CHOICE_PENDING;
+    _rideChoiceStats.Made++;
+    guest->PickRideToGoOn();
+}
+
 Ride* Guest::FindBestRideToGoOn()
 {
     // Pick the most exciting ride
@@ -1921,30 +2018,10 @@ std::bitset<MAX_RIDES> Guest::FindRidesToGoOn()
     else
     {
         // Take nearby rides into consideration
-        constexpr auto radius = 10 * 32;
-        int32_t cx = floor2(x, 32);
-        int32_t cy = floor2(y, 32);
-        for (int32_t tileX = cx - radius; tileX <= cx + radius; tileX += COORDS_XY_STEP)
-        {
-            for (int32_t tileY = cy - radius; tileY <= cy + radius; tileY += COORDS_XY_STEP)
-            {
-                if (map_is_location_valid({ tileX, tileY }))
-                {
-                    auto tileElement = map_get_first_element_at({ tileX, tileY });
-                    if (tileElement != nullptr)
-                    {
-                        do
-                        {
-                            if (tileElement->GetType() == TILE_ELEMENT_TYPE_TRACK)
-                            {
-                                auto rideIndex = tileElement->AsTrack()->GetRideIndex();
-                                rideConsideration[rideIndex] = true;
-                            }
-                        } while (!(tileElement++)->IsLastForTile());
-                    }
-                }
-            }
-        }
+        constexpr auto radius = 10;
+        auto centre = TileCoordsXY{ CoordsXY{ floor2(x, 32), floor2(y, 32) } };
+        map_area_summary_get_rides(
+            { centre.x - radius, centre.y - radius }, { centre.x + radius, centre.y + radius }, rideConsideration);
 
         // Always take the tall rides into consideration (realistic as you can usually see them from anywhere in the park)
         for (auto& ride : GetRideManager())
@@ -2438,6 +2515,7 @@ static void peep_reset_ride_heading(Peep* peep)
 {
     peep->guest_heading_to_ride_id = RIDE_ID_NULL;
     peep->window_invalidate_flags |= PEEP_INVALIDATE_PEEP_ACTION;
+    guest_summary_invalidate_guest(peep);
 }
 
 static void peep_ride_is_too_intense(Guest* peep, Ride* ride, bool peepAtRide)
@@ -2926,6 +3004,24 @@ static bool peep_really_liked_ride(Peep* peep, Ride* ride)
     return true;
 }
 
+/**
+ * Gets the tiles peep_assess_surroundings looks at along one axis, the 10 tiles around the centre. Near the low edge of
+ * the map the scan starts at 0 but still ends 160 units past the centre, which can take in one more tile.
+ */
+static void peep_assess_surroundings_get_range(int32_t centre, int32_t* outMin, int32_t* outMax)
+{
+    if (centre < 160)
+    {
+        *outMin = 0;
+        *outMax = (centre + 159) / 32;
+    }
+    else
+    {
+        *outMin = centre / 32 - 5;
+        *outMax = centre / 32 + 4;
+    }
+}
+
 /**
  *
  *  rct2: 0x0069BC9A
@@ -2935,102 +3031,44 @@ static PeepThoughtType peep_assess_surroundings(int16_t centre_x, int16_t centre
     if ((tile_element_height({ centre_x, centre_y })) > centre_z)
         return PEEP_THOUGHT_TYPE_NONE;
 
-    uint16_t num_scenery = 0;
-    uint16_t num_fountains = 0;
-    uint16_t nearby_music = 0;
-    uint16_t num_rubbish = 0;
-
-    int16_t initial_x = std::max(centre_x - 160, 0);
-    int16_t initial_y = std::max(centre_y - 160, 0);
-    int16_t final_x = std::min(centre_x + 160, MAXIMUM_MAP_SIZE_BIG);
-    int16_t final_y = std::min(centre_y + 160, MAXIMUM_MAP_SIZE_BIG);
-
-    for (int16_t x = initial_x; x < final_x; x += COORDS_XY_STEP)
-    {
-        for (int16_t y = initial_y; y < final_y; y += COORDS_XY_STEP)
-        {
-            TileElement* tileElement = map_get_first_element_at({ x, y });
-            if (tileElement == nullptr)
-                continue;
-            do
-            {
-                Ride* ride;
-                rct_scenery_entry* scenery;
-
-                switch (tileElement->GetType())
-                {
-                    case TILE_ELEMENT_TYPE_PATH:
-                        if (!tileElement->AsPath()->HasAddition())
-                            break;
-
-                        scenery = tileElement->AsPath()->GetAdditionEntry();
-                        if (scenery == nullptr)
-                        {
-                            return PEEP_THOUGHT_TYPE_NONE;
-                        }
-                        if (tileElement->AsPath()->AdditionIsGhost())
-                            break;
+    TileCoordsXY areaMin;
+    TileCoordsXY areaMax;
+    peep_assess_surroundings_get_range(centre_x, &areaMin.x, &areaMax.x);
+    peep_assess_surroundings_get_range(centre_y, &areaMin.y, &areaMax.y);
 
-                        if (scenery->path_bit.flags
-                            & (PATH_BIT_FLAG_JUMPING_FOUNTAIN_WATER | PATH_BIT_FLAG_JUMPING_FOUNTAIN_SNOW))
-                        {
-                            num_fountains++;
-                            break;
-                        }
-                        if (tileElement->AsPath()->IsBroken())
-                        {
-                            num_rubbish++;
-                        }
-                        break;
-                    case TILE_ELEMENT_TYPE_LARGE_SCENERY:
-                    case TILE_ELEMENT_TYPE_SMALL_SCENERY:
-                        num_scenery++;
-                        break;
-                    case TILE_ELEMENT_TYPE_TRACK:
-                        ride = get_ride(tileElement->AsTrack()->GetRideIndex());
-                        if (ride != nullptr)
-                        {
-                            if (ride->lifecycle_flags & RIDE_LIFECYCLE_MUSIC && ride->status != RIDE_STATUS_CLOSED
-                                && !(ride->lifecycle_flags & (RIDE_LIFECYCLE_BROKEN_DOWN | RIDE_LIFECYCLE_CRASHED)))
-                            {
-                                if (ride->type == RIDE_TYPE_MERRY_GO_ROUND)
-                                {
-                                    nearby_music |= 1;
-                                    break;
-                                }
-
-                                if (ride->music == MUSIC_STYLE_ORGAN)
-                                {
-                                    nearby_music |= 1;
-                                    break;
-                                }
+    auto summary = map_area_summary_get(areaMin, areaMax);
+    if (summary.NumInvalidPathAdditions != 0)
+        return PEEP_THOUGHT_TYPE_NONE;
 
-                                if (ride->type == RIDE_TYPE_DODGEMS)
-                                {
-                                    // Dodgems drown out music?
-                                    nearby_music |= 2;
-                                }
-                            }
-                        }
-                        break;
-                }
-            } while (!(tileElement++)->IsLastForTile());
-        }
-    }
+    uint32_t num_scenery = summary.NumScenery;
+    uint32_t num_fountains = summary.NumFountains;
+    uint16_t nearby_music = 0;
+    uint32_t num_rubbish = summary.NumBrokenPathAdditions;
 
-    Litter* litter;
-    for (uint16_t sprite_idx = gSpriteListHead[SPRITE_LIST_LITTER]; sprite_idx != SPRITE_INDEX_NULL; sprite_idx = litter->next)
+    std::bitset<MAX_RIDES> nearbyRides;
+    map_area_summary_get_rides(areaMin, areaMax, nearbyRides);
+    for (auto& ride : GetRideManager())
     {
-        litter = &(get_sprite(sprite_idx)->litter);
+        if (ride.id >= nearbyRides.size() || !nearbyRides[ride.id])
+            continue;
 
-        int16_t dist_x = abs(litter->x - centre_x);
-        int16_t dist_y = abs(litter->y - centre_y);
-        if (std::max(dist_x, dist_y) <= 160)
+        if (ride.lifecycle_flags & RIDE_LIFECYCLE_MUSIC && ride.status != RIDE_STATUS_CLOSED
+            && !(ride.lifecycle_flags & (RIDE_LIFECYCLE_BROKEN_DOWN | RIDE_LIFECYCLE_CRASHED)))
         {
-            num_rubbish++;
+            if (ride.type == RIDE_TYPE_MERRY_GO_ROUND || ride.music == MUSIC_STYLE_ORGAN)
+            {
+                nearby_music |= 1;
+            }
+            else if (ride.type == RIDE_TYPE_DODGEMS)
+            {
+                // Dodgems drown out music?
+                nearby_music |= 2;
+            }
         }
     }
 
+    num_rubbish += litter_index_count_in_area({ centre_x, centre_y }, 160);
+
     if (num_fountains >= 5 && num_rubbish < 20)
         return PEEP_THOUGHT_TYPE_FOUNTAINS;
 
@@ -3123,6 +3161,7 @@ static void peep_decide_whether_to_leave_park(Peep* peep)
 static void peep_leave_park(Peep* peep)
 {
     peep->guest_heading_to_ride_id = RIDE_ID_NULL;
+    guest_summary_invalidate_guest(peep);
     if (peep->peep_flags & PEEP_FLAGS_LEAVING_PARK)
     {
         if (peep->peep_is_lost_countdown < 60)
@@ -3251,6 +3290,7 @@ template<typename T> static void peep_head_for_nearest_ride(Guest* peep, bool co
         peep->peep_is_lost_countdown = 200;
         peep_reset_pathfind_goal(peep);
         peep->window_invalidate_flags |= PEEP_INVALIDATE_PEEP_ACTION;
+        guest_summary_invalidate_guest(peep);
         peep->time_lost = 0;
     }
 }
@@ -3319,6 +3359,7 @@ void Guest::StopPurchaseThought(uint8_t ride_type)
         thoughts[PEEP_MAX_THOUGHTS - 1].type = PEEP_THOUGHT_TYPE_NONE;
 
         window_invalidate_flags |= PEEP_INVALIDATE_PEEP_THOUGHTS;
+        guest_summary_invalidate_guest(this);
         i--;
     }
 }
@@ -5737,6 +5778,7 @@ void Guest::UpdateLeavingPark()
     outside_of_park = 1;
     destination_tolerance = 5;
     decrement_guests_in_park();
+    guest_summary_invalidate_guest(this);
     auto intent = Intent(INTENT_ACTION_UPDATE_GUEST_COUNT);
     context_broadcast_intent(&intent);
     var_37 = 1;
@@ -7,36 +7,27 @@
  * OpenRCT2 is licensed under the GNU General Public License version 3.
  *****************************************************************************/
 
+#include "../config/Config.h"
 #include "../core/Guard.hpp"
+#include "../core/JobPool.hpp"
 #include "../ride/Station.h"
 #include "../ride/Track.h"
 #include "../scenario/Scenario.h"
 #include "../util/Util.h"
 #include "../world/Entrance.h"
 #include "../world/Footpath.h"
+#include "FootpathGraph.h"
 #include "Peep.h"
 #include "Staff.h"
 
+#include <algorithm>
 #include <cstring>
-
-static bool _peepPathFindIsStaff;
-static int8_t _peepPathFindNumJunctions;
-static int8_t _peepPathFindMaxJunctions;
-static int32_t _peepPathFindTilesChecked;
-static uint8_t _peepPathFindFewestNumSteps;
+#include <iterator>
+#include <memory>
+#include <vector>
 
 static int32_t guest_surface_path_finding(Peep* peep);
 
-/* A junction history for the peep pathfinding heuristic search
- * The magic number 16 is the largest value returned by
- * peep_pathfind_get_max_number_junctions() which should eventually
- * be declared properly. */
-static struct
-{
-    TileCoordsXYZ location;
-    Direction direction;
-} _peepPathFindHistory[16];
-
 enum
 {
     PATH_SEARCH_DEAD_END,
@@ -79,9 +70,9 @@ static TileElement* get_banner_on_path(TileElement* path_element)
     return nullptr;
 }
 
-static int32_t banner_clear_path_edges(PathElement* pathElement, int32_t edges)
+static int32_t banner_clear_path_edges(bool ignoreBanners, PathElement* pathElement, int32_t edges)
 {
-    if (_peepPathFindIsStaff)
+    if (ignoreBanners)
         return edges;
     TileElement* bannerElement = get_banner_on_path(reinterpret_cast<TileElement*>(pathElement));
     if (bannerElement != nullptr)
@@ -95,11 +86,11 @@ static int32_t banner_clear_path_edges(PathElement* pathElement, int32_t edges)
 }
 
 /**
- * Gets the connected edges of a path that are permitted (i.e. no 'no entry' signs)
+ * Gets the connected edges of a path that are permitted (i.e. no 'no entry' signs unless staff, who ignore them)
  */
-static int32_t path_get_permitted_edges(PathElement* pathElement)
+int32_t path_get_permitted_edges(bool isStaff, PathElement* pathElement)
 {
-    return banner_clear_path_edges(pathElement, pathElement->GetEdgesAndCorners()) & 0x0F;
+    return banner_clear_path_edges(isStaff, pathElement, pathElement->GetEdgesAndCorners()) & 0x0F;
 }
 
 /**
@@ -343,7 +334,7 @@ static uint8_t footpath_element_dest_in_dir(
                 if (tileElement->AsPath()->IsWide())
                     return PATH_SEARCH_WIDE;
 
-                uint8_t edges = path_get_permitted_edges(tileElement->AsPath());
+                uint8_t edges = path_get_permitted_edges(false, tileElement->AsPath());
                 edges &= ~(1 << direction_reverse(chosenDirection));
                 loc.z = tileElement->base_height;
 
@@ -567,22 +558,27 @@ static int32_t CalculateHeuristicPathingScore(TileCoordsXYZ loc1, TileCoordsXYZ
  *
  * The parameters/variables that limit the search space are:
  *   - counter (param) - number of steps walked in the current search path;
- *   - _peepPathFindTilesChecked (variable) - cumulative number of tiles that can be
+ *   - context.TilesChecked (variable) - cumulative number of tiles that can be
  *     checked in the entire search;
- *   - _peepPathFindNumJunctions (variable) - number of thin junctions that can be
+ *   - context.NumJunctions (variable) - number of thin junctions that can be
  *     checked in a single search path;
  *
- * Other global variables/state that affect the search space are:
+ * Other state (held in the context) that affects the search space is:
  *   - Wide paths - to handle broad paths (> 1 tile wide), the search navigates
  *     along non-wide (or 'thin' paths) and stops as soon as it encounters a
  *     wide path. This means peeps heading for a destination will only leave
  *     thin paths if walking 1 tile onto a wide path is closer than following
  *     non-wide paths;
- *   - gPeepPathFindIgnoreForeignQueues
- *   - gPeepPathFindQueueRideIndex - the ride the peep is heading for
- *   - _peepPathFindHistory - the search path telemetry consisting of the
+ *   - context.IgnoreForeignQueues
+ *   - context.QueueRideIndex - the ride the peep is heading for
+ *   - context.History - the search path telemetry consisting of the
  *     starting point and all thin junctions with directions navigated
- *     in the current search path - also used to detect path loops.
+ *     in the current search path - also used to detect path loops;
+ *   - context.PeepPathfindHistory - the junctions the peep remembers
+ *     walking through while heading for the goal.
+ *
+ * The search only reads the map and the peep, so searches with different
+ * contexts can be run concurrently.
  *
  * The score is only updated when:
  *   - the goal is reached;
@@ -598,9 +594,9 @@ static int32_t CalculateHeuristicPathingScore(TileCoordsXYZ loc1, TileCoordsXYZ
  *  rct2: 0x0069A997
  */
 static void peep_pathfind_heuristic_search(
-    TileCoordsXYZ loc, Peep* peep, TileElement* currentTileElement, bool inPatrolArea, uint8_t counter, uint16_t* endScore,
-    Direction test_edge, uint8_t* endJunctions, TileCoordsXYZ junctionList[16], uint8_t directionList[16],
-    TileCoordsXYZ* endXYZ, uint8_t* endSteps)
+    PathfindContext& context, TileCoordsXYZ loc, Peep* peep, TileElement* currentTileElement, bool inPatrolArea,
+    uint8_t counter, uint16_t* endScore, Direction test_edge, uint8_t* endJunctions, TileCoordsXYZ junctionList[16],
+    uint8_t directionList[16], TileCoordsXYZ* endXYZ, uint8_t* endSteps)
 {
     uint8_t searchResult = PATH_SEARCH_FAILED;
 
@@ -611,13 +607,13 @@ static void peep_pathfind_heuristic_search(
     loc += TileDirectionDelta[test_edge];
 
     ++counter;
-    _peepPathFindTilesChecked--;
+    context.TilesChecked--;
 
     /* If this is where the search started this is a search loop and the
      * current search path ends here.
      * Return without updating the parameters (best result so far). */
-    if ((_peepPathFindHistory[0].location.x == (uint8_t)loc.x) && (_peepPathFindHistory[0].location.y == (uint8_t)loc.y)
-        && (_peepPathFindHistory[0].location.z == loc.z))
+    if ((context.History[0].location.x == (uint8_t)loc.x) && (context.History[0].location.y == (uint8_t)loc.y)
+        && (context.History[0].location.z == loc.z))
     {
 #if defined(DEBUG_LEVEL_2) && DEBUG_LEVEL_2
         if (gPathFindDebug)
@@ -763,9 +759,9 @@ static void peep_pathfind_heuristic_search(
                 else
                 { // numEdges == 2
                     if (tileElement->AsPath()->IsQueue()
-                        && tileElement->AsPath()->GetRideIndex() != gPeepPathFindQueueRideIndex)
+                        && tileElement->AsPath()->GetRideIndex() != context.QueueRideIndex)
                     {
-                        if (gPeepPathFindIgnoreForeignQueues && (tileElement->AsPath()->GetRideIndex() != 0xFF))
+                        if (context.IgnoreForeignQueues && (tileElement->AsPath()->GetRideIndex() != 0xFF))
                         {
                             // Path is a queue we aren't interested in
                             /* The rideIndex will be useful for
@@ -800,7 +796,7 @@ static void peep_pathfind_heuristic_search(
          * Ignore for now. */
 
         // Calculate the heuristic score of this map element.
-        uint16_t new_score = CalculateHeuristicPathingScore(loc, gPeepPathFindGoalPosition);
+        uint16_t new_score = CalculateHeuristicPathingScore(loc, context.GoalPosition);
 
         /* If this map element is the search goal the current search path ends here. */
         if (new_score == 0)
@@ -815,14 +811,14 @@ static void peep_pathfind_heuristic_search(
                 // Update the end x,y,z
                 *endXYZ = loc;
                 // Update the telemetry
-                *endJunctions = _peepPathFindMaxJunctions - _peepPathFindNumJunctions;
+                *endJunctions = context.MaxJunctions - context.NumJunctions;
                 for (uint8_t junctInd = 0; junctInd < *endJunctions; junctInd++)
                 {
-                    uint8_t histIdx = _peepPathFindMaxJunctions - junctInd;
-                    junctionList[junctInd].x = _peepPathFindHistory[histIdx].location.x;
-                    junctionList[junctInd].y = _peepPathFindHistory[histIdx].location.y;
-                    junctionList[junctInd].z = _peepPathFindHistory[histIdx].location.z;
-                    directionList[junctInd] = _peepPathFindHistory[histIdx].direction;
+                    uint8_t histIdx = context.MaxJunctions - junctInd;
+                    junctionList[junctInd].x = context.History[histIdx].location.x;
+                    junctionList[junctInd].y = context.History[histIdx].location.y;
+                    junctionList[junctInd].z = context.History[histIdx].location.z;
+                    directionList[junctInd] = context.History[histIdx].direction;
                 }
             }
 #if defined(DEBUG_LEVEL_2) && DEBUG_LEVEL_2
@@ -873,14 +869,14 @@ static void peep_pathfind_heuristic_search(
                 // Update the end x,y,z
                 *endXYZ = loc;
                 // Update the telemetry
-                *endJunctions = _peepPathFindMaxJunctions - _peepPathFindNumJunctions;
+                *endJunctions = context.MaxJunctions - context.NumJunctions;
                 for (uint8_t junctInd = 0; junctInd < *endJunctions; junctInd++)
                 {
-                    uint8_t histIdx = _peepPathFindMaxJunctions - junctInd;
-                    junctionList[junctInd].x = _peepPathFindHistory[histIdx].location.x;
-                    junctionList[junctInd].y = _peepPathFindHistory[histIdx].location.y;
-                    junctionList[junctInd].z = _peepPathFindHistory[histIdx].location.z;
-                    directionList[junctInd] = _peepPathFindHistory[histIdx].direction;
+                    uint8_t histIdx = context.MaxJunctions - junctInd;
+                    junctionList[junctInd].x = context.History[histIdx].location.x;
+                    junctionList[junctInd].y = context.History[histIdx].location.y;
+                    junctionList[junctInd].z = context.History[histIdx].location.z;
+                    directionList[junctInd] = context.History[histIdx].direction;
                 }
             }
 #if defined(DEBUG_LEVEL_2) && DEBUG_LEVEL_2
@@ -896,7 +892,7 @@ static void peep_pathfind_heuristic_search(
 
         /* Get all the permitted_edges of the map element. */
         Guard::Assert(tileElement->AsPath() != nullptr);
-        uint8_t edges = path_get_permitted_edges(tileElement->AsPath());
+        uint8_t edges = path_get_permitted_edges(context.IsStaff, tileElement->AsPath());
 
 #if defined(DEBUG_LEVEL_2) && DEBUG_LEVEL_2
         if (gPathFindDebug)
@@ -927,7 +923,7 @@ static void peep_pathfind_heuristic_search(
 
         /* Check if either of the search limits has been reached:
          * - max number of steps or max tiles checked. */
-        if (counter >= 200 || _peepPathFindTilesChecked <= 0)
+        if (counter >= 200 || context.TilesChecked <= 0)
         {
             /* The current search ends here.
              * The path continues, so the goal could still be reachable from here.
@@ -941,14 +937,14 @@ static void peep_pathfind_heuristic_search(
                 // Update the end x,y,z
                 *endXYZ = loc;
                 // Update the telemetry
-                *endJunctions = _peepPathFindMaxJunctions - _peepPathFindNumJunctions;
+                *endJunctions = context.MaxJunctions - context.NumJunctions;
                 for (uint8_t junctInd = 0; junctInd < *endJunctions; junctInd++)
                 {
-                    uint8_t histIdx = _peepPathFindMaxJunctions - junctInd;
-                    junctionList[junctInd].x = _peepPathFindHistory[histIdx].location.x;
-                    junctionList[junctInd].y = _peepPathFindHistory[histIdx].location.y;
-                    junctionList[junctInd].z = _peepPathFindHistory[histIdx].location.z;
-                    directionList[junctInd] = _peepPathFindHistory[histIdx].direction;
+                    uint8_t histIdx = context.MaxJunctions - junctInd;
+                    junctionList[junctInd].x = context.History[histIdx].location.x;
+                    junctionList[junctInd].y = context.History[histIdx].location.y;
+                    junctionList[junctInd].z = context.History[histIdx].location.z;
+                    directionList[junctInd] = context.History[histIdx].direction;
                 }
             }
 #if defined(DEBUG_LEVEL_2) && DEBUG_LEVEL_2
@@ -980,12 +976,13 @@ static void peep_pathfind_heuristic_search(
                  * Path finding loop detection can take advantage of both the
                  * peep->pathfind_history - loops through remembered junctions
                  *     the peep has already passed through getting to its
-                 *     current position while on the way to its current goal;
-                 * _peepPathFindHistory - loops in the current search path. */
+                 *     current position while on the way to its current goal
+                 *     (searched in context.PeepPathfindHistory);
+                 * context.History - loops in the current search path. */
                 bool pathLoop = false;
                 /* Check the peep->pathfind_history to see if this junction has
                  * already been visited by the peep while heading for this goal. */
-                for (auto& pathfindHistory : peep->pathfind_history)
+                for (const auto& pathfindHistory : context.PeepPathfindHistory)
                 {
                     if (pathfindHistory.x == loc.x && pathfindHistory.y == loc.y && pathfindHistory.z == loc.z)
                     {
@@ -1008,15 +1005,15 @@ static void peep_pathfind_heuristic_search(
 
                 if (!pathLoop)
                 {
-                    /* Check the _peepPathFindHistory to see if this junction has been
+                    /* Check the context.History to see if this junction has been
                      * previously passed through in the current search path.
                      * i.e. this is a loop in the current search path. */
-                    for (int32_t junctionNum = _peepPathFindNumJunctions + 1; junctionNum <= _peepPathFindMaxJunctions;
+                    for (int32_t junctionNum = context.NumJunctions + 1; junctionNum <= context.MaxJunctions;
                          junctionNum++)
                     {
-                        if ((_peepPathFindHistory[junctionNum].location.x == (uint8_t)loc.x)
-                            && (_peepPathFindHistory[junctionNum].location.y == (uint8_t)loc.y)
-                            && (_peepPathFindHistory[junctionNum].location.z == loc.z))
+                        if ((context.History[junctionNum].location.x == (uint8_t)loc.x)
+                            && (context.History[junctionNum].location.y == (uint8_t)loc.y)
+                            && (context.History[junctionNum].location.z == loc.z))
                         {
                             pathLoop = true;
                             break;
@@ -1041,7 +1038,7 @@ static void peep_pathfind_heuristic_search(
                  * be reachable from here.
                  * If the search result is better than the best so far (in the parameters),
                  * then update the parameters with this search before continuing to the next map element. */
-                if (_peepPathFindNumJunctions <= 0)
+                if (context.NumJunctions <= 0)
                 {
                     if (new_score < *endScore || (new_score == *endScore && counter < *endSteps))
                     {
@@ -1051,14 +1048,14 @@ static void peep_pathfind_heuristic_search(
                         // Update the end x,y,z
                         *endXYZ = loc;
                         // Update the telemetry
-                        *endJunctions = _peepPathFindMaxJunctions; // - _peepPathFindNumJunctions;
+                        *endJunctions = context.MaxJunctions; // - context.NumJunctions;
                         for (uint8_t junctInd = 0; junctInd < *endJunctions; junctInd++)
                         {
-                            uint8_t histIdx = _peepPathFindMaxJunctions - junctInd;
-                            junctionList[junctInd].x = _peepPathFindHistory[histIdx].location.x;
-                            junctionList[junctInd].y = _peepPathFindHistory[histIdx].location.y;
-                            junctionList[junctInd].z = _peepPathFindHistory[histIdx].location.z;
-                            directionList[junctInd] = _peepPathFindHistory[histIdx].direction;
+                            uint8_t histIdx = context.MaxJunctions - junctInd;
+                            junctionList[junctInd].x = context.History[histIdx].location.x;
+                            junctionList[junctInd].y = context.History[histIdx].location.y;
+                            junctionList[junctInd].z = context.History[histIdx].location.z;
+                            directionList[junctInd] = context.History[histIdx].direction;
                         }
                     }
 #if defined(DEBUG_LEVEL_2) && DEBUG_LEVEL_2
@@ -1074,12 +1071,12 @@ static void peep_pathfind_heuristic_search(
 
                 /* This junction was NOT previously visited in the current
                  * search path, so add the junction to the history. */
-                _peepPathFindHistory[_peepPathFindNumJunctions].location.x = (uint8_t)loc.x;
-                _peepPathFindHistory[_peepPathFindNumJunctions].location.y = (uint8_t)loc.y;
-                _peepPathFindHistory[_peepPathFindNumJunctions].location.z = loc.z;
+                context.History[context.NumJunctions].location.x = (uint8_t)loc.x;
+                context.History[context.NumJunctions].location.y = (uint8_t)loc.y;
+                context.History[context.NumJunctions].location.z = loc.z;
                 // .direction take is added below.
 
-                _peepPathFindNumJunctions--;
+                context.NumJunctions--;
             }
         }
 
@@ -1088,7 +1085,7 @@ static void peep_pathfind_heuristic_search(
         do
         {
             edges &= ~(1 << next_test_edge);
-            uint8_t savedNumJunctions = _peepPathFindNumJunctions;
+            uint8_t savedNumJunctions = context.NumJunctions;
 
             uint8_t height = loc.z;
             if (tileElement->AsPath()->IsSloped() && tileElement->AsPath()->GetSlopeDirection() == next_test_edge)
@@ -1117,13 +1114,13 @@ static void peep_pathfind_heuristic_search(
             if (thin_junction)
             {
                 /* Add the current test_edge to the history. */
-                _peepPathFindHistory[_peepPathFindNumJunctions + 1].direction = next_test_edge;
+                context.History[context.NumJunctions + 1].direction = next_test_edge;
             }
 
             peep_pathfind_heuristic_search(
-                { loc.x, loc.y, height }, peep, tileElement, nextInPatrolArea, counter, endScore, next_test_edge, endJunctions,
-                junctionList, directionList, endXYZ, endSteps);
-            _peepPathFindNumJunctions = savedNumJunctions;
+                context, { loc.x, loc.y, height }, peep, tileElement, nextInPatrolArea, counter, endScore, next_test_edge,
+                endJunctions, junctionList, directionList, endXYZ, endSteps);
+            context.NumJunctions = savedNumJunctions;
 
 #if defined(DEBUG_LEVEL_2) && DEBUG_LEVEL_2
             if (gPathFindDebug)
@@ -1159,56 +1156,49 @@ static void peep_pathfind_heuristic_search(
 }
 
 /**
- * Returns:
- *   -1   - no direction chosen
- *   0..3 - chosen direction
- *
- *  rct2: 0x0069A5F0
+ * The best heuristic score and the number of steps to it found by searching along each edge of a tile.
  */
-Direction peep_pathfind_choose_direction(TileCoordsXYZ loc, Peep* peep)
+struct PathfindEdgeScores
 {
-    // The max number of thin junctions searched - a per-search-path limit.
-    _peepPathFindMaxJunctions = peep_pathfind_get_max_number_junctions(peep);
-
-    /* The max number of tiles to check - a whole-search limit.
-     * Mainly to limit the performance impact of the path finding. */
-    int32_t maxTilesChecked = (peep->type == PEEP_TYPE_STAFF) ? 50000 : 15000;
-    // Used to allow walking through no entry banners
-    _peepPathFindIsStaff = (peep->type == PEEP_TYPE_STAFF);
+    uint16_t Score[NumOrthogonalDirections];
+    uint8_t Steps[NumOrthogonalDirections];
+};
 
-    TileCoordsXYZ goal = gPeepPathFindGoalPosition;
+/**
+ * A guest's heuristic search that was run ahead of the guest's update, along with all the inputs it was run
+ * with. The scores are only used if the guest's update asks for a search with exactly the same inputs.
+ */
+struct PrecomputedPathfindSearch
+{
+    uint16_t SpriteIndex;
+    bool Searched;
+    TileCoordsXYZ Location;
+    TileCoordsXYZ Goal;
+    ride_id_t QueueRideIndex;
+    int8_t MaxJunctions;
+    uint8_t Edges;
+    rct12_xyzd8 PeepPathfindHistory[4];
+    PathfindEdgeScores Result;
+};
 
-#if defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
-    if (gPathFindDebug)
-    {
-        log_verbose(
-            "Choose direction for %s for goal %d,%d,%d from %d,%d,%d", gPathFindDebugPeepName, goal.x, goal.y, goal.z, loc.x,
-            loc.y, loc.z);
-    }
-#endif // defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
+static std::vector<PrecomputedPathfindSearch> _precomputedSearches;
+static uint32_t _precomputedSearchesUsed;
+static std::unique_ptr<JobPool> _pathfindJobs;
 
-    // Get the path element at this location
-    TileElement* dest_tile_element = map_get_first_element_at(loc.ToCoordsXY());
-    /* Where there are multiple matching map elements placed with zero
-     * clearance, save the first one for later use to determine the path
-     * slope - this maintains the original behaviour (which only processes
-     * the first matching map element found) and is consistent with peep
-     * placement (i.e. height) on such paths with differing slopes.
-     *
-     * I cannot see a legitimate reason for building overlaid paths with
-     * differing slopes and do not recall ever seeing this in practise.
-     * Normal cases I have seen in practise are overlaid paths with the
-     * same slope (flat) in order to place scenery (e.g. benches) in the
-     * middle of a wide path that can still be walked through.
-     * Anyone attempting to overlay paths with different slopes should
-     * EXPECT to experience path finding irregularities due to those paths!
-     * In particular common edges at different heights will not work
-     * in a useful way. Simply do not do it! :-) */
+/**
+ * Gets the first of the path elements at the given location - where there are multiple matching path
+ * elements placed with zero clearance, the first one is used to determine the path slope - along with the
+ * permitted edges of all of them and whether any of them is a thin junction.
+ * Returns nullptr if there is no path at the location.
+ */
+static TileElement* peep_pathfind_get_start_element(
+    const TileCoordsXYZ& loc, bool isStaff, uint8_t* permittedEdges, bool* isThin)
+{
     TileElement* first_tile_element = nullptr;
+    *permittedEdges = 0;
+    *isThin = false;
 
-    bool found = false;
-    uint8_t permitted_edges = 0;
-    bool isThin = false;
+    TileElement* dest_tile_element = map_get_first_element_at(loc.ToCoordsXY());
     do
     {
         if (dest_tile_element == nullptr)
@@ -1217,7 +1207,6 @@ Direction peep_pathfind_choose_direction(TileCoordsXYZ loc, Peep* peep)
             continue;
         if (dest_tile_element->GetType() != TILE_ELEMENT_TYPE_PATH)
             continue;
-        found = true;
         if (first_tile_element == nullptr)
         {
             first_tile_element = dest_tile_element;
@@ -1229,16 +1218,30 @@ Direction peep_pathfind_choose_direction(TileCoordsXYZ loc, Peep* peep)
          * check if the combination is 'thin'!
          * The junction is considered 'thin' simply if any of the
          * overlaid path elements there is a 'thin junction'. */
-        isThin = isThin || path_is_thin_junction(dest_tile_element->AsPath(), loc);
+        *isThin = *isThin || path_is_thin_junction(dest_tile_element->AsPath(), loc);
 
         // Collect the permitted edges of ALL matching path elements at this location.
-        permitted_edges |= path_get_permitted_edges(dest_tile_element->AsPath());
+        *permittedEdges |= path_get_permitted_edges(isStaff, dest_tile_element->AsPath());
     } while (!(dest_tile_element++)->IsLastForTile());
-    // Peep is not on a path.
-    if (!found)
-        return INVALID_DIRECTION;
 
-    permitted_edges &= 0xF;
+    *permittedEdges &= 0xF;
+    return first_tile_element;
+}
+
+static bool peep_pathfind_is_new_goal(const Peep* peep, const TileCoordsXYZ& goal)
+{
+    return !direction_valid(peep->pathfind_goal.direction) || peep->pathfind_goal.x != goal.x
+        || peep->pathfind_goal.y != goal.y || peep->pathfind_goal.z != goal.z;
+}
+
+/**
+ * Gets the edges at a thin junction that have not yet been tried while heading for the goal, updating the
+ * given pathfind history (the peep's own or a copy of it) the same way the peep's would be.
+ */
+static uint8_t peep_pathfind_get_untried_edges(
+    const Peep* peep, const TileCoordsXYZ& loc, const TileCoordsXYZ& goal, uint8_t permitted_edges, bool isThin,
+    rct12_xyzd8 (&pathfindHistory)[4])
+{
     uint8_t edges = permitted_edges;
     if (isThin && peep->pathfind_goal.x == goal.x && peep->pathfind_goal.y == goal.y && peep->pathfind_goal.z == goal.z)
     {
@@ -1257,9 +1260,9 @@ Direction peep_pathfind_choose_direction(TileCoordsXYZ loc, Peep* peep)
         /* If the peep remembers walking through this junction
          * previously while heading for its goal, retrieve the
          * directions it has not yet tried. */
-        for (auto& pathfindHistory : peep->pathfind_history)
+        for (auto& historyEntry : pathfindHistory)
         {
-            if (pathfindHistory.x == loc.x && pathfindHistory.y == loc.y && pathfindHistory.z == loc.z)
+            if (historyEntry.x == loc.x && historyEntry.y == loc.y && historyEntry.z == loc.z)
             {
                 /* Fix broken pathfind_history[i].direction
                  * which have untried directions that are not
@@ -1267,9 +1270,9 @@ Direction peep_pathfind_choose_direction(TileCoordsXYZ loc, Peep* peep)
                  * changes or in earlier code .directions was
                  * initialised to 0xF rather than the permitted
                  * edges. */
-                pathfindHistory.direction &= permitted_edges;
+                historyEntry.direction &= permitted_edges;
 
-                edges = pathfindHistory.direction;
+                edges = historyEntry.direction;
 
 #if defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
                 if (gPathFindDebug)
@@ -1290,8 +1293,8 @@ Direction peep_pathfind_choose_direction(TileCoordsXYZ loc, Peep* peep)
                      * the paths or the pathfinding itself
                      * has changed (been fixed) since
                      * the game was saved. */
-                    pathfindHistory.direction = permitted_edges;
-                    edges = pathfindHistory.direction;
+                    historyEntry.direction = permitted_edges;
+                    edges = historyEntry.direction;
 
 #if defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
                     if (gPathFindDebug)
@@ -1304,11 +1307,195 @@ Direction peep_pathfind_choose_direction(TileCoordsXYZ loc, Peep* peep)
             }
         }
     }
+    return edges;
+}
+
+/**
+ * Runs the heuristic search along each of the given edges of the start tile.
+ * context must hold the goal, the max number of junctions and the peep's (updated) pathfind history.
+ */
+static void peep_pathfind_search_edges(
+    PathfindContext& context, const TileCoordsXYZ& loc, Peep* peep, TileElement* first_tile_element, uint8_t edges,
+    PathfindEdgeScores& result)
+{
+    /* The max number of tiles to check - a whole-search limit.
+     * Mainly to limit the performance impact of the path finding. */
+    int32_t maxTilesChecked = (peep->type == PEEP_TYPE_STAFF) ? 50000 : 15000;
+
+    /* Call the search heuristic on each edge, keeping track of the
+     * edge that gives the best (i.e. smallest) value (best_score)
+     * or for different edges with equal value, the edge with the
+     * least steps (best_sub). */
+    int32_t numEdges = bitcount(edges);
+    for (int32_t test_edge = bitscanforward(edges); test_edge != -1; test_edge = bitscanforward(edges))
+    {
+        edges &= ~(1 << test_edge);
+        uint8_t height = loc.z;
+
+        if (first_tile_element->AsPath()->IsSloped() && first_tile_element->AsPath()->GetSlopeDirection() == test_edge)
+        {
+            height += 0x2;
+        }
+
+        /* Divide the maxTilesChecked global search limit
+         * between the remaining edges to ensure the search
+         * covers all of the remaining edges. */
+        context.TilesChecked = maxTilesChecked / numEdges;
+        context.NumJunctions = context.MaxJunctions;
+
+        // Initialise the search path history.
+        std::memset(context.History, 0xFF, sizeof(context.History));
+
+        /* The pathfinding will only use elements
+         * 1..context.MaxJunctions, so the starting point
+         * is placed in element 0 */
+        context.History[0].location.x = (uint8_t)(loc.x);
+        context.History[0].location.y = (uint8_t)(loc.y);
+        context.History[0].location.z = loc.z;
+        context.History[0].direction = 0xF;
+
+        uint16_t score = 0xFFFF;
+        /* Variable endXYZ contains the end location of the
+         * search path. */
+        TileCoordsXYZ endXYZ;
+        endXYZ.x = 0;
+        endXYZ.y = 0;
+        endXYZ.z = 0;
+
+        uint8_t endSteps = 255;
+
+        /* Variable endJunctions is the number of junctions
+         * passed through in the search path.
+         * Variables endJunctionList and endDirectionList
+         * contain the junctions and corresponding directions
+         * of the search path.
+         * In the future these could be used to visualise the
+         * pathfinding on the map. */
+        uint8_t endJunctions = 0;
+        TileCoordsXYZ endJunctionList[16];
+        uint8_t endDirectionList[16] = { 0 };
+
+        bool inPatrolArea = false;
+        if (peep->type == PEEP_TYPE_STAFF && peep->staff_type == STAFF_TYPE_MECHANIC)
+        {
+            /* Mechanics are the only staff type that
+             * pathfind to a destination. Determine if the
+             * mechanic is in their patrol area. */
+            inPatrolArea = staff_is_location_in_patrol(peep, peep->next_x, peep->next_y);
+        }
+
+#if defined(DEBUG_LEVEL_2) && DEBUG_LEVEL_2
+        if (gPathFindDebug)
+        {
+            log_verbose("Pathfind searching in direction: %d from %d,%d,%d", test_edge, x >> 5, y >> 5, z);
+        }
+#endif // defined(DEBUG_LEVEL_2) && DEBUG_LEVEL_2
+
+        peep_pathfind_heuristic_search(
+            context, { loc.x, loc.y, height }, peep, first_tile_element, inPatrolArea, 0, &score, test_edge, &endJunctions,
+            endJunctionList, endDirectionList, &endXYZ, &endSteps);
+
+        result.Score[test_edge] = score;
+        result.Steps[test_edge] = endSteps;
+
+#if defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
+        if (gPathFindDebug)
+        {
+            log_verbose(
+                "Pathfind test edge: %d score: %d steps: %d end: %d,%d,%d junctions: %d", test_edge, score, endSteps,
+                endXYZ.x, endXYZ.y, endXYZ.z, endJunctions);
+            for (uint8_t listIdx = 0; listIdx < endJunctions; listIdx++)
+            {
+                log_info(
+                    "Junction#%d %d,%d,%d Direction %d", listIdx + 1, endJunctionList[listIdx].x, endJunctionList[listIdx].y,
+                    endJunctionList[listIdx].z, endDirectionList[listIdx]);
+            }
+        }
+#endif // defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
+    }
+}
+
+/**
+ * Gets the scores of a search precomputed by guest_path_finding_precompute, if it was run with the same inputs.
+ */
+static bool peep_pathfind_get_precomputed(
+    const Peep* peep, const TileCoordsXYZ& loc, const PathfindContext& context, uint8_t edges, PathfindEdgeScores& result)
+{
+    if (context.IsStaff || !context.IgnoreForeignQueues)
+        return false;
+
+    auto it = std::lower_bound(
+        _precomputedSearches.begin(), _precomputedSearches.end(), peep->sprite_index,
+        [](const PrecomputedPathfindSearch& search, uint16_t spriteIndex) { return search.SpriteIndex < spriteIndex; });
+    if (it == _precomputedSearches.end() || it->SpriteIndex != peep->sprite_index || !it->Searched)
+        return false;
+
+    if (!(it->Location == loc) || !(it->Goal == context.GoalPosition) || it->QueueRideIndex != context.QueueRideIndex
+        || it->MaxJunctions != context.MaxJunctions || it->Edges != edges
+        || std::memcmp(it->PeepPathfindHistory, context.PeepPathfindHistory, sizeof(it->PeepPathfindHistory)) != 0)
+    {
+        return false;
+    }
+
+    result = it->Result;
+    _precomputedSearchesUsed++;
+    return true;
+}
+
+/**
+ * Returns:
+ *   -1   - no direction chosen
+ *   0..3 - chosen direction
+ *
+ *  rct2: 0x0069A5F0
+ */
+Direction peep_pathfind_choose_direction(const TileCoordsXYZ& loc, Peep* peep, PathfindContext& context)
+{
+    // The max number of thin junctions searched - a per-search-path limit.
+    context.MaxJunctions = peep_pathfind_get_max_number_junctions(peep);
+
+    // Used to allow walking through no entry banners
+    context.IsStaff = (peep->type == PEEP_TYPE_STAFF);
+
+    TileCoordsXYZ goal = context.GoalPosition;
+
+#if defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
+    if (gPathFindDebug)
+    {
+        log_verbose(
+            "Choose direction for %s for goal %d,%d,%d from %d,%d,%d", gPathFindDebugPeepName, goal.x, goal.y, goal.z, loc.x,
+            loc.y, loc.z);
+    }
+#endif // defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
+
+    /* Get the path element at this location.
+     * Where there are multiple matching map elements placed with zero
+     * clearance, save the first one for later use to determine the path
+     * slope - this maintains the original behaviour (which only processes
+     * the first matching map element found) and is consistent with peep
+     * placement (i.e. height) on such paths with differing slopes.
+     *
+     * I cannot see a legitimate reason for building overlaid paths with
+     * differing slopes and do not recall ever seeing this in practise.
+     * Normal cases I have seen in practise are overlaid paths with the
+     * same slope (flat) in order to place scenery (e.g. benches) in the
+     * middle of a wide path that can still be walked through.
+     * Anyone attempting to overlay paths with different slopes should
+     * EXPECT to experience path finding irregularities due to those paths!
+     * In particular common edges at different heights will not work
+     * in a useful way. Simply do not do it! :-) */
+    uint8_t permitted_edges;
+    bool isThin;
+    TileElement* first_tile_element = peep_pathfind_get_start_element(loc, context.IsStaff, &permitted_edges, &isThin);
+    // Peep is not on a path.
+    if (first_tile_element == nullptr)
+        return INVALID_DIRECTION;
+
+    uint8_t edges = peep_pathfind_get_untried_edges(peep, loc, goal, permitted_edges, isThin, peep->pathfind_history);
 
     /* If this is a new goal for the peep. Store it and reset the peep's
      * pathfind_history. */
-    if (!direction_valid(peep->pathfind_goal.direction) || peep->pathfind_goal.x != goal.x || peep->pathfind_goal.y != goal.y
-        || peep->pathfind_goal.z != goal.z)
+    if (peep_pathfind_is_new_goal(peep, goal))
     {
         peep->pathfind_goal.x = goal.x;
         peep->pathfind_goal.y = goal.y;
@@ -1338,124 +1525,31 @@ Direction peep_pathfind_choose_direction(TileCoordsXYZ loc, Peep* peep)
         uint8_t best_sub = 0xFF;
 
 #if defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
-        uint8_t bestJunctions = 0;
-        TileCoordsXYZ bestJunctionList[16];
-        uint8_t bestDirectionList[16];
-        TileCoordsXYZ bestXYZ;
-
         if (gPathFindDebug)
         {
             log_verbose("Pathfind start for goal %d,%d,%d from %d,%d,%d", goal.x, goal.y, goal.z, loc.x, loc.y, loc.z);
         }
 #endif // defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
 
-        /* Call the search heuristic on each edge, keeping track of the
-         * edge that gives the best (i.e. smallest) value (best_score)
-         * or for different edges with equal value, the edge with the
-         * least steps (best_sub). */
-        int32_t numEdges = bitcount(edges);
+        std::copy_n(peep->pathfind_history, std::size(peep->pathfind_history), context.PeepPathfindHistory);
+
+        PathfindEdgeScores scores;
+        if (!peep_pathfind_get_precomputed(peep, loc, context, edges, scores))
+        {
+            peep_pathfind_search_edges(context, loc, peep, first_tile_element, edges, scores);
+        }
+
         for (int32_t test_edge = chosen_edge; test_edge != -1; test_edge = bitscanforward(edges))
         {
             edges &= ~(1 << test_edge);
-            uint8_t height = loc.z;
-
-            if (first_tile_element->AsPath()->IsSloped() && first_tile_element->AsPath()->GetSlopeDirection() == test_edge)
-            {
-                height += 0x2;
-            }
-
-            _peepPathFindFewestNumSteps = 255;
-            /* Divide the maxTilesChecked global search limit
-             * between the remaining edges to ensure the search
-             * covers all of the remaining edges. */
-            _peepPathFindTilesChecked = maxTilesChecked / numEdges;
-            _peepPathFindNumJunctions = _peepPathFindMaxJunctions;
-
-            // Initialise _peepPathFindHistory.
-            std::memset(_peepPathFindHistory, 0xFF, sizeof(_peepPathFindHistory));
-
-            /* The pathfinding will only use elements
-             * 1.._peepPathFindMaxJunctions, so the starting point
-             * is placed in element 0 */
-            _peepPathFindHistory[0].location.x = (uint8_t)(loc.x);
-            _peepPathFindHistory[0].location.y = (uint8_t)(loc.y);
-            _peepPathFindHistory[0].location.z = loc.z;
-            _peepPathFindHistory[0].direction = 0xF;
-
-            uint16_t score = 0xFFFF;
-            /* Variable endXYZ contains the end location of the
-             * search path. */
-            TileCoordsXYZ endXYZ;
-            endXYZ.x = 0;
-            endXYZ.y = 0;
-            endXYZ.z = 0;
-
-            uint8_t endSteps = 255;
-
-            /* Variable endJunctions is the number of junctions
-             * passed through in the search path.
-             * Variables endJunctionList and endDirectionList
-             * contain the junctions and corresponding directions
-             * of the search path.
-             * In the future these could be used to visualise the
-             * pathfinding on the map. */
-            uint8_t endJunctions = 0;
-            TileCoordsXYZ endJunctionList[16];
-            uint8_t endDirectionList[16] = { 0 };
-
-            bool inPatrolArea = false;
-            if (peep->type == PEEP_TYPE_STAFF && peep->staff_type == STAFF_TYPE_MECHANIC)
-            {
-                /* Mechanics are the only staff type that
-                 * pathfind to a destination. Determine if the
-                 * mechanic is in their patrol area. */
-                inPatrolArea = staff_is_location_in_patrol(peep, peep->next_x, peep->next_y);
-            }
-
-#if defined(DEBUG_LEVEL_2) && DEBUG_LEVEL_2
-            if (gPathFindDebug)
-            {
-                log_verbose("Pathfind searching in direction: %d from %d,%d,%d", test_edge, x >> 5, y >> 5, z);
-            }
-#endif // defined(DEBUG_LEVEL_2) && DEBUG_LEVEL_2
-
-            peep_pathfind_heuristic_search(
-                { loc.x, loc.y, height }, peep, first_tile_element, inPatrolArea, 0, &score, test_edge, &endJunctions,
-                endJunctionList, endDirectionList, &endXYZ, &endSteps);
-
-#if defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
-            if (gPathFindDebug)
-            {
-                log_verbose(
-                    "Pathfind test edge: %d score: %d steps: %d end: %d,%d,%d junctions: %d", test_edge, score, endSteps,
-                    endXYZ.x, endXYZ.y, endXYZ.z, endJunctions);
-                for (uint8_t listIdx = 0; listIdx < endJunctions; listIdx++)
-                {
-                    log_info(
-                        "Junction#%d %d,%d,%d Direction %d", listIdx + 1, endJunctionList[listIdx].x,
-                        endJunctionList[listIdx].y, endJunctionList[listIdx].z, endDirectionList[listIdx]);
-                }
-            }
-#endif // defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
 
+            uint16_t score = scores.Score[test_edge];
+            uint8_t endSteps = scores.Steps[test_edge];
             if (score < best_score || (score == best_score && endSteps < best_sub))
             {
                 chosen_edge = test_edge;
                 best_score = score;
                 best_sub = endSteps;
-#if defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
-                bestJunctions = endJunctions;
-                for (uint8_t index = 0; index < endJunctions; index++)
-                {
-                    bestJunctionList[index].x = endJunctionList[index].x;
-                    bestJunctionList[index].y = endJunctionList[index].y;
-                    bestJunctionList[index].z = endJunctionList[index].z;
-                    bestDirectionList[index] = endDirectionList[index];
-                }
-                bestXYZ.x = endXYZ.x;
-                bestXYZ.y = endXYZ.y;
-                bestXYZ.z = endXYZ.z;
-#endif // defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
             }
         }
 
@@ -1476,13 +1570,6 @@ Direction peep_pathfind_choose_direction(TileCoordsXYZ loc, Peep* peep)
         if (gPathFindDebug)
         {
             log_verbose("Pathfind best edge %d with score %d steps %d", chosen_edge, best_score, best_sub);
-            for (uint8_t listIdx = 0; listIdx < bestJunctions; listIdx++)
-            {
-                log_verbose(
-                    "Junction#%d %d,%d,%d Direction %d", listIdx + 1, bestJunctionList[listIdx].x, bestJunctionList[listIdx].y,
-                    bestJunctionList[listIdx].z, bestDirectionList[listIdx]);
-            }
-            log_verbose("End at %d,%d,%d", bestXYZ.x, bestXYZ.y, bestXYZ.z);
         }
 #endif // defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
     }
@@ -1538,6 +1625,22 @@ Direction peep_pathfind_choose_direction(TileCoordsXYZ loc, Peep* peep)
     return chosen_edge;
 }
 
+/**
+ * Chooses the direction a guest takes to the goal of the context using the footpath graph, if enabled, otherwise (or
+ * if the graph can not find a way to the goal) using the heuristic search.
+ */
+static Direction guest_pathfind_choose_direction(Peep* peep, uint8_t edges, PathfindContext& context)
+{
+    TileCoordsXYZ loc = { peep->next_x / 32, peep->next_y / 32, peep->next_z };
+    if (footpath_graph_is_enabled())
+    {
+        Direction direction = footpath_graph_choose_direction(loc, context.GoalPosition, context.QueueRideIndex, edges);
+        if (direction != INVALID_DIRECTION)
+            return direction;
+    }
+    return peep_pathfind_choose_direction(loc, peep, context);
+}
+
 /**
  * Gets the nearest park entrance relative to point, by using Manhattan distance.
  * @param x x coordinate of location
@@ -1579,11 +1682,12 @@ static int32_t guest_path_find_entering_park(Peep* peep, uint8_t edges)
     int16_t y = gParkEntrances[chosenEntrance].y;
     int16_t z = gParkEntrances[chosenEntrance].z;
 
-    gPeepPathFindGoalPosition = { x / 32, y / 32, z >> 3 };
-    gPeepPathFindIgnoreForeignQueues = true;
-    gPeepPathFindQueueRideIndex = RIDE_ID_NULL;
+    PathfindContext context;
+    context.GoalPosition = { x / 32, y / 32, z >> 3 };
+    context.IgnoreForeignQueues = true;
+    context.QueueRideIndex = RIDE_ID_NULL;
 
-    Direction chosenDirection = peep_pathfind_choose_direction({ peep->next_x / 32, peep->next_y / 32, peep->next_z }, peep);
+    Direction chosenDirection = guest_pathfind_choose_direction(peep, edges, context);
 
     if (chosenDirection == INVALID_DIRECTION)
         return guest_path_find_aimless(peep, edges);
@@ -1635,15 +1739,16 @@ static int32_t guest_path_find_leaving_park(Peep* peep, uint8_t edges)
     uint8_t z = peepSpawn->z / 8;
     Direction direction = peepSpawn->direction;
 
-    gPeepPathFindGoalPosition = { x / 32, y / 32, z };
     if (x == peep->next_x && y == peep->next_y)
     {
         return peep_move_one_tile(direction, peep);
     }
 
-    gPeepPathFindIgnoreForeignQueues = true;
-    gPeepPathFindQueueRideIndex = RIDE_ID_NULL;
-    direction = peep_pathfind_choose_direction({ peep->next_x / 32, peep->next_y / 32, peep->next_z }, peep);
+    PathfindContext context;
+    context.GoalPosition = { x / 32, y / 32, z };
+    context.IgnoreForeignQueues = true;
+    context.QueueRideIndex = RIDE_ID_NULL;
+    direction = guest_pathfind_choose_direction(peep, edges, context);
     if (direction == INVALID_DIRECTION)
         return guest_path_find_aimless(peep, edges);
     else
@@ -1691,15 +1796,16 @@ static int32_t guest_path_find_park_entrance(Peep* peep, uint8_t edges)
     int16_t y = entrance.y;
     int16_t z = entrance.z;
 
-    gPeepPathFindGoalPosition = { x / 32, y / 32, z >> 3 };
-    gPeepPathFindIgnoreForeignQueues = true;
-    gPeepPathFindQueueRideIndex = RIDE_ID_NULL;
+    PathfindContext context;
+    context.GoalPosition = { x / 32, y / 32, z >> 3 };
+    context.IgnoreForeignQueues = true;
+    context.QueueRideIndex = RIDE_ID_NULL;
 
 #if defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
     pathfind_logging_enable(peep);
 #endif // defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
 
-    Direction chosenDirection = peep_pathfind_choose_direction({ peep->next_x / 32, peep->next_y / 32, peep->next_z }, peep);
+    Direction chosenDirection = guest_pathfind_choose_direction(peep, edges, context);
 
 #if defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
     pathfind_logging_disable();
@@ -1854,6 +1960,89 @@ static void get_ride_queue_end(TileCoordsXYZ& loc)
     loc.z = tileElement->base_height;
 }
 
+/**
+ * Gets the goal of a guest heading for the given open ride, which is the end of the queue of the entrance
+ * station the guest is heading for. Only reads the guest, the ride and the map.
+ */
+static TileCoordsXYZ guest_path_find_ride_goal(const Guest* peep, const Ride* ride)
+{
+    /* Find the ride's closest entrance station to the peep.
+     * At the same time, count how many entrance stations there are and
+     * which stations are entrance stations. */
+    auto bestScore = std::numeric_limits<int32_t>::max();
+    uint8_t closestStationNum = 0;
+
+    int32_t numEntranceStations = 0;
+    uint8_t entranceStations = 0;
+
+    for (uint8_t stationNum = 0; stationNum < MAX_STATIONS; ++stationNum)
+    {
+        // Skip if stationNum has no entrance (so presumably an exit only station)
+        if (ride_get_entrance_location(ride, stationNum).isNull())
+            continue;
+
+        numEntranceStations++;
+        entranceStations |= (1 << stationNum);
+
+        TileCoordsXYZD entranceLocation = ride_get_entrance_location(ride, stationNum);
+        auto score = CalculateHeuristicPathingScore(
+            { entranceLocation.x, entranceLocation.y, entranceLocation.z },
+            { peep->next_x / 32, peep->next_y / 32, peep->next_z });
+        if (score < bestScore)
+        {
+            bestScore = score;
+            closestStationNum = stationNum;
+            continue;
+        }
+    }
+
+    // Ride has no stations with an entrance, so head to station 0.
+    if (numEntranceStations == 0)
+        closestStationNum = 0;
+
+    /* If a ride has multiple entrance stations and is set to sync with
+     * adjacent stations, cycle through the entrance stations (based on
+     * number of rides the peep has been on) so the peep will try the
+     * different sections of the ride.
+     * In this case, the ride's various entrance stations will typically,
+     * though not necessarily, be adjacent to one another and consequently
+     * not too far for the peep to walk when cycling between them.
+     * Note: the same choice of station must made while the peep navigates
+     * to the station. Consequently a random station selection here is not
+     * appropriate. */
+    if (numEntranceStations > 1 && (ride->depart_flags & RIDE_DEPART_SYNCHRONISE_WITH_ADJACENT_STATIONS))
+    {
+        int32_t select = peep->no_of_rides % numEntranceStations;
+        while (select > 0)
+        {
+            closestStationNum = bitscanforward(entranceStations);
+            entranceStations &= ~(1 << closestStationNum);
+            select--;
+        }
+        closestStationNum = bitscanforward(entranceStations);
+    }
+
+    TileCoordsXYZ loc;
+    if (numEntranceStations == 0)
+    {
+        // closestStationNum is always 0 here.
+        auto entranceXY = ride->stations[closestStationNum].Start;
+        loc.x = entranceXY.x;
+        loc.y = entranceXY.y;
+        loc.z = ride->stations[closestStationNum].Height;
+    }
+    else
+    {
+        TileCoordsXYZD entranceXYZD = ride_get_entrance_location(ride, closestStationNum);
+        loc.x = entranceXYZD.x;
+        loc.y = entranceXYZD.y;
+        loc.z = entranceXYZD.z;
+    }
+
+    get_ride_queue_end(loc);
+    return loc;
+}
+
 /**
  *
  *  rct2: 0x00694C35
@@ -1883,8 +2072,7 @@ int32_t guest_path_finding(Guest* peep)
         return 1;
     }
 
-    _peepPathFindIsStaff = false;
-    uint8_t edges = path_get_permitted_edges(pathElement);
+    uint8_t edges = path_get_permitted_edges(false, pathElement);
 
     if (edges == 0)
     {
@@ -2060,86 +2248,12 @@ int32_t guest_path_finding(Guest* peep)
     }
 
     // The ride is open.
-    gPeepPathFindQueueRideIndex = rideIndex;
-
-    /* Find the ride's closest entrance station to the peep.
-     * At the same time, count how many entrance stations there are and
-     * which stations are entrance stations. */
-    auto bestScore = std::numeric_limits<int32_t>::max();
-    uint8_t closestStationNum = 0;
-
-    int32_t numEntranceStations = 0;
-    uint8_t entranceStations = 0;
-
-    for (uint8_t stationNum = 0; stationNum < MAX_STATIONS; ++stationNum)
-    {
-        // Skip if stationNum has no entrance (so presumably an exit only station)
-        if (ride_get_entrance_location(ride, stationNum).isNull())
-            continue;
-
-        numEntranceStations++;
-        entranceStations |= (1 << stationNum);
-
-        TileCoordsXYZD entranceLocation = ride_get_entrance_location(ride, stationNum);
-        auto score = CalculateHeuristicPathingScore(
-            { entranceLocation.x, entranceLocation.y, entranceLocation.z },
-            { peep->next_x / 32, peep->next_y / 32, peep->next_z });
-        if (score < bestScore)
-        {
-            bestScore = score;
-            closestStationNum = stationNum;
-            continue;
-        }
-    }
-
-    // Ride has no stations with an entrance, so head to station 0.
-    if (numEntranceStations == 0)
-        closestStationNum = 0;
-
-    /* If a ride has multiple entrance stations and is set to sync with
-     * adjacent stations, cycle through the entrance stations (based on
-     * number of rides the peep has been on) so the peep will try the
-     * different sections of the ride.
-     * In this case, the ride's various entrance stations will typically,
-     * though not necessarily, be adjacent to one another and consequently
-     * not too far for the peep to walk when cycling between them.
-     * Note: the same choice of station must made while the peep navigates
-     * to the station. Consequently a random station selection here is not
-     * appropriate. */
-    if (numEntranceStations > 1 && (ride->depart_flags & RIDE_DEPART_SYNCHRONISE_WITH_ADJACENT_STATIONS))
-    {
-        int32_t select = peep->no_of_rides % numEntranceStations;
-        while (select > 0)
-        {
-            closestStationNum = bitscanforward(entranceStations);
-            entranceStations &= ~(1 << closestStationNum);
-            select--;
-        }
-        closestStationNum = bitscanforward(entranceStations);
-    }
+    PathfindContext context;
+    context.GoalPosition = guest_path_find_ride_goal(peep, ride);
+    context.IgnoreForeignQueues = true;
+    context.QueueRideIndex = rideIndex;
 
-    if (numEntranceStations == 0)
-    {
-        // closestStationNum is always 0 here.
-        auto entranceXY = ride->stations[closestStationNum].Start;
-        loc.x = entranceXY.x;
-        loc.y = entranceXY.y;
-        loc.z = ride->stations[closestStationNum].Height;
-    }
-    else
-    {
-        TileCoordsXYZD entranceXYZD = ride_get_entrance_location(ride, closestStationNum);
-        loc.x = entranceXYZD.x;
-        loc.y = entranceXYZD.y;
-        loc.z = entranceXYZD.z;
-    }
-
-    get_ride_queue_end(loc);
-
-    gPeepPathFindGoalPosition = loc;
-    gPeepPathFindIgnoreForeignQueues = true;
-
-    direction = peep_pathfind_choose_direction({ peep->next_x / 32, peep->next_y / 32, peep->next_z }, peep);
+    direction = guest_pathfind_choose_direction(peep, edges, context);
 
     if (direction == INVALID_DIRECTION)
     {
@@ -2170,3 +2284,138 @@ int32_t guest_path_finding(Guest* peep)
 #endif // defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
     return peep_move_one_tile(direction, peep);
 }
+
+/**
+ * Whether the guest will reach the centre of its path tile in its next update while heading for a ride, in which
+ * case it will most likely run a heuristic search to the ride.
+ */
+static bool guest_is_about_to_pathfind_to_ride(Guest* peep)
+{
+    if (peep->state != PEEP_STATE_WALKING || (peep->action != PEEP_ACTION_NONE_1 && peep->action != PEEP_ACTION_NONE_2))
+        return false;
+    if (abs(peep->x - peep->destination_x) + abs(peep->y - peep->destination_y) > peep->destination_tolerance)
+        return false;
+    if (peep->GetNextIsSurface() || peep->outside_of_park != 0)
+        return false;
+    if (peep->peep_flags & (PEEP_FLAGS_LEAVING_PARK | PEEP_FLAGS_2))
+        return false;
+    return peep->guest_heading_to_ride_id != RIDE_ID_NULL;
+}
+
+static void guest_path_finding_precompute_search(PrecomputedPathfindSearch& search)
+{
+    auto peep = get_sprite(search.SpriteIndex)->peep.AsGuest();
+    auto ride = get_ride(peep->guest_heading_to_ride_id);
+    if (ride == nullptr || ride->status != RIDE_STATUS_OPEN)
+        return;
+
+    PathfindContext context;
+    context.GoalPosition = guest_path_find_ride_goal(peep, ride);
+    context.IgnoreForeignQueues = true;
+    context.QueueRideIndex = peep->guest_heading_to_ride_id;
+    context.MaxJunctions = peep_pathfind_get_max_number_junctions(peep);
+
+    TileCoordsXYZ loc = { peep->next_x / 32, peep->next_y / 32, peep->next_z };
+    uint8_t permittedEdges;
+    bool isThin;
+    TileElement* firstTileElement = peep_pathfind_get_start_element(loc, false, &permittedEdges, &isThin);
+    if (firstTileElement == nullptr)
+        return;
+
+    // Work on a copy of the pathfind history, the guest's own is only updated by its update
+    std::copy_n(peep->pathfind_history, std::size(peep->pathfind_history), context.PeepPathfindHistory);
+    uint8_t edges = peep_pathfind_get_untried_edges(
+        peep, loc, context.GoalPosition, permittedEdges, isThin, context.PeepPathfindHistory);
+    if (peep_pathfind_is_new_goal(peep, context.GoalPosition))
+    {
+        std::fill_n((uint8_t*)context.PeepPathfindHistory, sizeof(context.PeepPathfindHistory), 0xFF);
+    }
+
+    if (bitcount(edges) < 2)
+        return;
+
+    peep_pathfind_search_edges(context, loc, peep, firstTileElement, edges, search.Result);
+
+    search.Location = loc;
+    search.Goal = context.GoalPosition;
+    search.QueueRideIndex = context.QueueRideIndex;
+    search.MaxJunctions = context.MaxJunctions;
+    search.Edges = edges;
+    std::copy_n(context.PeepPathfindHistory, std::size(context.PeepPathfindHistory), search.PeepPathfindHistory);
+    search.Searched = true;
+}
+
+/**
+ * Runs the heuristic searches of the guests that are about to choose a direction to the ride they are heading for
+ * in parallel, before the guests are updated in sprite order. The map is not changed by peep updates, so a search
+ * gives the same result whether it is run now or during the guest's update; the result is only used if the guest's
+ * update asks for a search with exactly the same inputs, so the game state is identical to searching in the update.
+ */
+void guest_path_finding_precompute()
+{
+    _precomputedSearches.clear();
+    _precomputedSearchesUsed = 0;
+
+    if (!gConfigGeneral.multithreading)
+    {
+        _pathfindJobs.reset();
+        return;
+    }
+
+    // Guests use the footpath graph rather than the heuristic search
+    if (footpath_graph_is_enabled())
+        return;
+
+    for (uint16_t spriteIndex = gSpriteListHead[SPRITE_LIST_PEEP]; spriteIndex != SPRITE_INDEX_NULL;)
+    {
+        auto guest = get_sprite(spriteIndex)->peep.AsGuest();
+        spriteIndex = get_sprite(spriteIndex)->peep.next;
+
+        if (guest != nullptr && guest_is_about_to_pathfind_to_ride(guest))
+        {
+            auto& search = _precomputedSearches.emplace_back();
+            search.SpriteIndex = guest->sprite_index;
+            search.Searched = false;
+        }
+    }
+    if (_precomputedSearches.empty())
+        return;
+
+    std::sort(
+        _precomputedSearches.begin(), _precomputedSearches.end(),
+        [](const PrecomputedPathfindSearch& a, const PrecomputedPathfindSearch& b) { return a.SpriteIndex < b.SpriteIndex; });
+
+    if (_pathfindJobs == nullptr)
+    {
+        _pathfindJobs = std::make_unique<JobPool>();
+    }
+
+    const size_t stepSize = 8;
+    for (size_t rangeStart = 0; rangeStart < _precomputedSearches.size(); rangeStart += stepSize)
+    {
+        size_t rangeEnd = std::min(rangeStart + stepSize, _precomputedSearches.size());
+        _pathfindJobs->AddTask([rangeStart, rangeEnd]() {
+            for (size_t i = rangeStart; i < rangeEnd; i++)
+            {
+                guest_path_finding_precompute_search(_precomputedSearches[i]);
+            }
+        });
+    }
+    _pathfindJobs->Join();
+}
+
+/**
+ * Discards the precomputed searches, which are only valid until the map changes.
+ */
+void guest_path_finding_clear_precomputed()
+{
+    _precomputedSearches.clear();
+}
+
+/**
+ * Gets how many of the searches run by the last guest_path_finding_precompute were used by the guest updates.
+ */
+uint32_t guest_path_finding_get_precomputed_used()
+{
+    return _precomputedSearchesUsed;
+}
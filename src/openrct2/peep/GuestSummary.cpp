@@ -0,0 +1,188 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2019 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "GuestSummary.h"
+
+#include "../world/Sprite.h"
+#include "Peep.h"
+
+#include <algorithm>
+#include <bitset>
+#include <cstring>
+#include <map>
+
+struct GuestSummaryKeyLess
+{
+    bool operator()(const GuestSummaryKey& l, const GuestSummaryKey& r) const
+    {
+        return std::memcmp(l.Args, r.Args, sizeof(l.Args)) < 0;
+    }
+};
+
+struct GuestSummaryEntry
+{
+    bool InSummary;
+    GuestSummaryKey Keys[GUEST_SUMMARY_VIEW_COUNT];
+    // The position of the guest in the guests of its group for each view
+    size_t Positions[GUEST_SUMMARY_VIEW_COUNT];
+};
+
+static std::map<GuestSummaryKey, GuestSummaryGroup, GuestSummaryKeyLess> _groups[GUEST_SUMMARY_VIEW_COUNT];
+static std::vector<GuestSummaryEntry> _entries;
+static std::bitset<MAX_SPRITES> _isGuestDirty;
+static std::vector<uint16_t> _dirtyGuests;
+static bool _allGuestsDirty = true;
+
+static GuestSummaryKey guest_summary_compute_key(const Peep* peep, int32_t view)
+{
+    GuestSummaryKey key;
+    switch (view)
+    {
+        case GUEST_SUMMARY_VIEW_ACTIONS:
+            peep->FormatActionTo(key.Args);
+            break;
+        case GUEST_SUMMARY_VIEW_THOUGHTS:
+        {
+            auto thought = &peep->thoughts[0];
+            if (thought->freshness <= 5 && thought->type != PEEP_THOUGHT_TYPE_NONE)
+            {
+                peep_thought_set_format_args_on(key.Args, thought);
+            }
+            break;
+        }
+    }
+    return key;
+}
+
+static void guest_summary_add(const Peep* peep)
+{
+    auto& entry = _entries[peep->sprite_index];
+    for (int32_t view = 0; view < GUEST_SUMMARY_VIEW_COUNT; view++)
+    {
+        entry.Keys[view] = guest_summary_compute_key(peep, view);
+        auto& group = _groups[view][entry.Keys[view]];
+        group.Key = entry.Keys[view];
+        entry.Positions[view] = group.Guests.size();
+        group.Guests.push_back(peep->sprite_index);
+    }
+    entry.InSummary = true;
+}
+
+static void guest_summary_remove(uint16_t spriteIndex)
+{
+    auto& entry = _entries[spriteIndex];
+    if (!entry.InSummary)
+        return;
+
+    for (int32_t view = 0; view < GUEST_SUMMARY_VIEW_COUNT; view++)
+    {
+        auto it = _groups[view].find(entry.Keys[view]);
+        if (it == _groups[view].end())
+            continue;
+
+        // Move the last guest of the group into the place of the removed one
+        auto& guests = it->second.Guests;
+        auto position = entry.Positions[view];
+        auto lastGuest = guests.back();
+        guests[position] = lastGuest;
+        _entries[lastGuest].Positions[view] = position;
+        guests.pop_back();
+        if (guests.empty())
+        {
+            _groups[view].erase(it);
+        }
+    }
+    entry.InSummary = false;
+}
+
+static void guest_summary_regroup(uint16_t spriteIndex)
+{
+    guest_summary_remove(spriteIndex);
+
+    auto peep = get_sprite(spriteIndex)->AsPeep();
+    if (peep != nullptr && peep->type == PEEP_TYPE_GUEST && peep->outside_of_park == 0)
+    {
+        guest_summary_add(peep);
+    }
+}
+
+static void guest_summary_update()
+{
+    if (_allGuestsDirty)
+    {
+        _allGuestsDirty = false;
+        for (auto& groups : _groups)
+        {
+            groups.clear();
+        }
+        _entries.assign(MAX_SPRITES, {});
+
+        uint16_t spriteIndex;
+        Peep* peep;
+        FOR_ALL_GUESTS (spriteIndex, peep)
+        {
+            if (peep->outside_of_park == 0)
+            {
+                guest_summary_add(peep);
+            }
+        }
+        return;
+    }
+
+    for (auto spriteIndex : _dirtyGuests)
+    {
+        _isGuestDirty[spriteIndex] = false;
+        guest_summary_regroup(spriteIndex);
+    }
+    _dirtyGuests.clear();
+}
+
+void guest_summary_invalidate()
+{
+    _allGuestsDirty = true;
+    _isGuestDirty.reset();
+    _dirtyGuests.clear();
+}
+
+void guest_summary_invalidate_guest(const SpriteBase* sprite)
+{
+    if (_allGuestsDirty || sprite->sprite_index >= MAX_SPRITES || _isGuestDirty[sprite->sprite_index])
+        return;
+
+    _isGuestDirty[sprite->sprite_index] = true;
+    _dirtyGuests.push_back(sprite->sprite_index);
+}
+
+GuestSummaryKey guest_summary_get_key(const Peep* peep, int32_t view)
+{
+    guest_summary_update();
+
+    const auto& entry = _entries[peep->sprite_index];
+    if (entry.InSummary)
+    {
+        return entry.Keys[view];
+    }
+    return guest_summary_compute_key(peep, view);
+}
+
+std::vector<const GuestSummaryGroup*> guest_summary_get_groups(int32_t view)
+{
+    guest_summary_update();
+
+    std::vector<const GuestSummaryGroup*> groups;
+    groups.reserve(_groups[view].size());
+    for (const auto& group : _groups[view])
+    {
+        groups.push_back(&group.second);
+    }
+    std::stable_sort(groups.begin(), groups.end(), [](const GuestSummaryGroup* a, const GuestSummaryGroup* b) {
+        return a->Guests.size() > b->Guests.size();
+    });
+    return groups;
+}
@@ -0,0 +1,67 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2019 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "../common.h"
+
+#include <vector>
+
+struct Peep;
+struct SpriteBase;
+
+enum GUEST_SUMMARY_VIEW
+{
+    GUEST_SUMMARY_VIEW_ACTIONS,
+    GUEST_SUMMARY_VIEW_THOUGHTS,
+    GUEST_SUMMARY_VIEW_COUNT
+};
+
+/**
+ * The format arguments describing what a guest is doing (see Peep::FormatActionTo) or thinking about (see
+ * peep_thought_set_format_args), guests with equal keys are shown as one group in the guest list.
+ */
+struct GuestSummaryKey
+{
+    uint8_t Args[12]{};
+};
+
+struct GuestSummaryGroup
+{
+    GuestSummaryKey Key;
+    // Sprite indices of the guests in the group, in no particular order
+    std::vector<uint16_t> Guests;
+};
+
+/**
+ * The guest summary keeps the guests in the park grouped by their key for each view, so the guest list does not have
+ * to format the action and thought of every guest to find the groups. Guests are marked as changed where their state,
+ * thoughts or the ride they are heading for change and are regrouped when the summary is next queried.
+ */
+
+/**
+ * Forgets all guests, for when the sprites have been replaced in bulk or a ride was renamed or removed.
+ */
+void guest_summary_invalidate();
+
+/**
+ * Marks the guest as changed, must be called whenever something shown by the views changes.
+ */
+void guest_summary_invalidate_guest(const SpriteBase* sprite);
+
+/**
+ * Gets the key of the guest for the given view.
+ */
+GuestSummaryKey guest_summary_get_key(const Peep* peep, int32_t view);
+
+/**
+ * Gets the groups of guests for the given view, the largest first. The groups are only valid until the summary is
+ * next queried.
+ */
+std::vector<const GuestSummaryGroup*> guest_summary_get_groups(int32_t view);
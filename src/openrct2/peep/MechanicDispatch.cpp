@@ -0,0 +1,150 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2019 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "MechanicDispatch.h"
+
+#include "../Game.h"
+#include "../ride/Ride.h"
+#include "../world/Map.h"
+#include "../world/Park.h"
+#include "../world/Sprite.h"
+#include "FootpathGraph.h"
+#include "Staff.h"
+
+#include <cstdlib>
+#include <vector>
+
+// The mechanics in the order they are in the peep sprite list, so ties are broken as the list walk did
+static std::vector<uint16_t> _mechanics;
+static bool _mechanicsAreValid;
+static uint16_t _numPeeps;
+
+static MechanicDispatchStats _stats;
+static uint32_t _statsStartTick;
+
+void mechanic_dispatch_invalidate()
+{
+    _mechanicsAreValid = false;
+}
+
+static void mechanic_dispatch_update_mechanics()
+{
+    // The count catches sprite lists that were replaced without going through move_sprite_to_list
+    if (_mechanicsAreValid && _numPeeps == gSpriteListCount[SPRITE_LIST_PEEP])
+        return;
+
+    _mechanics.clear();
+    uint16_t spriteIndex;
+    Peep* peep;
+    FOR_ALL_STAFF (spriteIndex, peep)
+    {
+        if (peep->staff_type == STAFF_TYPE_MECHANIC)
+        {
+            _mechanics.push_back(spriteIndex);
+        }
+    }
+    _numPeeps = gSpriteListCount[SPRITE_LIST_PEEP];
+    _mechanicsAreValid = true;
+}
+
+static bool mechanic_dispatch_is_available(Peep* peep, const CoordsXY& loc, bool forInspection)
+{
+    if (peep->linked_list_index != SPRITE_LIST_PEEP || peep->type != PEEP_TYPE_STAFF
+        || peep->staff_type != STAFF_TYPE_MECHANIC)
+    {
+        return false;
+    }
+
+    if (!forInspection)
+    {
+        if (peep->state == PEEP_STATE_HEADING_TO_INSPECTION)
+        {
+            if (peep->sub_state >= 4)
+                return false;
+        }
+        else if (peep->state != PEEP_STATE_PATROLLING)
+            return false;
+
+        if (!(peep->staff_orders & STAFF_ORDERS_FIX_RIDES))
+            return false;
+    }
+    else
+    {
+        if (peep->state != PEEP_STATE_PATROLLING || !(peep->staff_orders & STAFF_ORDERS_INSPECT_RIDES))
+            return false;
+    }
+
+    if (map_is_location_in_park(loc))
+        if (!staff_is_location_in_patrol(peep, loc.x & 0xFFE0, loc.y & 0xFFE0))
+            return false;
+
+    return peep->x != LOCATION_NULL;
+}
+
+/**
+ *
+ *  rct2: 0x006B774B (forInspection = 0)
+ *  rct2: 0x006B78C3 (forInspection = 1)
+ */
+Peep* mechanic_dispatch_find_closest(const TileCoordsXYZ& goal, bool forInspection)
+{
+    mechanic_dispatch_update_mechanics();
+    _stats.Requests++;
+
+    auto loc = goal.ToCoordsXY().ToTileCentre();
+    bool usePathDistance = footpath_graph_is_enabled();
+
+    uint32_t closestDistance = UINT32_MAX;
+    Peep* closestMechanic = nullptr;
+    uint32_t closestPathDistance = UINT32_MAX;
+    Peep* closestPathMechanic = nullptr;
+    for (auto spriteIndex : _mechanics)
+    {
+        auto peep = &get_sprite(spriteIndex)->peep;
+        _stats.MechanicsChecked++;
+        if (!mechanic_dispatch_is_available(peep, loc, forInspection))
+            continue;
+
+        // Manhattan distance
+        uint32_t distance = std::abs(peep->x - loc.x) + std::abs(peep->y - loc.y);
+        if (distance < closestDistance)
+        {
+            closestDistance = distance;
+            closestMechanic = peep;
+        }
+
+        if (usePathDistance && !peep->GetNextIsSurface())
+        {
+            _stats.PathDistanceQueries++;
+            uint32_t pathDistance = footpath_graph_get_distance(
+                { peep->next_x / 32, peep->next_y / 32, peep->next_z }, goal, RIDE_ID_NULL);
+            if (pathDistance != FOOTPATH_GRAPH_UNREACHABLE && pathDistance < closestPathDistance)
+            {
+                closestPathDistance = pathDistance;
+                closestPathMechanic = peep;
+            }
+        }
+    }
+
+    // Mechanics that can not reach the ride by path still walk there over the grass
+    return closestPathMechanic != nullptr ? closestPathMechanic : closestMechanic;
+}
+
+MechanicDispatchStats mechanic_dispatch_get_stats()
+{
+    auto stats = _stats;
+    stats.Ticks = gCurrentTicks - _statsStartTick;
+    return stats;
+}
+
+void mechanic_dispatch_reset_stats()
+{
+    _stats = {};
+    _statsStartTick = gCurrentTicks;
+}
@@ -0,0 +1,42 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2019 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "../common.h"
+#include "../world/Location.hpp"
+
+struct Peep;
+
+struct MechanicDispatchStats
+{
+    // Searches for a mechanic to send to a ride
+    uint32_t Requests;
+    // Mechanics looked at by the searches
+    uint32_t MechanicsChecked;
+    // Walking distances looked up in the footpath graph by the searches
+    uint32_t PathDistanceQueries;
+    // Ticks since the stats were reset
+    uint32_t Ticks;
+};
+
+/**
+ * Marks the list of mechanics as out of date, must be called whenever peeps are added, removed or reordered.
+ */
+void mechanic_dispatch_invalidate();
+
+/**
+ * Finds the mechanic to send to the ride whose station exit (or entrance) is at goal. Only mechanics that may go
+ * there, and are free to, are considered. The nearest one is chosen by walking distance when guests use the footpath
+ * graph, otherwise by the distance to the centre of the goal tile along x and y.
+ */
+Peep* mechanic_dispatch_find_closest(const TileCoordsXYZ& goal, bool forInspection);
+
+MechanicDispatchStats mechanic_dispatch_get_stats();
+void mechanic_dispatch_reset_stats();
@@ -43,9 +43,12 @@
 #include "../world/SmallScenery.h"
 #include "../world/Sprite.h"
 #include "../world/Surface.h"
+#include "GuestSummary.h"
+#include "MechanicDispatch.h"
 #include "Staff.h"
 
 #include <algorithm>
+#include <chrono>
 #include <iterator>
 #include <limits>
 
@@ -68,11 +71,6 @@ uint32_t gNextGuestNumber;
 
 uint8_t gPeepWarningThrottle[16];
 
-TileCoordsXYZ gPeepPathFindGoalPosition;
-bool gPeepPathFindIgnoreForeignQueues;
-ride_id_t gPeepPathFindQueueRideIndex;
-// uint32_t gPeepPathFindAltStationNum;
-
 static uint8_t _unk_F1AEF0;
 static TileElement* _peepRideEntranceExitElement;
 
@@ -398,6 +396,8 @@ int32_t peep_get_staff_count()
     return count;
 }
 
+static PeepUpdateStats _peepUpdateStats;
+
 /**
  *
  *  rct2: 0x0068F0A9
@@ -411,6 +411,11 @@ void peep_update_all()
     if (gScreenFlags & SCREEN_FLAGS_EDITOR)
         return;
 
+    auto startTime = std::chrono::high_resolution_clock::now();
+
+    guest_path_finding_precompute();
+    guest_ride_choices_begin_tick();
+
     spriteIndex = gSpriteListHead[SPRITE_LIST_PEEP];
     i = 0;
     while (spriteIndex != SPRITE_INDEX_NULL)
@@ -433,6 +438,21 @@ void peep_update_all()
 
         i++;
     }
+
+    guest_path_finding_clear_precomputed();
+
+    std::chrono::duration<double, std::milli> duration = std::chrono::high_resolution_clock::now() - startTime;
+    _peepUpdateStats.Milliseconds = duration.count();
+    _peepUpdateStats.RideChoices = guest_ride_choices_get_stats();
+    _peepUpdateStats.PrecomputedPathfindSearches = guest_path_finding_get_precomputed_used();
+}
+
+/**
+ * Gets how long the last peep_update_all took and how many guests chose a ride in it.
+ */
+PeepUpdateStats peep_update_all_get_stats()
+{
+    return _peepUpdateStats;
 }
 
 /**
@@ -718,6 +738,7 @@ void peep_window_state_update(Peep* peep)
 
         window_invalidate_by_number(WC_PEEP, peep->sprite_index);
         window_invalidate_by_class(WC_GUEST_LIST);
+        guest_summary_invalidate_guest(peep);
     }
     else
     {
@@ -1069,6 +1090,10 @@ static void peep_update_thoughts(Peep* peep)
         {
             if (++peep->thoughts[i].fresh_timeout == 0)
             {
+                // The guest list only groups guests by their first thought while it is recent
+                if (i == 0)
+                    guest_summary_invalidate_guest(peep);
+
                 // When thought is older than ~6900 ticks remove it
                 if (++peep->thoughts[i].freshness >= 28)
                 {
@@ -1096,6 +1121,7 @@ static void peep_update_thoughts(Peep* peep)
     {
         peep->thoughts[fresh_thought].freshness = 1;
         peep->window_invalidate_flags |= PEEP_INVALIDATE_PEEP_THOUGHTS;
+        guest_summary_invalidate_guest(peep);
     }
 }
 
@@ -1608,6 +1634,7 @@ void Peep::InsertNewThought(PeepThoughtType thoughtType, uint8_t thoughtArgument
     thoughts[0].fresh_timeout = 0;
 
     window_invalidate_flags |= PEEP_INVALIDATE_PEEP_THOUGHTS;
+    guest_summary_invalidate_guest(this);
 }
 
 /**
@@ -2055,7 +2082,13 @@ bool Peep::SetName(const std::string_view& value)
  */
 void peep_thought_set_format_args(const rct_peep_thought* thought)
 {
-    set_format_arg(0, rct_string_id, PeepThoughts[thought->type]);
+    peep_thought_set_format_args_on(gCommonFormatArgs, thought);
+}
+
+void peep_thought_set_format_args_on(void* argsV, const rct_peep_thought* thought)
+{
+    auto args = (uint8_t*)argsV;
+    set_format_arg_on(args, 0, rct_string_id, PeepThoughts[thought->type]);
 
     uint8_t flags = PeepThoughtToActionMap[thought->type].flags;
     if (flags & 1)
@@ -2063,20 +2096,20 @@ void peep_thought_set_format_args(const rct_peep_thought* thought)
         auto ride = get_ride(thought->item);
         if (ride != nullptr)
         {
-            ride->FormatNameTo(gCommonFormatArgs + 2);
+            ride->FormatNameTo(args + 2);
         }
         else
         {
-            set_format_arg(2, rct_string_id, STR_NONE);
+            set_format_arg_on(args, 2, rct_string_id, STR_NONE);
         }
     }
     else if (flags & 2)
     {
-        set_format_arg(2, rct_string_id, ShopItems[thought->item].Naming.Singular);
+        set_format_arg_on(args, 2, rct_string_id, ShopItems[thought->item].Naming.Singular);
     }
     else if (flags & 4)
     {
-        set_format_arg(2, rct_string_id, ShopItems[thought->item].Naming.Indefinite);
+        set_format_arg_on(args, 2, rct_string_id, ShopItems[thought->item].Naming.Indefinite);
     }
 }
 
@@ -3358,6 +3391,8 @@ void peep_update_name_sort(Peep* peep)
 finish_peep_sort:
     // This is required at the moment because this function reorders peeps in the sprite list
     sprite_position_tween_reset();
+    // Mechanics at the same distance from a ride are chosen in sprite list order
+    mechanic_dispatch_invalidate();
 }
 
 void peep_sort()
@@ -3392,6 +3427,7 @@ void peep_sort()
     }
     // Make sure the first peep is set
     gSpriteListHead[SPRITE_LIST_PEEP] = peep_list[0];
+    mechanic_dispatch_invalidate();
 
     free(peep_list);
 
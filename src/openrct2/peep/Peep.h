@@ -45,6 +45,7 @@
 constexpr auto PEEP_CLEARANCE_HEIGHT = 4 * COORDS_Z_STEP;
 
 struct TileElement;
+struct PathElement;
 struct Ride;
 
 enum PeepType : uint8_t
@@ -380,6 +381,7 @@ enum PeepFlags : uint32_t
     PEEP_FLAGS_INTAMIN_DEPRECATED = (1 << 27),   // Used to make the peep think "I'm so excited - It's an Intamin ride!" while
                                                  // riding on a Intamin ride.
     PEEP_FLAGS_HERE_WE_ARE = (1 << 28),          // Makes the peep think  "...and here we are on X!" while riding a ride
+    PEEP_FLAGS_RIDE_CHOICE_PENDING = (1 << 29),  // Waiting for the ride choice budget of a later tick
     PEEP_FLAGS_TWITCH = (1u << 31),              // Added for twitch integration
 };
 
@@ -955,20 +957,63 @@ extern uint32_t gNextGuestNumber;
 
 extern uint8_t gPeepWarningThrottle[16];
 
-extern TileCoordsXYZ gPeepPathFindGoalPosition;
-extern bool gPeepPathFindIgnoreForeignQueues;
-extern ride_id_t gPeepPathFindQueueRideIndex;
+/**
+ * The goal and state of a heuristic pathfinding search. Each search has its own context, so searches for different
+ * peeps can run concurrently.
+ */
+struct PathfindContext
+{
+    TileCoordsXYZ GoalPosition;
+    bool IgnoreForeignQueues = false;
+    ride_id_t QueueRideIndex = RIDE_ID_NULL;
+
+    // Search state, set up by peep_pathfind_choose_direction
+    bool IsStaff = false;
+    int8_t NumJunctions = 0;
+    int8_t MaxJunctions = 0;
+    int32_t TilesChecked = 0;
+    /* A junction history for the heuristic search.
+     * The magic number 16 is the largest value returned by
+     * peep_pathfind_get_max_number_junctions() which should eventually
+     * be declared properly. */
+    struct
+    {
+        TileCoordsXYZ location;
+        Direction direction;
+    } History[16];
+    rct12_xyzd8 PeepPathfindHistory[4];
+};
+
+struct GuestRideChoiceStats
+{
+    // Guests that looked for a ride to go on because they felt like it
+    uint32_t Made;
+    // Guests that felt like it but had to wait for a later tick
+    uint32_t Deferred;
+    // Guests still waiting
+    uint32_t Pending;
+};
+
+struct PeepUpdateStats
+{
+    double Milliseconds;
+    GuestRideChoiceStats RideChoices;
+    // Heuristic searches run in parallel ahead of the guest updates that used them
+    uint32_t PrecomputedPathfindSearches;
+};
 
 Peep* try_get_guest(uint16_t spriteIndex);
 int32_t peep_get_staff_count();
 bool peep_can_be_picked_up(Peep* peep);
 void peep_update_all();
+PeepUpdateStats peep_update_all_get_stats();
 void peep_problem_warnings_update();
 void peep_stop_crowd_noise();
 void peep_update_crowd_noise();
 void peep_update_days_in_queue();
 void peep_applause();
 void peep_thought_set_format_args(const rct_peep_thought* thought);
+void peep_thought_set_format_args_on(void* args, const rct_peep_thought* thought);
 int32_t get_peep_face_sprite_small(Peep* peep);
 int32_t get_peep_face_sprite_large(Peep* peep);
 void game_command_pickup_guest(
@@ -987,11 +1032,19 @@ void peep_update_names(bool realNames);
 
 void guest_set_name(uint16_t spriteIndex, const char* name);
 
-Direction peep_pathfind_choose_direction(TileCoordsXYZ loc, Peep* peep);
+Direction peep_pathfind_choose_direction(const TileCoordsXYZ& loc, Peep* peep, PathfindContext& context);
 void peep_reset_pathfind_goal(Peep* peep);
 
 bool is_valid_path_z_and_direction(TileElement* tileElement, int32_t currentZ, int32_t currentDirection);
+int32_t path_get_permitted_edges(bool isStaff, PathElement* pathElement);
 int32_t guest_path_finding(Guest* peep);
+void guest_path_finding_precompute();
+void guest_path_finding_clear_precomputed();
+uint32_t guest_path_finding_get_precomputed_used();
+void guest_ride_choices_begin_tick();
+// Makes the next tick look for guests waiting to choose a ride, for when the guests have been replaced in bulk
+void guest_ride_choices_invalidate();
+GuestRideChoiceStats guest_ride_choices_get_stats();
 
 #if defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
 #    define PATHFIND_DEBUG                                                                                                     \
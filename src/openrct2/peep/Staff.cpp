@@ -33,10 +33,12 @@
 #include "../util/Util.h"
 #include "../world/Entrance.h"
 #include "../world/Footpath.h"
+#include "../world/LitterIndex.h"
 #include "../world/Scenery.h"
 #include "../world/SmallScenery.h"
 #include "../world/Sprite.h"
 #include "../world/Surface.h"
+#include "FootpathGraph.h"
 #include "Peep.h"
 
 #include <algorithm>
@@ -378,6 +380,14 @@ void staff_reset_stats()
     }
 }
 
+// Gets the index of the bit for the 4x4 square containing x, y in a patrol area
+static int32_t staff_get_patrol_area_bit(int32_t x, int32_t y)
+{
+    int32_t blockX = (x >> STAFF_PATROL_AREA_BLOCK_SHIFT) & (STAFF_PATROL_AREA_BLOCKS_PER_LINE - 1);
+    int32_t blockY = (y >> STAFF_PATROL_AREA_BLOCK_SHIFT) & (STAFF_PATROL_AREA_BLOCKS_PER_LINE - 1);
+    return blockY * STAFF_PATROL_AREA_BLOCKS_PER_LINE + blockX;
+}
+
 static bool staff_is_patrol_area_set(int32_t staffIndex, int32_t x, int32_t y)
 {
     // Patrol quads are stored in a bit map (8 patrol quads per byte).
@@ -386,12 +396,10 @@ static bool staff_is_patrol_area_set(int32_t staffIndex, int32_t x, int32_t y)
     // At the end of the array (after the slots for individual staff members),
     // there are slots that save the combined patrol area for every staff type.
 
-    x = (x & 0x1F80) >> 7;
-    y = (y & 0x1F80) >> 1;
-
     int32_t peepOffset = staffIndex * STAFF_PATROL_AREA_SIZE;
-    int32_t offset = (x | y) >> 5;
-    int32_t bitIndex = (x | y) & 0x1F;
+    int32_t bit = staff_get_patrol_area_bit(x, y);
+    int32_t offset = bit >> 5;
+    int32_t bitIndex = bit & 0x1F;
     return gStaffPatrolAreas[peepOffset + offset] & (((uint32_t)1) << bitIndex);
 }
 
@@ -407,12 +415,10 @@ bool staff_is_patrol_area_set_for_type(STAFF_TYPE type, CoordsXY coords)
 
 void staff_set_patrol_area(int32_t staffIndex, int32_t x, int32_t y, bool value)
 {
-    x = (x & 0x1F80) >> 7;
-    y = (y & 0x1F80) >> 1;
-
     int32_t peepOffset = staffIndex * STAFF_PATROL_AREA_SIZE;
-    int32_t offset = (x | y) >> 5;
-    int32_t bitIndex = (x | y) & 0x1F;
+    int32_t bit = staff_get_patrol_area_bit(x, y);
+    int32_t offset = bit >> 5;
+    int32_t bitIndex = bit & 0x1F;
     uint32_t* addr = &gStaffPatrolAreas[peepOffset + offset];
     if (value)
     {
@@ -426,12 +432,10 @@ void staff_set_patrol_area(int32_t staffIndex, int32_t x, int32_t y, bool value)
 
 void staff_toggle_patrol_area(int32_t staffIndex, int32_t x, int32_t y)
 {
-    x = (x & 0x1F80) >> 7;
-    y = (y & 0x1F80) >> 1;
-
     int32_t peepOffset = staffIndex * STAFF_PATROL_AREA_SIZE;
-    int32_t offset = (x | y) >> 5;
-    int32_t bitIndex = (x | y) & 0x1F;
+    int32_t bit = staff_get_patrol_area_bit(x, y);
+    int32_t offset = bit >> 5;
+    int32_t bitIndex = bit & 0x1F;
     gStaffPatrolAreas[peepOffset + offset] ^= (1 << bitIndex);
 }
 
@@ -443,24 +447,8 @@ void staff_toggle_patrol_area(int32_t staffIndex, int32_t x, int32_t y)
  */
 static uint8_t staff_handyman_direction_to_nearest_litter(Peep* peep)
 {
-    uint16_t nearestLitterDist = (uint16_t)-1;
-    Litter* nearestLitter = nullptr;
-    Litter* litter = nullptr;
-
-    for (uint16_t litterIndex = gSpriteListHead[SPRITE_LIST_LITTER]; litterIndex != 0xFFFF; litterIndex = litter->next)
-    {
-        litter = &get_sprite(litterIndex)->litter;
-
-        uint16_t distance = abs(litter->x - peep->x) + abs(litter->y - peep->y) + abs(litter->z - peep->z) * 4;
-
-        if (distance < nearestLitterDist)
-        {
-            nearestLitterDist = distance;
-            nearestLitter = litter;
-        }
-    }
-
-    if (nearestLitterDist > 0x60)
+    Litter* nearestLitter = litter_index_get_nearest({ peep->x, peep->y, peep->z }, 0x60);
+    if (nearestLitter == nullptr)
     {
         return 0xFF;
     }
@@ -868,19 +856,29 @@ static uint8_t staff_mechanic_direction_path(Peep* peep, uint8_t validDirections
             }
         }
 
-        gPeepPathFindGoalPosition.x = location.x;
-        gPeepPathFindGoalPosition.y = location.y;
-        gPeepPathFindGoalPosition.z = location.z;
+        PathfindContext context;
+        context.GoalPosition.x = location.x;
+        context.GoalPosition.y = location.y;
+        context.GoalPosition.z = location.z;
 
-        gPeepPathFindIgnoreForeignQueues = false;
-        gPeepPathFindQueueRideIndex = RIDE_ID_NULL;
+        context.IgnoreForeignQueues = false;
+        context.QueueRideIndex = RIDE_ID_NULL;
+
+        // Walk the shortest way when guests do, the footpath graph remembers the way to each ride
+        if (footpath_graph_is_enabled())
+        {
+            Direction graphDirection = footpath_graph_choose_direction(
+                { peep->next_x / 32, peep->next_y / 32, peep->next_z }, context.GoalPosition, RIDE_ID_NULL, pathDirections);
+            if (graphDirection != INVALID_DIRECTION)
+                return graphDirection;
+        }
 
 #if defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
         pathfind_logging_enable(peep);
 #endif // defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
 
         Direction pathfindDirection = peep_pathfind_choose_direction(
-            { peep->next_x / 32, peep->next_y / 32, peep->next_z }, peep);
+            { peep->next_x / 32, peep->next_y / 32, peep->next_z }, peep, context);
 
 #if defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
         pathfind_logging_disable();
@@ -1827,6 +1825,10 @@ static int32_t peep_update_patrolling_find_sweeping(Peep* peep)
     if (!(peep->staff_orders & STAFF_ORDERS_SWEEPING))
         return 0;
 
+    // Saves walking through the guests on busy paths
+    if (!litter_index_has_litter_on_tile({ peep->x, peep->y }))
+        return 0;
+
     uint16_t sprite_id = sprite_get_first_in_quadrant(peep->x, peep->y);
 
     for (rct_sprite* sprite = nullptr; sprite_id != SPRITE_INDEX_NULL; sprite_id = sprite->generic.next_in_quadrant)
@@ -14,9 +14,12 @@
 #include "Peep.h"
 
 #define STAFF_MAX_COUNT 200
-// The number of elements in the gStaffPatrolAreas array per staff member. Every bit in the array represents a 4x4 square.
+// Every bit in the gStaffPatrolAreas array represents a 4x4 square, (x >> STAFF_PATROL_AREA_BLOCK_SHIFT) is its column.
+#define STAFF_PATROL_AREA_BLOCK_SHIFT 7
+#define STAFF_PATROL_AREA_BLOCKS_PER_LINE (MAXIMUM_MAP_SIZE_TECHNICAL / 4)
+// The number of elements in the gStaffPatrolAreas array per staff member.
 // Right now, it's a 32-bit array like in RCT2. 32 * 128 = 4096 bits, which is also the number of 4x4 squares on a 256x256 map.
-#define STAFF_PATROL_AREA_SIZE 128
+#define STAFF_PATROL_AREA_SIZE (STAFF_PATROL_AREA_BLOCKS_PER_LINE * STAFF_PATROL_AREA_BLOCKS_PER_LINE / 32)
 
 enum STAFF_MODE
 {
@@ -1098,6 +1098,7 @@ private:
         ImportPeeps();
         ImportLitter();
         ImportMiscSprites();
+        sprite_lists_invalidate();
     }
 
     void ImportVehicles()
@@ -1959,10 +1960,11 @@ private:
     {
         gMapBaseZ = 7;
 
-        for (uint32_t index = 0, dstOffset = 0; index < RCT1_MAX_TILE_ELEMENTS; index++)
+        std::vector<TileElement> tileElements(RCT1_MAX_TILE_ELEMENTS);
+        for (uint32_t index = 0; index < RCT1_MAX_TILE_ELEMENTS; index++)
         {
             auto src = &_s4.tile_elements[index];
-            auto dst = &gTileElements[index + dstOffset];
+            auto dst = &tileElements[index];
             if (src->base_height == 0xFF)
             {
                 std::memcpy(dst, src, sizeof(*src));
@@ -1973,7 +1975,7 @@ private:
             }
         }
 
-        ClearExtraTileEntries();
+        ClearExtraTileEntries(tileElements);
         FixWalls();
         FixEntrancePositions();
     }
@@ -2685,61 +2687,43 @@ private:
         gSavedViewRotation = _s4.view_rotation;
     }
 
-    void ClearExtraTileEntries()
+    void ClearExtraTileEntries(const std::vector<TileElement>& rct1TileElements)
     {
-        // Reset the map tile pointers
-        std::fill(std::begin(gTileElementTilePointers), std::end(gTileElementTilePointers), nullptr);
+        TileElement blankTileElement = {};
+        blankTileElement.ClearAs(TILE_ELEMENT_TYPE_SURFACE);
+        blankTileElement.SetLastForTile(true);
+        blankTileElement.AsSurface()->SetSlope(TILE_ELEMENT_SLOPE_FLAT);
+        blankTileElement.AsSurface()->SetSurfaceStyle(TERRAIN_GRASS);
+        blankTileElement.AsSurface()->SetEdgeStyle(TERRAIN_EDGE_ROCK);
+        blankTileElement.AsSurface()->SetGrassLength(GRASS_LENGTH_CLEAR_0);
+        blankTileElement.AsSurface()->SetOwnership(OWNERSHIP_UNOWNED);
 
-        // Get the first free map element
-        TileElement* nextFreeTileElement = gTileElements;
-        for (size_t i = 0; i < RCT1_MAX_MAP_SIZE * RCT1_MAX_MAP_SIZE; i++)
-        {
-            while (!(nextFreeTileElement++)->IsLastForTile())
-                ;
-        }
-
-        TileElement* tileElement = gTileElements;
-        TileElement** tilePointer = gTileElementTilePointers;
+        std::vector<TileElement> tileElements;
+        tileElements.reserve(rct1TileElements.size() + MAX_TILE_TILE_ELEMENT_POINTERS);
 
         // 128 rows of map data from RCT1 map
-        for (int32_t x = 0; x < RCT1_MAX_MAP_SIZE; x++)
+        auto tileElement = rct1TileElements.begin();
+        for (int32_t y = 0; y < RCT1_MAX_MAP_SIZE; y++)
         {
-            // Assign the first half of this row
-            for (int32_t y = 0; y < RCT1_MAX_MAP_SIZE; y++)
+            // Copy the first half of this row
+            for (int32_t x = 0; x < RCT1_MAX_MAP_SIZE; x++)
             {
-                *tilePointer++ = tileElement;
-                while (!(tileElement++)->IsLastForTile())
-                    ;
+                do
+                {
+                    tileElements.push_back(*tileElement);
+                } while (!(tileElement++)->IsLastForTile());
             }
 
             // Fill the rest of the row with blank tiles
-            for (int32_t y = 0; y < RCT1_MAX_MAP_SIZE; y++)
-            {
-                nextFreeTileElement->ClearAs(TILE_ELEMENT_TYPE_SURFACE);
-                nextFreeTileElement->SetLastForTile(true);
-                nextFreeTileElement->AsSurface()->SetSlope(TILE_ELEMENT_SLOPE_FLAT);
-                nextFreeTileElement->AsSurface()->SetSurfaceStyle(TERRAIN_GRASS);
-                nextFreeTileElement->AsSurface()->SetEdgeStyle(TERRAIN_EDGE_ROCK);
-                nextFreeTileElement->AsSurface()->SetGrassLength(GRASS_LENGTH_CLEAR_0);
-                nextFreeTileElement->AsSurface()->SetOwnership(OWNERSHIP_UNOWNED);
-                *tilePointer++ = nextFreeTileElement++;
-            }
+            tileElements.insert(tileElements.end(), MAXIMUM_MAP_SIZE_TECHNICAL - RCT1_MAX_MAP_SIZE, blankTileElement);
         }
 
         // 128 extra rows left to fill with blank tiles
-        for (int32_t y = 0; y < 128 * 256; y++)
-        {
-            nextFreeTileElement->ClearAs(TILE_ELEMENT_TYPE_SURFACE);
-            nextFreeTileElement->SetLastForTile(true);
-            nextFreeTileElement->AsSurface()->SetSlope(TILE_ELEMENT_SLOPE_FLAT);
-            nextFreeTileElement->AsSurface()->SetSurfaceStyle(TERRAIN_GRASS);
-            nextFreeTileElement->AsSurface()->SetEdgeStyle(TERRAIN_EDGE_ROCK);
-            nextFreeTileElement->AsSurface()->SetGrassLength(GRASS_LENGTH_CLEAR_0);
-            nextFreeTileElement->AsSurface()->SetOwnership(OWNERSHIP_UNOWNED);
-            *tilePointer++ = nextFreeTileElement++;
-        }
+        tileElements.insert(
+            tileElements.end(), (MAXIMUM_MAP_SIZE_TECHNICAL - RCT1_MAX_MAP_SIZE) * MAXIMUM_MAP_SIZE_TECHNICAL,
+            blankTileElement);
 
-        gNextFreeTileElement = nextFreeTileElement;
+        map_set_tile_elements(tileElements);
     }
 
     void FixWalls()
@@ -17,6 +17,7 @@
 #include "../ride/Vehicle.h"
 #include "../world/Location.hpp"
 
+#define RCT2_MAX_MAP_SIZE 256
 #define RCT2_MAX_STAFF 200
 #define RCT2_MAX_BANNERS_IN_PARK 250
 #define RCT2_MAX_VEHICLES_PER_RIDE 31
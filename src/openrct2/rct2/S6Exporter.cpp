@@ -1376,9 +1376,14 @@ void S6Exporter::ExportMapAnimations()
 
 void S6Exporter::ExportTileElements()
 {
+    static_assert(MAXIMUM_MAP_SIZE_TECHNICAL == RCT2_MAX_MAP_SIZE, "SV6 files hold the tile elements of a 256x256 map");
+
+    // The elements are saved in tile order, the rest of the elements are left cleared
+    auto tileElements = map_get_tile_elements();
+    tileElements.resize(RCT2_MAX_TILE_ELEMENTS);
     for (uint32_t index = 0; index < RCT2_MAX_TILE_ELEMENTS; index++)
     {
-        auto src = &gTileElements[index];
+        auto src = &tileElements[index];
         auto dst = &_s6.tile_elements[index];
         if (src->base_height == 0xFF)
         {
@@ -1634,7 +1639,6 @@ int32_t scenario_save(const utf8* path, int32_t flags)
         window_close_construction_windows();
     }
 
-    map_reorganise_elements();
     viewport_set_saved_view();
 
     bool result = false;
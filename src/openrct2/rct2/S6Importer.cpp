@@ -447,7 +447,6 @@ public:
 
         // Fix and set dynamic variables
         map_strip_ghost_flag_from_elements();
-        map_update_tile_pointers();
         game_convert_strings_to_utf8();
         map_count_remaining_land_rights();
         determine_ride_entrance_and_exit_locations();
@@ -996,10 +995,13 @@ public:
 
     void ImportTileElements()
     {
+        static_assert(MAXIMUM_MAP_SIZE_TECHNICAL == RCT2_MAX_MAP_SIZE, "SV6 files hold the tile elements of a 256x256 map");
+
+        std::vector<TileElement> tileElements(RCT2_MAX_TILE_ELEMENTS);
         for (uint32_t index = 0; index < RCT2_MAX_TILE_ELEMENTS; index++)
         {
             auto src = &_s6.tile_elements[index];
-            auto dst = &gTileElements[index];
+            auto dst = &tileElements[index];
             if (src->base_height == 0xFF)
             {
                 std::memcpy(dst, src, sizeof(*src));
@@ -1016,6 +1018,7 @@ public:
                     ImportTileElement(dst, src);
             }
         }
+        map_set_tile_elements(tileElements);
         gNextFreeTileElementPointerIndex = _s6.next_free_tile_element_pointer_index;
     }
 
@@ -1266,6 +1269,9 @@ public:
         }
         // This list contains the number of free slots. Increase it according to our own sprite limit.
         gSpriteListCount[SPRITE_LIST_FREE] += (MAX_SPRITES - RCT2_MAX_SPRITES);
+
+        // Network clients load the map without resetting the spatial index, which would do this too
+        sprite_lists_invalidate();
     }
 
     void ImportSprite(rct_sprite* dst, const RCT2Sprite* src)
@@ -37,6 +37,8 @@
 #include "../object/ObjectManager.h"
 #include "../object/StationObject.h"
 #include "../paint/VirtualFloor.h"
+#include "../peep/GuestSummary.h"
+#include "../peep/MechanicDispatch.h"
 #include "../peep/Peep.h"
 #include "../peep/Staff.h"
 #include "../rct1/RCT1.h"
@@ -61,6 +63,7 @@
 #include "ShopItem.h"
 #include "Station.h"
 #include "Track.h"
+#include "TrackCircuit.h"
 #include "TrackData.h"
 #include "TrackDesign.h"
 
@@ -124,7 +127,6 @@ uint8_t gRideEntranceExitPlaceDirection;
 uint8_t gLastEntranceStyle;
 
 // Static function declarations
-Peep* find_closest_mechanic(int32_t x, int32_t y, int32_t forInspection);
 static void ride_breakdown_status_update(Ride* ride);
 static void ride_breakdown_update(Ride* ride);
 static void ride_call_closest_mechanic(Ride* ride);
@@ -1149,6 +1151,7 @@ void ride_remove_peeps(Ride* ride)
             peep->Invalidate();
             peep->state = PEEP_STATE_FALLING;
             peep->SwitchToSpecialSprite(0);
+            guest_summary_invalidate_guest(peep);
 
             peep->happiness = std::min(peep->happiness, peep->happiness_target) / 2;
             peep->happiness_target = peep->happiness;
@@ -2724,65 +2727,7 @@ Peep* ride_find_closest_mechanic(Ride* ride, int32_t forInspection)
     if (tileElement == nullptr)
         return nullptr;
 
-    // Set x,y to centre of the station exit for the mechanic search.
-    auto centreMapLocation = mapLocation.ToTileCentre();
-
-    return find_closest_mechanic(centreMapLocation.x, centreMapLocation.y, forInspection);
-}
-
-/**
- *
- *  rct2: 0x006B774B (forInspection = 0)
- *  rct2: 0x006B78C3 (forInspection = 1)
- */
-Peep* find_closest_mechanic(int32_t x, int32_t y, int32_t forInspection)
-{
-    uint32_t closestDistance, distance;
-    uint16_t spriteIndex;
-    Peep *peep, *closestMechanic = nullptr;
-
-    closestDistance = UINT_MAX;
-    FOR_ALL_STAFF (spriteIndex, peep)
-    {
-        if (peep->staff_type != STAFF_TYPE_MECHANIC)
-            continue;
-
-        if (!forInspection)
-        {
-            if (peep->state == PEEP_STATE_HEADING_TO_INSPECTION)
-            {
-                if (peep->sub_state >= 4)
-                    continue;
-            }
-            else if (peep->state != PEEP_STATE_PATROLLING)
-                continue;
-
-            if (!(peep->staff_orders & STAFF_ORDERS_FIX_RIDES))
-                continue;
-        }
-        else
-        {
-            if (peep->state != PEEP_STATE_PATROLLING || !(peep->staff_orders & STAFF_ORDERS_INSPECT_RIDES))
-                continue;
-        }
-
-        if (map_is_location_in_park({ x, y }))
-            if (!staff_is_location_in_patrol(peep, x & 0xFFE0, y & 0xFFE0))
-                continue;
-
-        if (peep->x == LOCATION_NULL)
-            continue;
-
-        // Manhattan distance
-        distance = std::abs(peep->x - x) + std::abs(peep->y - y);
-        if (distance < closestDistance)
-        {
-            closestDistance = distance;
-            closestMechanic = peep;
-        }
-    }
-
-    return closestMechanic;
+    return mechanic_dispatch_find_closest({ location.x, location.y, location.z }, forInspection);
 }
 
 Staff* ride_get_mechanic(Ride* ride)
@@ -7210,6 +7155,9 @@ void Ride::Delete()
     custom_name = {};
     measurement = {};
     type = RIDE_TYPE_NULL;
+    guest_summary_invalidate();
+    // The index may be reused for a ride with the same type, which must not find this ride's track
+    track_circuit_invalidate_ride(id);
 }
 
 void Ride::Renew()
@@ -24,6 +24,7 @@
 #include "../world/Footpath.h"
 #include "../world/Map.h"
 #include "../world/MapAnimation.h"
+#include "../world/MapAreaSummary.h"
 #include "../world/Park.h"
 #include "../world/Scenery.h"
 #include "../world/Surface.h"
@@ -32,6 +33,7 @@
 #include "RideGroupManager.h"
 #include "RideRatings.h"
 #include "Station.h"
+#include "TrackCircuit.h"
 #include "TrackData.h"
 #include "TrackDesign.h"
 
@@ -1280,6 +1282,7 @@ uint16_t TrackElement::GetTrackType() const
 
 void TrackElement::SetTrackType(uint16_t newType)
 {
+    track_circuit_invalidate_ride(RideIndex);
     TrackType = newType;
 }
 
@@ -1290,6 +1293,7 @@ uint8_t TrackElement::GetSequenceIndex() const
 
 void TrackElement::SetSequenceIndex(uint8_t newSequenceIndex)
 {
+    track_circuit_invalidate_ride(RideIndex);
     Sequence = newSequenceIndex;
 }
 
@@ -1332,6 +1336,9 @@ ride_idnew_t TrackElement::GetRideIndex() const
 
 void TrackElement::SetRideIndex(ride_idnew_t newRideIndex)
 {
+    map_area_summary_invalidate_element(reinterpret_cast<const TileElement*>(this));
+    track_circuit_invalidate_ride(RideIndex);
+    track_circuit_invalidate_ride(newRideIndex);
     RideIndex = newRideIndex;
 }
 
@@ -0,0 +1,261 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2019 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "TrackCircuit.h"
+
+#include "../world/Map.h"
+#include "Ride.h"
+#include "Track.h"
+
+#include <unordered_map>
+#include <vector>
+
+// The properties of a track element that track_block_get_next and track_block_get_previous look at
+struct TrackCircuitElementState
+{
+    uint8_t Type;
+    uint8_t Direction;
+    uint8_t BaseHeight;
+    bool IsGhost;
+    ride_idnew_t RideIndex;
+    track_type_t TrackType;
+    uint8_t Sequence;
+
+    bool operator==(const TrackCircuitElementState& other) const
+    {
+        return Type == other.Type && Direction == other.Direction && BaseHeight == other.BaseHeight
+            && IsGhost == other.IsGhost && RideIndex == other.RideIndex && TrackType == other.TrackType
+            && Sequence == other.Sequence;
+    }
+
+    bool operator!=(const TrackCircuitElementState& other) const
+    {
+        return !(*this == other);
+    }
+};
+
+struct TrackCircuitPiece
+{
+    TileElement* Element;
+    TrackCircuitElementState ElementState;
+    // Whether Element is the first element of its type on the tile, as map_get_track_element_at_of_type_seq returns
+    bool IsFirstOfType;
+
+    bool HasNext;
+    CoordsXYE Next;
+    int32_t NextZ;
+    int32_t NextDirection;
+    TrackCircuitElementState NextState;
+
+    bool HasPrevious;
+    track_begin_end Previous;
+    TrackCircuitElementState PreviousState;
+};
+
+struct TrackCircuit
+{
+    uint8_t RideType = RIDE_TYPE_NULL;
+    std::unordered_map<uint64_t, TrackCircuitPiece> Pieces;
+};
+
+static std::vector<TrackCircuit> _circuits;
+static bool _circuitsAreDirty = true;
+
+static TrackCircuitElementState track_circuit_get_state(const TileElement* tileElement)
+{
+    TrackCircuitElementState state = {};
+    state.Type = tileElement->GetType();
+    state.Direction = tileElement->GetDirection();
+    state.BaseHeight = tileElement->base_height;
+    state.IsGhost = tileElement->IsGhost();
+    auto trackElement = tileElement->AsTrack();
+    if (trackElement != nullptr)
+    {
+        state.RideIndex = trackElement->GetRideIndex();
+        state.TrackType = trackElement->GetTrackType();
+        state.Sequence = trackElement->GetSequenceIndex();
+    }
+    return state;
+}
+
+static uint64_t track_circuit_get_key(const CoordsXY& loc, uint8_t baseHeight, track_type_t trackType)
+{
+    auto tileLoc = TileCoordsXY(loc);
+    return (static_cast<uint64_t>(tileLoc.x & 0xFFFFF) << 44) | (static_cast<uint64_t>(tileLoc.y & 0xFFFFF) << 24)
+        | (static_cast<uint64_t>(baseHeight) << 16) | trackType;
+}
+
+void track_circuit_invalidate()
+{
+    _circuitsAreDirty = true;
+}
+
+void track_circuit_invalidate_ride(ride_idnew_t rideIndex)
+{
+    if (!_circuitsAreDirty && rideIndex < _circuits.size())
+    {
+        _circuits[rideIndex].Pieces.clear();
+    }
+}
+
+void track_circuit_invalidate_tile(const TileCoordsXY& loc)
+{
+    if (_circuitsAreDirty)
+        return;
+
+    const TileElement* tileElement = map_get_first_element_at(loc.ToCoordsXY());
+    if (tileElement == nullptr)
+        return;
+    do
+    {
+        track_circuit_invalidate_element(tileElement);
+    } while (!(tileElement++)->IsLastForTile());
+}
+
+void track_circuit_invalidate_element(const TileElement* tileElement)
+{
+    auto trackElement = tileElement->AsTrack();
+    if (trackElement != nullptr)
+    {
+        track_circuit_invalidate_ride(trackElement->GetRideIndex());
+    }
+}
+
+static TrackCircuit* track_circuit_get(ride_id_t rideIndex)
+{
+    if (_circuitsAreDirty)
+    {
+        _circuits.clear();
+        _circuits.resize(MAX_RIDES);
+        _circuitsAreDirty = false;
+    }
+
+    auto ride = get_ride(rideIndex);
+    if (ride == nullptr || rideIndex >= _circuits.size())
+        return nullptr;
+
+    // The track definitions of a piece depend on the ride type
+    auto& circuit = _circuits[rideIndex];
+    if (circuit.RideType != ride->type)
+    {
+        circuit.Pieces.clear();
+        circuit.RideType = ride->type;
+    }
+    return &circuit;
+}
+
+static TrackCircuitPiece* track_circuit_get_piece(const CoordsXY& loc, TileElement* tileElement)
+{
+    auto trackElement = tileElement->AsTrack();
+    if (trackElement == nullptr || trackElement->GetSequenceIndex() != 0)
+        return nullptr;
+
+    auto circuit = track_circuit_get(trackElement->GetRideIndex());
+    if (circuit == nullptr)
+        return nullptr;
+
+    auto state = track_circuit_get_state(tileElement);
+    auto& piece = circuit->Pieces[track_circuit_get_key(loc, state.BaseHeight, state.TrackType)];
+    if (piece.Element != tileElement || piece.ElementState != state)
+    {
+        piece = {};
+        piece.Element = tileElement;
+        piece.ElementState = state;
+    }
+    return &piece;
+}
+
+TileElement* track_circuit_get_element(const Ride* ride, const CoordsXYZ& trackPos, int32_t trackType)
+{
+    auto circuit = track_circuit_get(ride->id);
+    if (circuit != nullptr)
+    {
+        auto it = circuit->Pieces.find(track_circuit_get_key(trackPos, TileCoordsXYZ(trackPos).z, trackType));
+        if (it != circuit->Pieces.end())
+        {
+            const auto& piece = it->second;
+            if (piece.IsFirstOfType && track_circuit_get_state(piece.Element) == piece.ElementState)
+                return piece.Element;
+        }
+    }
+
+    auto tileElement = map_get_track_element_at_of_type_seq(trackPos, trackType, 0);
+    if (tileElement != nullptr)
+    {
+        auto trackElement = tileElement->AsTrack();
+        if (trackElement->GetRideIndex() == ride->id && trackElement->GetTrackType() == trackType)
+        {
+            auto piece = track_circuit_get_piece(trackPos, tileElement);
+            if (piece != nullptr)
+                piece->IsFirstOfType = true;
+        }
+    }
+    return tileElement;
+}
+
+bool track_circuit_get_next(CoordsXYE* input, CoordsXYE* output, int32_t* z, int32_t* direction)
+{
+    if (z == nullptr || direction == nullptr)
+        return track_block_get_next(input, output, z, direction);
+
+    auto piece = track_circuit_get_piece({ input->x, input->y }, input->element);
+    if (piece == nullptr)
+        return track_block_get_next(input, output, z, direction);
+
+    if (!piece->HasNext || track_circuit_get_state(piece->Next.element) != piece->NextState)
+    {
+        // Only found pieces are remembered, the caller gets the outputs of a failed search as they are
+        piece->HasNext = false;
+        if (!track_block_get_next(input, output, z, direction))
+            return false;
+
+        piece->HasNext = true;
+        piece->Next = *output;
+        piece->NextZ = *z;
+        piece->NextDirection = *direction;
+        piece->NextState = track_circuit_get_state(output->element);
+        return true;
+    }
+
+    *output = piece->Next;
+    *z = piece->NextZ;
+    *direction = piece->NextDirection;
+    return true;
+}
+
+bool track_circuit_get_previous(int32_t x, int32_t y, TileElement* tileElement, track_begin_end* outTrackBeginEnd)
+{
+    auto piece = track_circuit_get_piece({ x, y }, tileElement);
+    if (piece == nullptr)
+        return track_block_get_previous(x, y, tileElement, outTrackBeginEnd);
+
+    const auto& previous = piece->Previous;
+    if (!piece->HasPrevious || track_circuit_get_state(previous.begin_element) != piece->PreviousState)
+    {
+        piece->HasPrevious = false;
+        if (!track_block_get_previous(x, y, tileElement, outTrackBeginEnd))
+            return false;
+
+        piece->HasPrevious = true;
+        piece->Previous = *outTrackBeginEnd;
+        piece->PreviousState = track_circuit_get_state(outTrackBeginEnd->begin_element);
+        return true;
+    }
+
+    // Only copy what track_block_get_previous sets when it succeeds
+    outTrackBeginEnd->begin_x = previous.begin_x;
+    outTrackBeginEnd->begin_y = previous.begin_y;
+    outTrackBeginEnd->begin_z = previous.begin_z;
+    outTrackBeginEnd->begin_direction = previous.begin_direction;
+    outTrackBeginEnd->begin_element = previous.begin_element;
+    outTrackBeginEnd->end_x = previous.end_x;
+    outTrackBeginEnd->end_y = previous.end_y;
+    outTrackBeginEnd->end_direction = previous.end_direction;
+    return true;
+}
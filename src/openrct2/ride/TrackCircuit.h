@@ -0,0 +1,63 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2019 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "../common.h"
+#include "../world/Location.hpp"
+#include "RideTypes.h"
+
+struct CoordsXYE;
+struct Ride;
+struct TileElement;
+struct track_begin_end;
+
+/**
+ * The track circuit remembers, for each piece of a ride's track, the element of the piece and the pieces before and
+ * after it, so vehicles moving onto the next piece do not have to search the tile element lists every time. The
+ * results are always the same as those of map_get_track_element_at_of_type_seq, track_block_get_next and
+ * track_block_get_previous.
+ */
+
+/**
+ * Forgets the track pieces of all rides, for when the elements have been replaced in bulk.
+ */
+void track_circuit_invalidate();
+
+/**
+ * Forgets the track pieces of one ride, must be called whenever its track elements are added, removed or changed.
+ */
+void track_circuit_invalidate_ride(ride_idnew_t rideIndex);
+
+/**
+ * Forgets the track pieces of the rides with track on the tile, must be called before the elements of the tile are
+ * moved.
+ */
+void track_circuit_invalidate_tile(const TileCoordsXY& loc);
+
+/**
+ * Forgets the track pieces of the element's ride if the element is track.
+ */
+void track_circuit_invalidate_element(const TileElement* tileElement);
+
+/**
+ * Gets the first element of the ride's track piece of the given type at trackPos, see
+ * map_get_track_element_at_of_type_seq.
+ */
+TileElement* track_circuit_get_element(const Ride* ride, const CoordsXYZ& trackPos, int32_t trackType);
+
+/**
+ * Gets the track piece after the one at input, see track_block_get_next.
+ */
+bool track_circuit_get_next(CoordsXYE* input, CoordsXYE* output, int32_t* z, int32_t* direction);
+
+/**
+ * Gets the track piece before the one at x, y, see track_block_get_previous.
+ */
+bool track_circuit_get_previous(int32_t x, int32_t y, TileElement* tileElement, track_begin_end* outTrackBeginEnd);
@@ -50,6 +50,7 @@
 #include "../world/Scenery.h"
 #include "../world/SmallScenery.h"
 #include "../world/Surface.h"
+#include "../world/TileElementStorage.h"
 #include "../world/Wall.h"
 #include "Ride.h"
 #include "RideData.h"
@@ -65,9 +66,6 @@ using namespace OpenRCT2::Drawing;
 
 struct map_backup
 {
-    TileElement tile_elements[MAX_TILE_ELEMENTS];
-    TileElement* tile_pointers[MAX_TILE_TILE_ELEMENT_POINTERS];
-    TileElement* next_free_tile_element;
     uint16_t map_size_units;
     uint16_t map_size_units_minus_2;
     uint16_t map_size;
@@ -2066,17 +2064,14 @@ void track_design_draw_preview(TrackDesign* td6, uint8_t* pixels)
  */
 static map_backup* track_design_preview_backup_map()
 {
-    map_backup* backup = (map_backup*)malloc(sizeof(map_backup));
-    if (backup != nullptr)
-    {
-        std::memcpy(backup->tile_elements, gTileElements, sizeof(backup->tile_elements));
-        std::memcpy(backup->tile_pointers, gTileElementTilePointers, sizeof(backup->tile_pointers));
-        backup->next_free_tile_element = gNextFreeTileElement;
-        backup->map_size_units = gMapSizeUnits;
-        backup->map_size_units_minus_2 = gMapSizeMinus2;
-        backup->map_size = gMapSize;
-        backup->current_rotation = get_current_rotation();
-    }
+    // The elements are moved aside rather than copied, so they stay where they are in memory and the caches built
+    // from the map (footpath graph, area summaries, track circuits) remain valid once they are restored
+    map_backup* backup = new map_backup();
+    tile_element_storage_save();
+    backup->map_size_units = gMapSizeUnits;
+    backup->map_size_units_minus_2 = gMapSizeMinus2;
+    backup->map_size = gMapSize;
+    backup->current_rotation = get_current_rotation();
     return backup;
 }
 
@@ -2086,15 +2081,13 @@ static map_backup* track_design_preview_backup_map()
  */
 static void track_design_preview_restore_map(map_backup* backup)
 {
-    std::memcpy(gTileElements, backup->tile_elements, sizeof(backup->tile_elements));
-    std::memcpy(gTileElementTilePointers, backup->tile_pointers, sizeof(backup->tile_pointers));
-    gNextFreeTileElement = backup->next_free_tile_element;
+    tile_element_storage_restore();
     gMapSizeUnits = backup->map_size_units;
     gMapSizeMinus2 = backup->map_size_units_minus_2;
     gMapSize = backup->map_size;
     gCurrentRotation = backup->current_rotation;
 
-    free(backup);
+    delete backup;
 }
 
 /**
@@ -2109,20 +2102,21 @@ static void track_design_preview_clear_map()
     gMapSizeMinus2 = (264 * 32) - 2;
     gMapSize = 256;
 
-    for (int32_t i = 0; i < MAX_TILE_TILE_ELEMENT_POINTERS; i++)
-    {
-        TileElement* tile_element = &gTileElements[i];
-        tile_element->ClearAs(TILE_ELEMENT_TYPE_SURFACE);
-        tile_element->SetLastForTile(true);
-        tile_element->AsSurface()->SetSlope(TILE_ELEMENT_SLOPE_FLAT);
-        tile_element->AsSurface()->SetWaterHeight(0);
-        tile_element->AsSurface()->SetSurfaceStyle(TERRAIN_GRASS);
-        tile_element->AsSurface()->SetEdgeStyle(TERRAIN_EDGE_ROCK);
-        tile_element->AsSurface()->SetGrassLength(GRASS_LENGTH_CLEAR_0);
-        tile_element->AsSurface()->SetOwnership(OWNERSHIP_OWNED);
-        tile_element->AsSurface()->SetParkFences(0);
-    }
-    map_update_tile_pointers();
+    std::vector<TileElement> tileElements(MAX_TILE_TILE_ELEMENT_POINTERS);
+    for (auto& tileElement : tileElements)
+    {
+        tileElement.ClearAs(TILE_ELEMENT_TYPE_SURFACE);
+        tileElement.SetLastForTile(true);
+        tileElement.AsSurface()->SetSlope(TILE_ELEMENT_SLOPE_FLAT);
+        tileElement.AsSurface()->SetWaterHeight(0);
+        tileElement.AsSurface()->SetSurfaceStyle(TERRAIN_GRASS);
+        tileElement.AsSurface()->SetEdgeStyle(TERRAIN_EDGE_ROCK);
+        tileElement.AsSurface()->SetGrassLength(GRASS_LENGTH_CLEAR_0);
+        tileElement.AsSurface()->SetOwnership(OWNERSHIP_OWNED);
+        tileElement.AsSurface()->SetParkFences(0);
+    }
+    // This is only a temporary map, so the caches built from the park's map are kept
+    tile_element_storage_set_all(tileElements);
 }
 
 bool track_design_are_entrance_and_exit_placed()
@@ -38,6 +38,7 @@
 #include "RideData.h"
 #include "Station.h"
 #include "Track.h"
+#include "TrackCircuit.h"
 #include "TrackData.h"
 #include "VehicleData.h"
 
@@ -7944,8 +7945,8 @@ static bool vehicle_update_track_motion_forwards_get_new_track(
 
     _vehicleVAngleEndF64E36 = TrackDefinitions[trackType].vangle_end;
     _vehicleBankEndF64E37 = TrackDefinitions[trackType].bank_end;
-    TileElement* tileElement = map_get_track_element_at_of_type_seq(
-        { vehicle->track_x, vehicle->track_y, vehicle->track_z }, trackType, 0);
+    TileElement* tileElement = track_circuit_get_element(
+        ride, { vehicle->track_x, vehicle->track_y, vehicle->track_z }, trackType);
 
     if (tileElement == nullptr)
     {
@@ -8000,7 +8001,7 @@ static bool vehicle_update_track_motion_forwards_get_new_track(
 loc_6DB32A:
 {
     track_begin_end trackBeginEnd;
-    if (!track_block_get_previous(vehicle->track_x, vehicle->track_y, tileElement, &trackBeginEnd))
+    if (!track_circuit_get_previous(vehicle->track_x, vehicle->track_y, tileElement, &trackBeginEnd))
     {
         return false;
     }
@@ -8019,7 +8020,7 @@ loc_6DB358:
     xyElement.x = vehicle->track_x;
     xyElement.y = vehicle->track_y;
     xyElement.element = tileElement;
-    if (!track_block_get_next(&xyElement, &xyElement, &z, &direction))
+    if (!track_circuit_get_next(&xyElement, &xyElement, &z, &direction))
     {
         return false;
     }
@@ -8383,8 +8384,8 @@ static bool vehicle_update_track_motion_backwards_get_new_track(
 {
     _vehicleVAngleEndF64E36 = TrackDefinitions[trackType].vangle_start;
     _vehicleBankEndF64E37 = TrackDefinitions[trackType].bank_start;
-    TileElement* tileElement = map_get_track_element_at_of_type_seq(
-        { vehicle->track_x, vehicle->track_y, vehicle->track_z }, trackType, 0);
+    TileElement* tileElement = track_circuit_get_element(
+        ride, { vehicle->track_x, vehicle->track_y, vehicle->track_z }, trackType);
 
     if (tileElement == nullptr)
         return false;
@@ -8418,7 +8419,7 @@ static bool vehicle_update_track_motion_backwards_get_new_track(
     {
         // loc_6DBB7E:;
         track_begin_end trackBeginEnd;
-        if (!track_block_get_previous(x, y, tileElement, &trackBeginEnd))
+        if (!track_circuit_get_previous(x, y, tileElement, &trackBeginEnd))
         {
             return false;
         }
@@ -8465,7 +8466,7 @@ static bool vehicle_update_track_motion_backwards_get_new_track(
         input.x = x;
         input.y = y;
         input.element = tileElement;
-        if (!track_block_get_next(&input, &output, &outputZ, &direction))
+        if (!track_circuit_get_next(&input, &output, &outputZ, &direction))
         {
             return false;
         }
@@ -9446,6 +9447,83 @@ loc_6DD069:
     return regs.eax;
 }
 
+/**
+ * The fields of a train its acceleration is computed from. This is gathered per train rather than for all trains in a
+ * batch: a train's velocity and acceleration are read and written throughout its own update, and trains affect each
+ * other within the same tick through collisions and block brakes, so computing them in a separate stage would change
+ * the results.
+ */
+struct VehicleTrainPhysics
+{
+    int32_t NumCars;
+    int32_t TotalMass;
+    int32_t TotalAcceleration;
+    // Velocity of the head of the train
+    int32_t Velocity;
+};
+
+/**
+ * Gathers the fields of the cars of the train the acceleration depends on, so that it is computed from a single walk
+ * of the train.
+ */
+static VehicleTrainPhysics vehicle_get_train_physics(const Vehicle* head)
+{
+    VehicleTrainPhysics physics = {};
+    physics.Velocity = head->velocity;
+    for (const Vehicle* car = head;;)
+    {
+        physics.NumCars++;
+        physics.TotalMass += car->mass;
+        physics.TotalAcceleration += car->acceleration;
+
+        if (car->next_vehicle_on_train == SPRITE_INDEX_NULL)
+            break;
+        car = GET_VEHICLE(car->next_vehicle_on_train);
+    }
+    return physics;
+}
+
+/**
+ * Gets the acceleration of the train from the slope of the track under its cars, minus friction and air resistance.
+ *  rct2: 0x006DC144
+ */
+static int32_t vehicle_get_train_physics_acceleration(const VehicleTrainPhysics& physics)
+{
+    int32_t acceleration = (physics.TotalAcceleration / physics.NumCars) * 21;
+    if (acceleration < 0)
+    {
+        acceleration += 511;
+    }
+    acceleration >>= 9;
+
+    // Friction
+    int32_t velocity = physics.Velocity;
+    if (velocity < 0)
+    {
+        acceleration -= -((-velocity) >> 12);
+    }
+    else
+    {
+        acceleration -= velocity >> 12;
+    }
+
+    // Air resistance
+    int32_t drag = velocity >> 8;
+    drag *= drag;
+    if (velocity < 0)
+    {
+        drag = -drag;
+    }
+    drag >>= 4;
+    // OpenRCT2: vehicles from different track types can have  0 mass.
+    if (physics.TotalMass != 0)
+    {
+        drag /= physics.TotalMass;
+    }
+    acceleration -= drag;
+    return acceleration;
+}
+
 /**
  *
  *  rct2: 0x006DC1E4
@@ -9713,68 +9791,9 @@ int32_t vehicle_update_track_motion(Vehicle* vehicle, int32_t* outStation)
     vehicle = gCurrentVehicle;
 
     vehicleEntry = vehicle_get_vehicle_entry(vehicle);
-    // eax
-    int32_t totalAcceleration = 0;
-    // ebp
-    int32_t totalMass = 0;
-    // Not used
-    regs.dx = 0;
-    // ebx
-    int32_t numVehicles = 0;
-
-    for (;;)
-    {
-        numVehicles++;
-        // Not used?
-        regs.dx |= vehicle->update_flags;
-        totalMass += vehicle->mass;
-        totalAcceleration += vehicle->acceleration;
-
-        uint16_t spriteIndex = vehicle->next_vehicle_on_train;
-        if (spriteIndex == SPRITE_INDEX_NULL)
-        {
-            break;
-        }
-        vehicle = GET_VEHICLE(spriteIndex);
-    }
-
-    vehicle = gCurrentVehicle;
-    regs.eax = (totalAcceleration / numVehicles) * 21;
-    if (regs.eax < 0)
-    {
-        regs.eax += 511;
-    }
-    regs.eax >>= 9;
-    int32_t acceleration = regs.eax;
-    regs.eax = vehicle->velocity;
-    if (regs.eax < 0)
-    {
-        regs.eax = -regs.eax;
-        regs.eax >>= 12;
-        regs.eax = -regs.eax;
-    }
-    else
-    {
-        regs.eax >>= 12;
-    }
-
-    acceleration -= regs.eax;
-    regs.edx = vehicle->velocity;
-    regs.ebx = regs.edx;
-    regs.edx >>= 8;
-    regs.edx *= regs.edx;
-    if (regs.ebx < 0)
-    {
-        regs.edx = -regs.edx;
-    }
-    regs.edx >>= 4;
-    regs.eax = regs.edx;
-    // OpenRCT2: vehicles from different track types can have  0 mass.
-    if (totalMass != 0)
-    {
-        regs.eax = regs.eax / totalMass;
-    }
-    acceleration -= regs.eax;
+    auto physics = vehicle_get_train_physics(vehicle);
+    int32_t totalMass = physics.TotalMass;
+    int32_t acceleration = vehicle_get_train_physics_acceleration(physics);
 
     if (vehicleEntry->flags & VEHICLE_ENTRY_FLAG_POWERED)
     {
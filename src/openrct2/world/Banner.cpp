@@ -17,6 +17,7 @@
 #include "../localisation/Localisation.h"
 #include "../management/Finance.h"
 #include "../network/network.h"
+#include "../peep/FootpathGraph.h"
 #include "../ride/Ride.h"
 #include "../ride/Track.h"
 #include "../windows/Intent.h"
@@ -356,12 +357,14 @@ uint8_t BannerElement::GetAllowedEdges() const
 
 void BannerElement::SetAllowedEdges(uint8_t newEdges)
 {
+    footpath_graph_invalidate_element((const TileElement*)this);
     flags &= ~0b00001111;
     flags |= (newEdges & 0b00001111);
 }
 
 void BannerElement::ResetAllowedEdges()
 {
+    footpath_graph_invalidate_element((const TileElement*)this);
     flags |= 0b00001111;
 }
 
@@ -22,12 +22,14 @@
 #include "../object/ObjectList.h"
 #include "../object/ObjectManager.h"
 #include "../paint/VirtualFloor.h"
+#include "../peep/FootpathGraph.h"
 #include "../ride/Station.h"
 #include "../ride/Track.h"
 #include "../ride/TrackData.h"
 #include "../util/Util.h"
 #include "Map.h"
 #include "MapAnimation.h"
+#include "MapAreaSummary.h"
 #include "Park.h"
 #include "Sprite.h"
 #include "Surface.h"
@@ -1429,6 +1431,7 @@ bool PathElement::IsSloped() const
 
 void PathElement::SetSloped(bool isSloped)
 {
+    footpath_graph_invalidate_element((const TileElement*)this);
     entryIndex &= ~FOOTPATH_PROPERTIES_FLAG_IS_SLOPED;
     if (isSloped)
         entryIndex |= FOOTPATH_PROPERTIES_FLAG_IS_SLOPED;
@@ -1441,6 +1444,7 @@ Direction PathElement::GetSlopeDirection() const
 
 void PathElement::SetSlopeDirection(Direction newSlope)
 {
+    footpath_graph_invalidate_element((const TileElement*)this);
     entryIndex &= ~FOOTPATH_PROPERTIES_SLOPE_DIRECTION_MASK;
     entryIndex |= static_cast<uint8_t>(newSlope) & FOOTPATH_PROPERTIES_SLOPE_DIRECTION_MASK;
 }
@@ -1452,6 +1456,7 @@ bool PathElement::IsQueue() const
 
 void PathElement::SetIsQueue(bool isQueue)
 {
+    footpath_graph_invalidate_element((const TileElement*)this);
     type &= ~FOOTPATH_ELEMENT_TYPE_FLAG_IS_QUEUE;
     if (isQueue)
         type |= FOOTPATH_ELEMENT_TYPE_FLAG_IS_QUEUE;
@@ -1476,6 +1481,7 @@ bool PathElement::IsBroken() const
 
 void PathElement::SetIsBroken(bool isBroken)
 {
+    map_area_summary_invalidate_element(reinterpret_cast<const TileElement*>(this));
     if (isBroken)
     {
         flags |= TILE_ELEMENT_FLAG_BROKEN;
@@ -1548,6 +1554,7 @@ rct_scenery_entry* PathElement::GetAdditionEntry() const
 
 void PathElement::SetAddition(uint8_t newAddition)
 {
+    map_area_summary_invalidate_element(reinterpret_cast<const TileElement*>(this));
     additions &= ~FOOTPATH_PROPERTIES_ADDITIONS_TYPE_MASK;
     additions |= newAddition;
 }
@@ -1559,6 +1566,7 @@ bool PathElement::AdditionIsGhost() const
 
 void PathElement::SetAdditionIsGhost(bool isGhost)
 {
+    map_area_summary_invalidate_element(reinterpret_cast<const TileElement*>(this));
     additions &= ~FOOTPATH_ADDITION_FLAG_IS_GHOST;
     if (isGhost)
         additions |= FOOTPATH_ADDITION_FLAG_IS_GHOST;
@@ -2199,6 +2207,7 @@ ride_id_t PathElement::GetRideIndex() const
 
 void PathElement::SetRideIndex(ride_id_t newRideIndex)
 {
+    footpath_graph_invalidate_element((const TileElement*)this);
     rideIndex = newRideIndex;
 }
 
@@ -2219,6 +2228,7 @@ uint8_t PathElement::GetEdges() const
 
 void PathElement::SetEdges(uint8_t newEdges)
 {
+    footpath_graph_invalidate_element((const TileElement*)this);
     edges &= ~FOOTPATH_PROPERTIES_EDGES_EDGES_MASK;
     edges |= (newEdges & FOOTPATH_PROPERTIES_EDGES_EDGES_MASK);
 }
@@ -2241,6 +2251,7 @@ uint8_t PathElement::GetEdgesAndCorners() const
 
 void PathElement::SetEdgesAndCorners(uint8_t newEdgesAndCorners)
 {
+    footpath_graph_invalidate_element((const TileElement*)this);
     edges = newEdgesAndCorners;
 }
 
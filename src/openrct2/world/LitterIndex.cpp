@@ -0,0 +1,198 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2019 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "LitterIndex.h"
+
+#include "Map.h"
+#include "Sprite.h"
+
+#include <algorithm>
+#include <vector>
+
+static constexpr int32_t LITTER_INDEX_CHUNK_SIZE = 4 * COORDS_XY_STEP;
+static constexpr int32_t LITTER_INDEX_CHUNKS_PER_SIDE = MAXIMUM_MAP_SIZE_TECHNICAL * COORDS_XY_STEP
+    / LITTER_INDEX_CHUNK_SIZE;
+// The chunk of litter that is not on the map
+static constexpr uint32_t LITTER_INDEX_CHUNK_LOCATION_NULL = LITTER_INDEX_CHUNKS_PER_SIDE * LITTER_INDEX_CHUNKS_PER_SIDE;
+static constexpr uint32_t LITTER_INDEX_CHUNK_NONE = UINT32_MAX;
+
+struct LitterIndexEntry
+{
+    uint32_t Chunk = LITTER_INDEX_CHUNK_NONE;
+    // Litter is added to the front of the litter sprite list, so later litter comes first
+    int32_t Sequence;
+};
+
+static std::vector<std::vector<uint16_t>> _chunks;
+static std::vector<LitterIndexEntry> _entries;
+static uint32_t _numLitter;
+static int32_t _nextSequence;
+static bool _isDirty = true;
+
+static uint32_t litter_index_get_chunk(int32_t x, int32_t y)
+{
+    if (x == LOCATION_NULL)
+        return LITTER_INDEX_CHUNK_LOCATION_NULL;
+
+    int32_t chunkX = std::clamp(x / LITTER_INDEX_CHUNK_SIZE, 0, LITTER_INDEX_CHUNKS_PER_SIDE - 1);
+    int32_t chunkY = std::clamp(y / LITTER_INDEX_CHUNK_SIZE, 0, LITTER_INDEX_CHUNKS_PER_SIDE - 1);
+    return chunkY * LITTER_INDEX_CHUNKS_PER_SIDE + chunkX;
+}
+
+static uint32_t litter_index_get_chunk(const SpriteBase* sprite)
+{
+    if (sprite->linked_list_index != SPRITE_LIST_LITTER)
+        return LITTER_INDEX_CHUNK_NONE;
+
+    return litter_index_get_chunk(sprite->x, sprite->y);
+}
+
+void litter_index_invalidate()
+{
+    _isDirty = true;
+}
+
+static void litter_index_rebuild()
+{
+    _chunks.assign(LITTER_INDEX_CHUNK_LOCATION_NULL + 1, {});
+    _entries.assign(MAX_SPRITES, {});
+    _numLitter = 0;
+    _nextSequence = 1;
+
+    int32_t sequence = 0;
+    for (uint16_t spriteIndex = gSpriteListHead[SPRITE_LIST_LITTER]; spriteIndex != SPRITE_INDEX_NULL;
+         spriteIndex = get_sprite(spriteIndex)->generic.next)
+    {
+        auto chunk = litter_index_get_chunk(&get_sprite(spriteIndex)->generic);
+        _entries[spriteIndex] = { chunk, sequence-- };
+        _chunks[chunk].push_back(spriteIndex);
+        _numLitter++;
+    }
+    _isDirty = false;
+}
+
+static void litter_index_validate()
+{
+    // The count catches sprite lists that were changed without going through move_sprite_to_list
+    if (_isDirty || _numLitter != gSpriteListCount[SPRITE_LIST_LITTER])
+    {
+        litter_index_rebuild();
+    }
+}
+
+void litter_index_update(const SpriteBase* sprite)
+{
+    if (_isDirty || sprite->sprite_index >= _entries.size())
+        return;
+
+    auto& entry = _entries[sprite->sprite_index];
+    auto chunk = litter_index_get_chunk(sprite);
+    if (chunk == entry.Chunk)
+        return;
+
+    if (entry.Chunk != LITTER_INDEX_CHUNK_NONE)
+    {
+        auto& chunkSprites = _chunks[entry.Chunk];
+        auto it = std::find(chunkSprites.begin(), chunkSprites.end(), sprite->sprite_index);
+        if (it != chunkSprites.end())
+        {
+            *it = chunkSprites.back();
+            chunkSprites.pop_back();
+        }
+        _numLitter--;
+    }
+    if (chunk != LITTER_INDEX_CHUNK_NONE)
+    {
+        _chunks[chunk].push_back(sprite->sprite_index);
+        _numLitter++;
+        if (entry.Chunk == LITTER_INDEX_CHUNK_NONE)
+        {
+            entry.Sequence = _nextSequence++;
+        }
+    }
+    entry.Chunk = chunk;
+}
+
+template<typename TFunc> static void litter_index_visit(int32_t minX, int32_t minY, int32_t maxX, int32_t maxY, TFunc func)
+{
+    litter_index_validate();
+
+    int32_t minChunkX = std::clamp(minX / LITTER_INDEX_CHUNK_SIZE, 0, LITTER_INDEX_CHUNKS_PER_SIDE - 1);
+    int32_t minChunkY = std::clamp(minY / LITTER_INDEX_CHUNK_SIZE, 0, LITTER_INDEX_CHUNKS_PER_SIDE - 1);
+    int32_t maxChunkX = std::clamp(maxX / LITTER_INDEX_CHUNK_SIZE, 0, LITTER_INDEX_CHUNKS_PER_SIDE - 1);
+    int32_t maxChunkY = std::clamp(maxY / LITTER_INDEX_CHUNK_SIZE, 0, LITTER_INDEX_CHUNKS_PER_SIDE - 1);
+    for (int32_t chunkY = minChunkY; chunkY <= maxChunkY; chunkY++)
+    {
+        for (int32_t chunkX = minChunkX; chunkX <= maxChunkX; chunkX++)
+        {
+            for (auto spriteIndex : _chunks[chunkY * LITTER_INDEX_CHUNKS_PER_SIDE + chunkX])
+            {
+                func(spriteIndex, &get_sprite(spriteIndex)->litter);
+            }
+        }
+    }
+
+    // Litter off the map is measured the same way as the litter sprite list walks this replaces did
+    for (auto spriteIndex : _chunks[LITTER_INDEX_CHUNK_LOCATION_NULL])
+    {
+        func(spriteIndex, &get_sprite(spriteIndex)->litter);
+    }
+}
+
+Litter* litter_index_get_nearest(const CoordsXYZ& loc, int32_t maxDistance)
+{
+    Litter* nearestLitter = nullptr;
+    uint16_t nearestLitterDist = 0;
+    int32_t nearestLitterSequence = 0;
+    litter_index_visit(
+        loc.x - maxDistance, loc.y - maxDistance, loc.x + maxDistance, loc.y + maxDistance,
+        [&](uint16_t spriteIndex, Litter* litter) {
+            uint16_t distance = abs(litter->x - loc.x) + abs(litter->y - loc.y) + abs(litter->z - loc.z) * 4;
+            if (distance > maxDistance)
+                return;
+
+            int32_t sequence = _entries[spriteIndex].Sequence;
+            if (nearestLitter == nullptr || distance < nearestLitterDist
+                || (distance == nearestLitterDist && sequence > nearestLitterSequence))
+            {
+                nearestLitter = litter;
+                nearestLitterDist = distance;
+                nearestLitterSequence = sequence;
+            }
+        });
+    return nearestLitter;
+}
+
+int32_t litter_index_count_in_area(const CoordsXY& centre, int32_t radius)
+{
+    int32_t count = 0;
+    litter_index_visit(
+        centre.x - radius, centre.y - radius, centre.x + radius, centre.y + radius, [&](uint16_t, Litter* litter) {
+            int16_t dist_x = abs(litter->x - centre.x);
+            int16_t dist_y = abs(litter->y - centre.y);
+            if (std::max(dist_x, dist_y) <= radius)
+            {
+                count++;
+            }
+        });
+    return count;
+}
+
+bool litter_index_has_litter_on_tile(const CoordsXY& loc)
+{
+    litter_index_validate();
+
+    for (auto spriteIndex : _chunks[litter_index_get_chunk(loc.x, loc.y)])
+    {
+        const auto& litter = get_sprite(spriteIndex)->litter;
+        if (loc.x == LOCATION_NULL || ((litter.x & 0xFFE0) == (loc.x & 0xFFE0) && (litter.y & 0xFFE0) == (loc.y & 0xFFE0)))
+            return true;
+    }
+    return false;
+}
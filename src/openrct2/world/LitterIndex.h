@@ -0,0 +1,47 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2019 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "../common.h"
+#include "Location.hpp"
+
+struct Litter;
+struct SpriteBase;
+
+/**
+ * The litter index buckets the litter sprites by map area, so handymen and guests looking for nearby litter do not
+ * have to go through all of it. It is kept up to date by sprite_move and move_sprite_to_list.
+ */
+
+/**
+ * Forgets all litter, for when the sprites have been replaced in bulk (e.g. by loading a park).
+ */
+void litter_index_invalidate();
+
+/**
+ * Updates the index after the sprite has moved or has been moved to another sprite list.
+ */
+void litter_index_update(const SpriteBase* sprite);
+
+/**
+ * Gets the litter nearest to loc, measured as the distance along x and y plus four times the height difference, if
+ * it is at most maxDistance away. Of litter equally near, the one first in the litter sprite list is returned.
+ */
+Litter* litter_index_get_nearest(const CoordsXYZ& loc, int32_t maxDistance);
+
+/**
+ * Counts the litter at most radius away from centre along both x and y.
+ */
+int32_t litter_index_count_in_area(const CoordsXY& centre, int32_t radius);
+
+/**
+ * Gets whether there is litter on the tile containing loc.
+ */
+bool litter_index_has_litter_on_tile(const CoordsXY& loc);
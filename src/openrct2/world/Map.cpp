@@ -28,7 +28,6 @@
 #include "../audio/audio.h"
 #include "../config/Config.h"
 #include "../core/Guard.hpp"
-#include "../interface/Cursors.h"
 #include "../interface/Window.h"
 #include "../localisation/Date.h"
 #include "../localisation/Localisation.h"
@@ -36,8 +35,10 @@
 #include "../network/network.h"
 #include "../object/ObjectManager.h"
 #include "../object/TerrainSurfaceObject.h"
+#include "../peep/FootpathGraph.h"
 #include "../ride/RideData.h"
 #include "../ride/Track.h"
+#include "../ride/TrackCircuit.h"
 #include "../ride/TrackData.h"
 #include "../ride/TrackDesign.h"
 #include "../scenario/Scenario.h"
@@ -48,10 +49,13 @@
 #include "Footpath.h"
 #include "LargeScenery.h"
 #include "MapAnimation.h"
+#include "MapAreaSummary.h"
+#include "MapDirtyTiles.h"
 #include "Park.h"
 #include "Scenery.h"
 #include "SmallScenery.h"
 #include "Surface.h"
+#include "TileElementStorage.h"
 #include "TileInspector.h"
 #include "Wall.h"
 
@@ -98,12 +102,10 @@ int16_t gMapSize;
 int16_t gMapSizeMaxXY;
 int16_t gMapBaseZ;
 
-TileElement gTileElements[MAX_TILE_TILE_ELEMENT_POINTERS * 3];
 TileElement* gTileElementTilePointers[MAX_TILE_TILE_ELEMENT_POINTERS];
 std::vector<CoordsXY> gMapSelectionTiles;
 std::vector<PeepSpawn> gPeepSpawns;
 
-TileElement* gNextFreeTileElement;
 uint32_t gNextFreeTileElementPointerIndex;
 
 bool gLandMountainMode;
@@ -209,6 +211,8 @@ void map_set_tile_element(const TileCoordsXY& tilePos, TileElement* elements)
         log_error("Trying to access element outside of range");
         return;
     }
+    // Only used to draw temporary elements, which are swapped out again before anything else looks at the tile, so
+    // nothing cached from the map is forgotten
     gTileElementTilePointers[tilePos.x + tilePos.y * MAXIMUM_MAP_SIZE_TECHNICAL] = elements;
 }
 
@@ -286,21 +290,22 @@ void map_init(int32_t size)
 {
     gNextFreeTileElementPointerIndex = 0;
 
-    for (int32_t i = 0; i < MAX_TILE_TILE_ELEMENT_POINTERS; i++)
+    std::vector<TileElement> tileElements(MAX_TILE_TILE_ELEMENT_POINTERS);
+    for (auto& tileElement : tileElements)
     {
-        TileElement* tile_element = &gTileElements[i];
-        tile_element->ClearAs(TILE_ELEMENT_TYPE_SURFACE);
-        tile_element->SetLastForTile(true);
-        tile_element->base_height = 14;
-        tile_element->clearance_height = 14;
-        tile_element->AsSurface()->SetWaterHeight(0);
-        tile_element->AsSurface()->SetSlope(TILE_ELEMENT_SLOPE_FLAT);
-        tile_element->AsSurface()->SetGrassLength(GRASS_LENGTH_CLEAR_0);
-        tile_element->AsSurface()->SetOwnership(OWNERSHIP_UNOWNED);
-        tile_element->AsSurface()->SetParkFences(0);
-        tile_element->AsSurface()->SetSurfaceStyle(TERRAIN_GRASS);
-        tile_element->AsSurface()->SetEdgeStyle(TERRAIN_EDGE_ROCK);
+        tileElement.ClearAs(TILE_ELEMENT_TYPE_SURFACE);
+        tileElement.SetLastForTile(true);
+        tileElement.base_height = 14;
+        tileElement.clearance_height = 14;
+        tileElement.AsSurface()->SetWaterHeight(0);
+        tileElement.AsSurface()->SetSlope(TILE_ELEMENT_SLOPE_FLAT);
+        tileElement.AsSurface()->SetGrassLength(GRASS_LENGTH_CLEAR_0);
+        tileElement.AsSurface()->SetOwnership(OWNERSHIP_UNOWNED);
+        tileElement.AsSurface()->SetParkFences(0);
+        tileElement.AsSurface()->SetSurfaceStyle(TERRAIN_GRASS);
+        tileElement.AsSurface()->SetEdgeStyle(TERRAIN_EDGE_ROCK);
     }
+    map_set_tile_elements(tileElements);
 
     gGrassSceneryTileLoopPosition = 0;
     gWidePathTileLoopX = 0;
@@ -310,7 +315,6 @@ void map_init(int32_t size)
     gMapSize = size;
     gMapSizeMaxXY = size * 32 - 33;
     gMapBaseZ = 7;
-    map_update_tile_pointers();
     map_remove_out_of_range_elements();
     AutoCreateMapAnimations();
 
@@ -370,38 +374,36 @@ void map_count_remaining_land_rights()
  */
 void map_strip_ghost_flag_from_elements()
 {
-    for (auto& element : gTileElements)
+    for (auto tileElement : gTileElementTilePointers)
     {
-        element.SetGhost(false);
+        if (tileElement == nullptr)
+            continue;
+
+        do
+        {
+            tileElement->SetGhost(false);
+        } while (!(tileElement++)->IsLastForTile());
     }
 }
 
-/**
- *
- *  rct2: 0x0068AFFD
- */
-void map_update_tile_pointers()
+void map_set_tile_elements(const std::vector<TileElement>& tileElements)
 {
-    int32_t i, x, y;
+    footpath_graph_reset();
+    map_area_summary_invalidate_all();
+    map_dirty_tiles_mark_all();
+    track_circuit_invalidate();
 
-    for (i = 0; i < MAX_TILE_TILE_ELEMENT_POINTERS; i++)
-    {
-        gTileElementTilePointers[i] = TILE_UNDEFINED_TILE_ELEMENT;
-    }
+    tile_element_storage_set_all(tileElements);
+}
 
-    TileElement* tileElement = gTileElements;
-    TileElement** tile = gTileElementTilePointers;
-    for (y = 0; y < MAXIMUM_MAP_SIZE_TECHNICAL; y++)
-    {
-        for (x = 0; x < MAXIMUM_MAP_SIZE_TECHNICAL; x++)
-        {
-            *tile++ = tileElement;
-            while (!(tileElement++)->IsLastForTile())
-                ;
-        }
-    }
+std::vector<TileElement> map_get_tile_elements()
+{
+    return tile_element_storage_get_all();
+}
 
-    gNextFreeTileElement = tileElement;
+size_t map_get_tile_element_count()
+{
+    return tile_element_storage_get_count();
 }
 
 /**
@@ -925,25 +927,18 @@ bool map_is_location_at_edge(const CoordsXY& loc)
  */
 void tile_element_remove(TileElement* tileElement)
 {
-    // Replace Nth element by (N+1)th element.
-    // This loop will make tileElement point to the old last element position,
-    // after copy it to it's new position
-    if (!tileElement->IsLastForTile())
-    {
-        do
-        {
-            *tileElement = *(tileElement + 1);
-        } while (!(++tileElement)->IsLastForTile());
-    }
-
-    // Mark the latest element with the last element flag.
-    (tileElement - 1)->SetLastForTile(true);
-    tileElement->base_height = 0xFF;
+    map_area_summary_invalidate_element(tileElement);
 
-    if ((tileElement + 1) == gNextFreeTileElement)
+    TileCoordsXY loc;
+    if (tile_element_storage_get_tile(tileElement, &loc))
     {
-        gNextFreeTileElement--;
+        // The elements after the removed one move down
+        footpath_graph_invalidate_tile(loc);
+        map_dirty_tiles_mark(loc);
+        track_circuit_invalidate_tile(loc);
     }
+
+    tile_element_storage_remove(tileElement);
 }
 
 /**
@@ -1051,82 +1046,19 @@ void map_invalidate_selection_rect()
     }
 }
 
-/**
- *
- *  rct2: 0x0068B111
- */
-void map_reorganise_elements()
-{
-    context_setcurrentcursor(CURSOR_ZZZ);
-
-    TileElement* new_tile_elements = (TileElement*)malloc(
-        3 * (MAXIMUM_MAP_SIZE_TECHNICAL * MAXIMUM_MAP_SIZE_TECHNICAL) * sizeof(TileElement));
-    TileElement* new_elements_pointer = new_tile_elements;
-
-    if (new_tile_elements == nullptr)
-    {
-        log_fatal("Unable to allocate memory for map elements.");
-        return;
-    }
-
-    uint32_t num_elements;
-
-    for (int32_t y = 0; y < MAXIMUM_MAP_SIZE_TECHNICAL; y++)
-    {
-        for (int32_t x = 0; x < MAXIMUM_MAP_SIZE_TECHNICAL; x++)
-        {
-            TileElement* startElement = map_get_first_element_at(TileCoordsXY{ x, y }.ToCoordsXY());
-            if (startElement == nullptr)
-                continue;
-            TileElement* endElement = startElement;
-            while (!(endElement++)->IsLastForTile())
-                ;
-
-            num_elements = (uint32_t)(endElement - startElement);
-            std::memcpy(new_elements_pointer, startElement, num_elements * sizeof(TileElement));
-            new_elements_pointer += num_elements;
-        }
-    }
-
-    num_elements = (uint32_t)(new_elements_pointer - new_tile_elements);
-    std::memcpy(gTileElements, new_tile_elements, num_elements * sizeof(TileElement));
-    std::memset(
-        gTileElements + num_elements, 0,
-        (3 * (MAXIMUM_MAP_SIZE_TECHNICAL * MAXIMUM_MAP_SIZE_TECHNICAL) - num_elements) * sizeof(TileElement));
-
-    free(new_tile_elements);
-
-    map_update_tile_pointers();
-}
-
 /**
  *
  *  rct2: 0x0068B044
  *  Returns true on space available for more elements
- *  Reorganises the map elements to check for space
  */
 bool map_check_free_elements_and_reorganise(int32_t numElements)
 {
-    if (numElements != 0)
+    // Each tile grows on its own, the limit is only kept so parks can still be saved as SV6
+    if (numElements != 0 && tile_element_storage_get_count() + numElements > MAX_TILE_ELEMENTS)
     {
-        auto tileElementEnd = &gTileElements[MAX_TILE_ELEMENTS];
-
-        // Check if is there is room for the required number of elements
-        auto newTileElementEnd = gNextFreeTileElement + numElements;
-        if (newTileElementEnd > tileElementEnd)
-        {
-            // Defragment the map element list
-            map_reorganise_elements();
-
-            // Check if there is any room again
-            newTileElementEnd = gNextFreeTileElement + numElements;
-            if (newTileElementEnd > tileElementEnd)
-            {
-                // Not enough spare elements left :'(
-                gGameCommandErrorText = STR_ERR_LANDSCAPE_DATA_AREA_FULL;
-                return false;
-            }
-        }
+        // Not enough spare elements left :'(
+        gGameCommandErrorText = STR_ERR_LANDSCAPE_DATA_AREA_FULL;
+        return false;
     }
     return true;
 }
@@ -1137,65 +1069,52 @@ bool map_check_free_elements_and_reorganise(int32_t numElements)
  */
 TileElement* tile_element_insert(const TileCoordsXYZ& loc, int32_t occupiedQuadrants)
 {
-    TileElement *originalTileElement, *newTileElement, *insertedElement;
-    bool isLastForTile = false;
-
     if (!map_check_free_elements_and_reorganise(1))
     {
         log_error("Cannot insert new element");
         return nullptr;
     }
 
-    newTileElement = gNextFreeTileElement;
-    originalTileElement = gTileElementTilePointers[loc.y * MAXIMUM_MAP_SIZE_TECHNICAL + loc.x];
-
-    // Set tile index pointer to point to new element block
-    gTileElementTilePointers[loc.y * MAXIMUM_MAP_SIZE_TECHNICAL + loc.x] = newTileElement;
+    footpath_graph_invalidate_tile(loc);
+    // The elements of the tile can move to make room
+    track_circuit_invalidate_tile(loc);
 
-    // Copy all elements that are below the insert height
-    while (loc.z >= originalTileElement->base_height)
+    // The new element goes after all elements that are below the insert height
+    size_t position = 0;
+    bool isLastForTile = true;
+    const TileElement* tileElement = map_get_first_element_at(loc.ToCoordsXY());
+    if (tileElement != nullptr)
     {
-        // Copy over map element
-        *newTileElement = *originalTileElement;
-        originalTileElement->base_height = 255;
-        originalTileElement++;
-        newTileElement++;
-
-        if ((newTileElement - 1)->IsLastForTile())
+        do
         {
-            // No more elements above the insert element
-            (newTileElement - 1)->SetLastForTile(false);
-            isLastForTile = true;
-            break;
-        }
+            if (loc.z < tileElement->base_height)
+            {
+                isLastForTile = false;
+                break;
+            }
+            position++;
+        } while (!(tileElement++)->IsLastForTile());
     }
 
-    // Insert new map element
-    insertedElement = newTileElement;
-    newTileElement->type = 0;
-    newTileElement->base_height = loc.z;
-    newTileElement->flags = 0;
-    newTileElement->SetLastForTile(isLastForTile);
-    newTileElement->SetOccupiedQuadrants(occupiedQuadrants);
-    newTileElement->clearance_height = loc.z;
-    std::memset(&newTileElement->pad_04, 0, sizeof(newTileElement->pad_04));
-    std::memset(&newTileElement->pad_08, 0, sizeof(newTileElement->pad_08));
-    newTileElement++;
-
-    // Insert rest of map elements above insert height
-    if (!isLastForTile)
+    TileElement* insertedElement = tile_element_storage_insert(TileCoordsXY{ loc.x, loc.y }, position);
+    if (isLastForTile && position > 0)
     {
-        do
-        {
-            // Copy over map element
-            *newTileElement = *originalTileElement;
-            originalTileElement->base_height = 255;
-            originalTileElement++;
-            newTileElement++;
-        } while (!((newTileElement - 1)->IsLastForTile()));
+        // No more elements above the insert element
+        (insertedElement - 1)->SetLastForTile(false);
     }
 
-    gNextFreeTileElement = newTileElement;
+    // Insert new map element
+    insertedElement->type = 0;
+    insertedElement->base_height = loc.z;
+    insertedElement->flags = 0;
+    insertedElement->SetLastForTile(isLastForTile);
+    insertedElement->SetOccupiedQuadrants(occupiedQuadrants);
+    insertedElement->clearance_height = loc.z;
+    std::memset(&insertedElement->pad_04, 0, sizeof(insertedElement->pad_04));
+    std::memset(&insertedElement->pad_08, 0, sizeof(insertedElement->pad_08));
+
+    map_area_summary_invalidate_tile(TileCoordsXY{ loc.x, loc.y });
+    map_dirty_tiles_mark(TileCoordsXY{ loc.x, loc.y });
     return insertedElement;
 }
 
@@ -1475,6 +1394,8 @@ int32_t map_can_construct_at(const CoordsXYRangedZ& pos, QuarterTile bl)
     return map_can_construct_with_clear_at(pos, nullptr, bl, 0, nullptr, CREATE_CROSSING_MODE_NONE);
 }
 
+static_assert(MAX_TILE_TILE_ELEMENT_POINTERS <= 0x10000, "The grass and scenery tile loop position is saved as 16 bits");
+
 /**
  * Updates grass length, scenery age and jumping fountains.
  *
@@ -1492,8 +1413,9 @@ void map_update_tiles()
         int32_t x = 0;
         int32_t y = 0;
 
+        // The bits of the position alternate between x and y, so updates are spread over the whole map
         uint16_t interleaved_xy = gGrassSceneryTileLoopPosition;
-        for (int32_t i = 0; i < 8; i++)
+        for (int32_t i = 1; i < MAXIMUM_MAP_SIZE_TECHNICAL; i <<= 1)
         {
             x = (x << 1) | (interleaved_xy & 1);
             interleaved_xy >>= 1;
@@ -1510,7 +1432,7 @@ void map_update_tiles()
         }
 
         gGrassSceneryTileLoopPosition++;
-        gGrassSceneryTileLoopPosition &= 0xFFFF;
+        gGrassSceneryTileLoopPosition %= MAX_TILE_TILE_ELEMENT_POINTERS;
     }
 }
 
@@ -1982,6 +1904,7 @@ ScreenCoordsXY translate_3d_to_2d_with_z(int32_t rotation, const CoordsXYZ& pos)
 
 static void map_invalidate_tile_under_zoom(int32_t x, int32_t y, int32_t z0, int32_t z1, int32_t maxZoom)
 {
+    map_dirty_tiles_mark(TileCoordsXY{ CoordsXY{ x, y } });
     if (gOpenRCT2Headless)
         return;
 
@@ -0,0 +1,291 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2019 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "MapAreaSummary.h"
+
+#include "Footpath.h"
+#include "Map.h"
+#include "Scenery.h"
+#include "TileElementStorage.h"
+
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
+
+struct TileSummary
+{
+    uint16_t NumScenery;
+    uint16_t NumFountains;
+    uint16_t NumBrokenPathAdditions;
+    uint16_t NumInvalidPathAdditions;
+    bool HasTrack;
+    bool IsDirty;
+};
+
+static constexpr int32_t MAP_SIZE = MAXIMUM_MAP_SIZE_TECHNICAL;
+
+static std::vector<TileSummary> _tiles;
+// The rides with track on each tile that has any
+static std::unordered_map<uint32_t, std::bitset<MAX_RIDES>> _tileRides;
+static std::vector<uint32_t> _dirtyTiles;
+static bool _allTilesDirty = true;
+
+// A two dimensional Fenwick tree over the counts of the tiles, so that both changing a tile and summing an area take
+// O(log² n) time. Entries are indexed from 1, the counts wrap around when a tile's count goes down.
+static std::vector<MapAreaSummary> _countTree;
+
+static void map_area_summary_add(MapAreaSummary& summary, const MapAreaSummary& other)
+{
+    summary.NumScenery += other.NumScenery;
+    summary.NumFountains += other.NumFountains;
+    summary.NumBrokenPathAdditions += other.NumBrokenPathAdditions;
+    summary.NumInvalidPathAdditions += other.NumInvalidPathAdditions;
+}
+
+static void map_area_summary_subtract(MapAreaSummary& summary, const MapAreaSummary& other)
+{
+    summary.NumScenery -= other.NumScenery;
+    summary.NumFountains -= other.NumFountains;
+    summary.NumBrokenPathAdditions -= other.NumBrokenPathAdditions;
+    summary.NumInvalidPathAdditions -= other.NumInvalidPathAdditions;
+}
+
+static MapAreaSummary map_area_summary_get_counts(const TileSummary& tile)
+{
+    return { tile.NumScenery, tile.NumFountains, tile.NumBrokenPathAdditions, tile.NumInvalidPathAdditions };
+}
+
+void map_area_summary_invalidate_tile(const TileCoordsXY& loc)
+{
+    if (_allTilesDirty || loc.x < 0 || loc.y < 0 || loc.x >= MAP_SIZE || loc.y >= MAP_SIZE)
+        return;
+
+    uint32_t tileIndex = loc.y * MAP_SIZE + loc.x;
+    if (!_tiles[tileIndex].IsDirty)
+    {
+        _tiles[tileIndex].IsDirty = true;
+        _dirtyTiles.push_back(tileIndex);
+    }
+}
+
+void map_area_summary_invalidate_element(const TileElement* tileElement)
+{
+    // Elements outside of the map (e.g. when building track designs) have no tile
+    TileCoordsXY loc;
+    if (_allTilesDirty || !tile_element_storage_get_tile(tileElement, &loc))
+        return;
+
+    map_area_summary_invalidate_tile(loc);
+}
+
+void map_area_summary_invalidate_all()
+{
+    _allTilesDirty = true;
+    _dirtyTiles.clear();
+}
+
+static void map_area_summary_update_tile(uint32_t tileIndex)
+{
+    TileSummary summary = {};
+    std::bitset<MAX_RIDES> rides;
+
+    const TileElement* tileElement = gTileElementTilePointers[tileIndex];
+    if (tileElement != nullptr)
+    {
+        do
+        {
+            switch (tileElement->GetType())
+            {
+                case TILE_ELEMENT_TYPE_PATH:
+                {
+                    auto pathElement = tileElement->AsPath();
+                    if (!pathElement->HasAddition())
+                        break;
+
+                    auto scenery = pathElement->GetAdditionEntry();
+                    if (scenery == nullptr)
+                    {
+                        summary.NumInvalidPathAdditions++;
+                        break;
+                    }
+                    if (pathElement->AdditionIsGhost())
+                        break;
+
+                    if (scenery->path_bit.flags & (PATH_BIT_FLAG_JUMPING_FOUNTAIN_WATER | PATH_BIT_FLAG_JUMPING_FOUNTAIN_SNOW))
+                    {
+                        summary.NumFountains++;
+                    }
+                    else if (pathElement->IsBroken())
+                    {
+                        summary.NumBrokenPathAdditions++;
+                    }
+                    break;
+                }
+                case TILE_ELEMENT_TYPE_LARGE_SCENERY:
+                case TILE_ELEMENT_TYPE_SMALL_SCENERY:
+                    summary.NumScenery++;
+                    break;
+                case TILE_ELEMENT_TYPE_TRACK:
+                {
+                    auto rideIndex = tileElement->AsTrack()->GetRideIndex();
+                    if (rideIndex < rides.size())
+                    {
+                        rides[rideIndex] = true;
+                        summary.HasTrack = true;
+                    }
+                    break;
+                }
+            }
+        } while (!(tileElement++)->IsLastForTile());
+    }
+
+    auto& tile = _tiles[tileIndex];
+    if (!_countTree.empty())
+    {
+        auto delta = map_area_summary_get_counts(summary);
+        map_area_summary_subtract(delta, map_area_summary_get_counts(tile));
+        if (delta.NumScenery != 0 || delta.NumFountains != 0 || delta.NumBrokenPathAdditions != 0
+            || delta.NumInvalidPathAdditions != 0)
+        {
+            int32_t tileX = tileIndex % MAP_SIZE + 1;
+            int32_t tileY = tileIndex / MAP_SIZE + 1;
+            for (int32_t y = tileY; y <= MAP_SIZE; y += y & -y)
+            {
+                for (int32_t x = tileX; x <= MAP_SIZE; x += x & -x)
+                {
+                    map_area_summary_add(_countTree[y * (MAP_SIZE + 1) + x], delta);
+                }
+            }
+        }
+    }
+    tile = summary;
+
+    if (summary.HasTrack)
+        _tileRides[tileIndex] = rides;
+    else
+        _tileRides.erase(tileIndex);
+}
+
+/**
+ * Builds the Fenwick tree from the counts of all tiles in linear time, one dimension at a time.
+ */
+static void map_area_summary_build_count_tree()
+{
+    _countTree.assign((MAP_SIZE + 1) * (MAP_SIZE + 1), MapAreaSummary{});
+    for (int32_t y = 1; y <= MAP_SIZE; y++)
+    {
+        for (int32_t x = 1; x <= MAP_SIZE; x++)
+        {
+            _countTree[y * (MAP_SIZE + 1) + x] = map_area_summary_get_counts(_tiles[(y - 1) * MAP_SIZE + x - 1]);
+        }
+    }
+    for (int32_t y = 1; y <= MAP_SIZE; y++)
+    {
+        for (int32_t x = 1; x <= MAP_SIZE; x++)
+        {
+            int32_t parentX = x + (x & -x);
+            if (parentX <= MAP_SIZE)
+            {
+                map_area_summary_add(_countTree[y * (MAP_SIZE + 1) + parentX], _countTree[y * (MAP_SIZE + 1) + x]);
+            }
+        }
+    }
+    for (int32_t y = 1; y <= MAP_SIZE; y++)
+    {
+        int32_t parentY = y + (y & -y);
+        if (parentY > MAP_SIZE)
+            continue;
+        for (int32_t x = 1; x <= MAP_SIZE; x++)
+        {
+            map_area_summary_add(_countTree[parentY * (MAP_SIZE + 1) + x], _countTree[y * (MAP_SIZE + 1) + x]);
+        }
+    }
+}
+
+/**
+ * Gets the sum of the tiles with coordinates less than x and y.
+ */
+static MapAreaSummary map_area_summary_get_prefix(int32_t x, int32_t y)
+{
+    MapAreaSummary summary = {};
+    for (int32_t treeY = y; treeY > 0; treeY -= treeY & -treeY)
+    {
+        for (int32_t treeX = x; treeX > 0; treeX -= treeX & -treeX)
+        {
+            map_area_summary_add(summary, _countTree[treeY * (MAP_SIZE + 1) + treeX]);
+        }
+    }
+    return summary;
+}
+
+static void map_area_summary_update()
+{
+    if (_allTilesDirty)
+    {
+        _tiles.assign(MAX_TILE_TILE_ELEMENT_POINTERS, TileSummary{});
+        _tileRides.clear();
+        _countTree.clear();
+        for (uint32_t tileIndex = 0; tileIndex < MAX_TILE_TILE_ELEMENT_POINTERS; tileIndex++)
+        {
+            map_area_summary_update_tile(tileIndex);
+        }
+        map_area_summary_build_count_tree();
+        _dirtyTiles.clear();
+        _allTilesDirty = false;
+    }
+    else
+    {
+        // Only the entries of the tree that cover a changed tile are updated
+        for (auto tileIndex : _dirtyTiles)
+        {
+            map_area_summary_update_tile(tileIndex);
+        }
+        _dirtyTiles.clear();
+    }
+}
+
+MapAreaSummary map_area_summary_get(const TileCoordsXY& min, const TileCoordsXY& max)
+{
+    int32_t x1 = std::max(min.x, 0);
+    int32_t y1 = std::max(min.y, 0);
+    int32_t x2 = std::min(max.x, MAP_SIZE - 1) + 1;
+    int32_t y2 = std::min(max.y, MAP_SIZE - 1) + 1;
+    if (x1 >= x2 || y1 >= y2)
+        return {};
+
+    map_area_summary_update();
+
+    auto summary = map_area_summary_get_prefix(x2, y2);
+    map_area_summary_subtract(summary, map_area_summary_get_prefix(x1, y2));
+    map_area_summary_subtract(summary, map_area_summary_get_prefix(x2, y1));
+    map_area_summary_add(summary, map_area_summary_get_prefix(x1, y1));
+    return summary;
+}
+
+void map_area_summary_get_rides(const TileCoordsXY& min, const TileCoordsXY& max, std::bitset<MAX_RIDES>& rides)
+{
+    int32_t x1 = std::max(min.x, 0);
+    int32_t y1 = std::max(min.y, 0);
+    int32_t x2 = std::min(max.x, MAP_SIZE - 1);
+    int32_t y2 = std::min(max.y, MAP_SIZE - 1);
+
+    map_area_summary_update();
+
+    for (int32_t y = y1; y <= y2; y++)
+    {
+        for (int32_t x = x1; x <= x2; x++)
+        {
+            uint32_t tileIndex = y * MAP_SIZE + x;
+            if (_tiles[tileIndex].HasTrack)
+            {
+                rides |= _tileRides[tileIndex];
+            }
+        }
+    }
+}
@@ -0,0 +1,56 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2019 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "../common.h"
+#include "../ride/Ride.h"
+#include "Location.hpp"
+
+#include <bitset>
+
+struct TileElement;
+
+/**
+ * What guests can see in an area of the map, see peep_assess_surroundings.
+ */
+struct MapAreaSummary
+{
+    uint32_t NumScenery;
+    uint32_t NumFountains;
+    // Path additions that are broken (e.g. by vandals), not counting fountains
+    uint32_t NumBrokenPathAdditions;
+    // Path additions whose object is not loaded
+    uint32_t NumInvalidPathAdditions;
+};
+
+/**
+ * Marks the tile as changed, to be summarised again the next time an area containing it is queried.
+ */
+void map_area_summary_invalidate_tile(const TileCoordsXY& loc);
+
+/**
+ * Marks the tile of the given element as changed. Must be called before the element is removed.
+ */
+void map_area_summary_invalidate_element(const TileElement* tileElement);
+
+/**
+ * Marks all tiles as changed, for when the elements have been replaced or moved in bulk.
+ */
+void map_area_summary_invalidate_all();
+
+/**
+ * Gets the summary of the tiles from min to max (inclusive) in O(log² n) time, where n is the size of the map.
+ */
+MapAreaSummary map_area_summary_get(const TileCoordsXY& min, const TileCoordsXY& max);
+
+/**
+ * Adds the rides with track on the tiles from min to max (inclusive) to rides.
+ */
+void map_area_summary_get_rides(const TileCoordsXY& min, const TileCoordsXY& max, std::bitset<MAX_RIDES>& rides);
@@ -0,0 +1,95 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2019 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "MapDirtyTiles.h"
+
+#include "Map.h"
+#include "TileElementStorage.h"
+
+#include <bitset>
+
+static std::bitset<MAX_TILE_TILE_ELEMENT_POINTERS> _isTileDirty;
+static std::vector<uint32_t> _dirtyTiles;
+static bool _allTilesDirty = true;
+
+void map_dirty_tiles_mark(const TileCoordsXY& loc)
+{
+    if (_allTilesDirty || loc.x < 0 || loc.y < 0 || loc.x >= MAXIMUM_MAP_SIZE_TECHNICAL || loc.y >= MAXIMUM_MAP_SIZE_TECHNICAL)
+        return;
+
+    uint32_t tileIndex = loc.y * MAXIMUM_MAP_SIZE_TECHNICAL + loc.x;
+    if (!_isTileDirty[tileIndex])
+    {
+        _isTileDirty[tileIndex] = true;
+        _dirtyTiles.push_back(tileIndex);
+    }
+}
+
+void map_dirty_tiles_mark_element(const TileElement* tileElement)
+{
+    // Elements outside of the map (e.g. when building track designs) have no tile
+    TileCoordsXY loc;
+    if (_allTilesDirty || !tile_element_storage_get_tile(tileElement, &loc))
+        return;
+
+    map_dirty_tiles_mark(loc);
+}
+
+void map_dirty_tiles_mark_ride(ride_idnew_t rideIndex)
+{
+    if (_allTilesDirty)
+        return;
+
+    for (int32_t y = 0; y < MAXIMUM_MAP_SIZE_TECHNICAL; y++)
+    {
+        for (int32_t x = 0; x < MAXIMUM_MAP_SIZE_TECHNICAL; x++)
+        {
+            TileCoordsXY loc{ x, y };
+            const TileElement* tileElement = map_get_first_element_at(loc.ToCoordsXY());
+            if (tileElement == nullptr)
+                continue;
+            do
+            {
+                auto trackElement = tileElement->AsTrack();
+                auto entranceElement = tileElement->AsEntrance();
+                if ((trackElement != nullptr && trackElement->GetRideIndex() == rideIndex)
+                    || (entranceElement != nullptr && entranceElement->GetEntranceType() != ENTRANCE_TYPE_PARK_ENTRANCE
+                        && entranceElement->GetRideIndex() == rideIndex))
+                {
+                    map_dirty_tiles_mark(loc);
+                    break;
+                }
+            } while (!(tileElement++)->IsLastForTile());
+        }
+    }
+}
+
+void map_dirty_tiles_mark_all()
+{
+    _allTilesDirty = true;
+    _isTileDirty.reset();
+    _dirtyTiles.clear();
+}
+
+bool map_dirty_tiles_take(std::vector<TileCoordsXY>& outTiles)
+{
+    if (_allTilesDirty)
+    {
+        _allTilesDirty = false;
+        return false;
+    }
+
+    for (auto tileIndex : _dirtyTiles)
+    {
+        outTiles.emplace_back(tileIndex % MAXIMUM_MAP_SIZE_TECHNICAL, tileIndex / MAXIMUM_MAP_SIZE_TECHNICAL);
+        _isTileDirty[tileIndex] = false;
+    }
+    _dirtyTiles.clear();
+    return true;
+}
@@ -0,0 +1,51 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2019 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "../common.h"
+#include "../ride/RideTypes.h"
+#include "Location.hpp"
+
+#include <vector>
+
+struct TileElement;
+
+/**
+ * The dirty tiles are the tiles that have changed since they were last taken, so views of the whole map (e.g. the map
+ * window) only have to redraw those. Tiles are marked by the tile element insertion and removal functions, by
+ * SurfaceElement::SetOwnership and by map_invalidate_tile, which is called whenever a tile looks different.
+ */
+
+/**
+ * Marks the tile as changed.
+ */
+void map_dirty_tiles_mark(const TileCoordsXY& loc);
+
+/**
+ * Marks the tile of the element as changed, unless the element is not on the map.
+ */
+void map_dirty_tiles_mark_element(const TileElement* tileElement);
+
+/**
+ * Marks the tiles with the ride's track, entrances and exits as changed, for when the ride looks different (e.g. its
+ * type or colours have changed).
+ */
+void map_dirty_tiles_mark_ride(ride_idnew_t rideIndex);
+
+/**
+ * Marks all tiles as changed, for when the elements have been replaced in bulk.
+ */
+void map_dirty_tiles_mark_all();
+
+/**
+ * Adds the tiles that have changed since the last call to outTiles and forgets them. Returns false instead if all
+ * tiles have been marked, in which case outTiles is left as it is.
+ */
+bool map_dirty_tiles_take(std::vector<TileCoordsXY>& outTiles);
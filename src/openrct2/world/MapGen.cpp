@@ -226,8 +226,6 @@ void mapgen_generate(mapgen_settings* settings)
     // Place the trees
     if (settings->trees != 0)
         mapgen_place_trees();
-
-    map_reorganise_elements();
 }
 
 static void mapgen_place_tree(int32_t type, int32_t x, int32_t y)
@@ -18,8 +18,12 @@
 #include "../interface/Viewport.h"
 #include "../localisation/Date.h"
 #include "../localisation/Localisation.h"
+#include "../peep/GuestSummary.h"
+#include "../peep/MechanicDispatch.h"
 #include "../scenario/Scenario.h"
 #include "Fountain.h"
+#include "LitterIndex.h"
+#include "Map.h"
 
 #include <algorithm>
 #include <cmath>
@@ -31,9 +35,10 @@ static rct_sprite _spriteList[MAX_SPRITES];
 
 static bool _spriteFlashingList[MAX_SPRITES];
 
-#define SPATIAL_INDEX_LOCATION_NULL 0x10000
+static_assert(
+    SPATIAL_INDEX_SIZE == MAX_TILE_TILE_ELEMENT_POINTERS + 1, "The spatial index offsets are for the tiles of a 256x256 map");
 
-uint16_t gSpriteSpatialIndex[0x10001];
+uint16_t gSpriteSpatialIndex[SPATIAL_INDEX_SIZE];
 
 const rct_string_id litterNames[12] = { STR_LITTER_VOMIT,
                                         STR_LITTER_VOMIT,
@@ -207,6 +212,15 @@ void reset_sprite_spatial_index()
             spr->generic.next_in_quadrant = nextSpriteId;
         }
     }
+    sprite_lists_invalidate();
+}
+
+void sprite_lists_invalidate()
+{
+    litter_index_invalidate();
+    mechanic_dispatch_invalidate();
+    guest_summary_invalidate();
+    guest_ride_choices_invalidate();
 }
 
 static size_t GetSpatialIndexOffset(int32_t x, int32_t y)
@@ -222,7 +236,7 @@ static size_t GetSpatialIndexOffset(int32_t x, int32_t y)
         index = (flooredX << 3) | tileY;
     }
 
-    openrct2_assert(index < sizeof(gSpriteSpatialIndex), "GetSpatialIndexOffset out of range");
+    openrct2_assert(index < std::size(gSpriteSpatialIndex), "GetSpatialIndexOffset out of range");
     return index;
 }
 
@@ -415,6 +429,7 @@ rct_sprite* create_sprite(SPRITE_IDENTIFIER spriteIdentifier)
 
     sprite->next_in_quadrant = gSpriteSpatialIndex[SPATIAL_INDEX_LOCATION_NULL];
     gSpriteSpatialIndex[SPATIAL_INDEX_LOCATION_NULL] = sprite->sprite_index;
+    litter_index_update(sprite);
 
     return (rct_sprite*)sprite;
 }
@@ -468,6 +483,13 @@ void move_sprite_to_list(SpriteBase* sprite, SPRITE_LIST newListIndex)
     // Decrement old list counter, increment new list counter.
     gSpriteListCount[oldListIndex]--;
     gSpriteListCount[newListIndex]++;
+
+    litter_index_update(sprite);
+    if (oldListIndex == SPRITE_LIST_PEEP || newListIndex == SPRITE_LIST_PEEP)
+    {
+        mechanic_dispatch_invalidate();
+        guest_summary_invalidate_guest(sprite);
+    }
 }
 
 /**
@@ -667,6 +689,7 @@ void sprite_move(int16_t x, int16_t y, int16_t z, SpriteBase* sprite)
     {
         sprite_set_coordinates(x, y, z, sprite);
     }
+    litter_index_update(sprite);
 }
 
 void sprite_set_coordinates(int16_t x, int16_t y, int16_t z, SpriteBase* sprite)
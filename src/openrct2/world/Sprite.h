@@ -191,13 +191,21 @@ rct_sprite* get_sprite(size_t sprite_idx);
 
 extern uint16_t gSpriteListHead[6];
 extern uint16_t gSpriteListCount[6];
-extern uint16_t gSpriteSpatialIndex[0x10001];
+// The first sprite on each tile of a 256x256 map, followed by the first sprite that is not on the map
+#define SPATIAL_INDEX_SIZE 0x10001
+#define SPATIAL_INDEX_LOCATION_NULL 0x10000
+
+extern uint16_t gSpriteSpatialIndex[SPATIAL_INDEX_SIZE];
 
 extern const rct_string_id litterNames[12];
 
 rct_sprite* create_sprite(SPRITE_IDENTIFIER spriteIdentifier);
 void reset_sprite_list();
 void reset_sprite_spatial_index();
+// Forgets everything built from the sprite lists (litter index, mechanics, guest summary, guests waiting to choose a
+// ride), for when the sprites have been replaced without going through create_sprite and sprite_remove, e.g. when a park
+// is loaded
+void sprite_lists_invalidate();
 void sprite_clear_all_unused();
 void move_sprite_to_list(SpriteBase* sprite, SPRITE_LIST newList);
 void sprite_misc_update_all();
@@ -15,6 +15,7 @@
 #include "../scenario/Scenario.h"
 #include "Location.hpp"
 #include "Map.h"
+#include "MapDirtyTiles.h"
 
 uint32_t SurfaceElement::GetSurfaceStyle() const
 {
@@ -184,8 +185,14 @@ uint8_t SurfaceElement::GetOwnership() const
 
 void SurfaceElement::SetOwnership(uint8_t newOwnership)
 {
+    uint8_t oldOwnership = Ownership;
     Ownership &= ~TILE_ELEMENT_SURFACE_OWNERSHIP_MASK;
     Ownership |= (newOwnership & TILE_ELEMENT_SURFACE_OWNERSHIP_MASK);
+    // The map window shows land that is not owned darker
+    if (Ownership != oldOwnership)
+    {
+        map_dirty_tiles_mark_element(reinterpret_cast<const TileElement*>(this));
+    }
 }
 
 uint8_t SurfaceElement::GetParkFences() const
@@ -12,7 +12,9 @@
 #include "../core/Guard.hpp"
 #include "../interface/Window.h"
 #include "../localisation/Localisation.h"
+#include "../peep/FootpathGraph.h"
 #include "../ride/Track.h"
+#include "../ride/TrackCircuit.h"
 #include "Banner.h"
 #include "LargeScenery.h"
 #include "Scenery.h"
@@ -64,6 +66,17 @@ bool TileElementBase::IsGhost() const
 
 void TileElementBase::SetGhost(bool isGhost)
 {
+    if (IsGhost() != isGhost)
+    {
+        // Ghosts are left out of the footpath graph
+        auto elementType = GetType();
+        if (elementType == TILE_ELEMENT_TYPE_PATH || elementType == TILE_ELEMENT_TYPE_ENTRANCE
+            || elementType == TILE_ELEMENT_TYPE_TRACK)
+        {
+            footpath_graph_invalidate_element((const TileElement*)this);
+        }
+    }
+    track_circuit_invalidate_element((const TileElement*)this);
     if (isGhost)
     {
         this->flags |= TILE_ELEMENT_FLAG_GHOST;
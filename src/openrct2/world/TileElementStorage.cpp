@@ -0,0 +1,338 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2019 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "TileElementStorage.h"
+
+#include "../core/Guard.hpp"
+#include "Map.h"
+
+#include <algorithm>
+#include <array>
+#include <map>
+#include <memory>
+
+static constexpr int32_t TILE_ELEMENT_CHUNK_SIZE = 16;
+static constexpr int32_t TILE_ELEMENT_CHUNKS_PER_SIDE = MAXIMUM_MAP_SIZE_TECHNICAL / TILE_ELEMENT_CHUNK_SIZE;
+static constexpr size_t TILE_ELEMENT_PAGE_SIZE = 1024;
+// Blocks hold at least two elements, so a tile with only its surface can be built on without moving
+static constexpr uint8_t TILE_ELEMENT_MIN_SIZE_CLASS = 1;
+static constexpr size_t TILE_ELEMENT_NUM_SIZE_CLASSES = 32;
+
+struct TileElementPage
+{
+    std::unique_ptr<TileElement[]> Elements;
+    // The tile of the block each element was last allocated to
+    std::unique_ptr<uint32_t[]> Tiles;
+    size_t Capacity;
+    size_t Used;
+};
+
+struct TileElementBlock
+{
+    TileElementPage* Page;
+    size_t Offset;
+    // The block has room for 1 << SizeClass elements
+    uint8_t SizeClass;
+
+    TileElement* GetElements() const
+    {
+        return Page == nullptr ? nullptr : &Page->Elements[Offset];
+    }
+
+    size_t GetCapacity() const
+    {
+        return Page == nullptr ? 0 : size_t{ 1 } << SizeClass;
+    }
+};
+
+struct TileElementChunk
+{
+    std::vector<std::unique_ptr<TileElementPage>> Pages;
+    std::array<std::vector<TileElementBlock>, TILE_ELEMENT_NUM_SIZE_CLASSES> FreeBlocks;
+};
+
+static std::vector<TileElementChunk> _chunks;
+static std::vector<TileElementBlock> _blocks;
+// The pages of all chunks by the address of their first element, to find the tile of an element
+static std::map<const TileElement*, TileElementPage*> _pages;
+static size_t _numElements;
+
+struct SavedTileElementStorage
+{
+    std::vector<TileElementChunk> Chunks;
+    std::vector<TileElementBlock> Blocks;
+    std::map<const TileElement*, TileElementPage*> Pages;
+    size_t NumElements;
+    std::vector<TileElement*> TilePointers;
+};
+
+static std::unique_ptr<SavedTileElementStorage> _savedStorage;
+
+static uint32_t tile_element_storage_get_chunk(uint32_t tileIndex)
+{
+    uint32_t x = tileIndex % MAXIMUM_MAP_SIZE_TECHNICAL;
+    uint32_t y = tileIndex / MAXIMUM_MAP_SIZE_TECHNICAL;
+    return (y / TILE_ELEMENT_CHUNK_SIZE) * TILE_ELEMENT_CHUNKS_PER_SIDE + x / TILE_ELEMENT_CHUNK_SIZE;
+}
+
+static uint8_t tile_element_storage_get_size_class(size_t numElements)
+{
+    uint8_t sizeClass = TILE_ELEMENT_MIN_SIZE_CLASS;
+    while ((size_t{ 1 } << sizeClass) < numElements)
+    {
+        sizeClass++;
+    }
+    return sizeClass;
+}
+
+/**
+ * Splits the unused end of the page into blocks that can be reused, as blocks are only taken from the newest page.
+ */
+static void tile_element_storage_free_rest_of_page(TileElementChunk& chunk, TileElementPage& page)
+{
+    for (uint8_t sizeClass = TILE_ELEMENT_NUM_SIZE_CLASSES - 1; sizeClass >= TILE_ELEMENT_MIN_SIZE_CLASS; sizeClass--)
+    {
+        size_t capacity = size_t{ 1 } << sizeClass;
+        while (page.Capacity - page.Used >= capacity)
+        {
+            chunk.FreeBlocks[sizeClass].push_back({ &page, page.Used, sizeClass });
+            page.Used += capacity;
+        }
+    }
+}
+
+static TileElementBlock tile_element_storage_allocate(uint32_t tileIndex, uint8_t sizeClass)
+{
+    auto& chunk = _chunks[tile_element_storage_get_chunk(tileIndex)];
+    size_t capacity = size_t{ 1 } << sizeClass;
+
+    TileElementBlock block;
+    auto& freeBlocks = chunk.FreeBlocks[sizeClass];
+    if (!freeBlocks.empty())
+    {
+        block = freeBlocks.back();
+        freeBlocks.pop_back();
+    }
+    else
+    {
+        TileElementPage* page = chunk.Pages.empty() ? nullptr : chunk.Pages.back().get();
+        if (page == nullptr || page->Used + capacity > page->Capacity)
+        {
+            if (page != nullptr)
+            {
+                tile_element_storage_free_rest_of_page(chunk, *page);
+            }
+
+            auto newPage = std::make_unique<TileElementPage>();
+            newPage->Capacity = std::max(capacity, TILE_ELEMENT_PAGE_SIZE);
+            newPage->Used = 0;
+            newPage->Elements = std::make_unique<TileElement[]>(newPage->Capacity);
+            newPage->Tiles = std::make_unique<uint32_t[]>(newPage->Capacity);
+            page = newPage.get();
+            _pages[page->Elements.get()] = page;
+            chunk.Pages.push_back(std::move(newPage));
+        }
+        block = { page, page->Used, sizeClass };
+        page->Used += capacity;
+    }
+
+    std::fill_n(&block.Page->Tiles[block.Offset], capacity, tileIndex);
+    return block;
+}
+
+static void tile_element_storage_free(uint32_t tileIndex, const TileElementBlock& block)
+{
+    if (block.Page != nullptr)
+    {
+        _chunks[tile_element_storage_get_chunk(tileIndex)].FreeBlocks[block.SizeClass].push_back(block);
+    }
+}
+
+void tile_element_storage_set_all(const std::vector<TileElement>& elements)
+{
+    _chunks.clear();
+    _chunks.resize(TILE_ELEMENT_CHUNKS_PER_SIDE * TILE_ELEMENT_CHUNKS_PER_SIDE);
+    _pages.clear();
+    _blocks.assign(MAX_TILE_TILE_ELEMENT_POINTERS, {});
+    _numElements = 0;
+
+    size_t index = 0;
+    for (uint32_t tileIndex = 0; tileIndex < MAX_TILE_TILE_ELEMENT_POINTERS; tileIndex++)
+    {
+        if (index >= elements.size())
+        {
+            log_error("Tile elements end before tile %u", tileIndex);
+            std::fill(&gTileElementTilePointers[tileIndex], std::end(gTileElementTilePointers), nullptr);
+            break;
+        }
+
+        size_t end = index;
+        while (end < elements.size() - 1 && !elements[end].IsLastForTile())
+        {
+            end++;
+        }
+        size_t numElements = end + 1 - index;
+
+        // Leave room for one more element, as a tile being built on is likely to be built on again
+        auto& block = _blocks[tileIndex];
+        block = tile_element_storage_allocate(tileIndex, tile_element_storage_get_size_class(numElements + 1));
+        auto blockElements = block.GetElements();
+        std::copy_n(&elements[index], numElements, blockElements);
+        blockElements[numElements - 1].SetLastForTile(true);
+
+        gTileElementTilePointers[tileIndex] = blockElements;
+        _numElements += numElements;
+        index = end + 1;
+    }
+}
+
+std::vector<TileElement> tile_element_storage_get_all()
+{
+    std::vector<TileElement> elements;
+    elements.reserve(_numElements);
+    for (const TileElement* tileElement : gTileElementTilePointers)
+    {
+        if (tileElement == nullptr)
+            continue;
+
+        do
+        {
+            elements.push_back(*tileElement);
+        } while (!(tileElement++)->IsLastForTile());
+    }
+    return elements;
+}
+
+size_t tile_element_storage_get_count()
+{
+    return _numElements;
+}
+
+TileElement* tile_element_storage_insert(const TileCoordsXY& loc, size_t position)
+{
+    uint32_t tileIndex = loc.y * MAXIMUM_MAP_SIZE_TECHNICAL + loc.x;
+    auto& block = _blocks[tileIndex];
+
+    TileElement* firstElement = gTileElementTilePointers[tileIndex];
+    size_t numElements = 0;
+    if (firstElement != nullptr)
+    {
+        const TileElement* tileElement = firstElement;
+        do
+        {
+            numElements++;
+        } while (!(tileElement++)->IsLastForTile());
+    }
+    position = std::min(position, numElements);
+
+    TileElement* blockElements = block.GetElements();
+    if (firstElement == blockElements && numElements < block.GetCapacity())
+    {
+        std::copy_backward(blockElements + position, blockElements + numElements, blockElements + numElements + 1);
+    }
+    else
+    {
+        auto newBlock = tile_element_storage_allocate(tileIndex, tile_element_storage_get_size_class(numElements + 1));
+        auto newElements = newBlock.GetElements();
+        if (firstElement != nullptr)
+        {
+            std::copy(firstElement, firstElement + position, newElements);
+            std::copy(firstElement + position, firstElement + numElements, newElements + position + 1);
+        }
+
+        // A tile pointed elsewhere by map_set_tile_element may still be pointed back to its block, so keep that
+        if (firstElement == blockElements)
+        {
+            tile_element_storage_free(tileIndex, block);
+        }
+        block = newBlock;
+        blockElements = newElements;
+        gTileElementTilePointers[tileIndex] = blockElements;
+    }
+
+    _numElements++;
+    return &blockElements[position];
+}
+
+void tile_element_storage_remove(TileElement* tileElement)
+{
+    // Replace Nth element by (N+1)th element.
+    // This loop will make tileElement point to the old last element position,
+    // after copy it to it's new position
+    if (!tileElement->IsLastForTile())
+    {
+        do
+        {
+            *tileElement = *(tileElement + 1);
+        } while (!(++tileElement)->IsLastForTile());
+    }
+
+    // Mark the latest element with the last element flag.
+    (tileElement - 1)->SetLastForTile(true);
+    tileElement->base_height = 0xFF;
+
+    if (_numElements > 0)
+    {
+        _numElements--;
+    }
+}
+
+void tile_element_storage_save()
+{
+    Guard::Assert(_savedStorage == nullptr, "The tile element storage has already been saved");
+
+    // The pages are moved rather than copied, so the saved elements stay where they are
+    _savedStorage = std::make_unique<SavedTileElementStorage>();
+    _savedStorage->Chunks = std::move(_chunks);
+    _savedStorage->Blocks = std::move(_blocks);
+    _savedStorage->Pages = std::move(_pages);
+    _savedStorage->NumElements = _numElements;
+    _savedStorage->TilePointers.assign(std::begin(gTileElementTilePointers), std::end(gTileElementTilePointers));
+
+    _chunks.clear();
+    _blocks.clear();
+    _pages.clear();
+    _numElements = 0;
+}
+
+void tile_element_storage_restore()
+{
+    Guard::Assert(_savedStorage != nullptr, "The tile element storage has not been saved");
+
+    _chunks = std::move(_savedStorage->Chunks);
+    _blocks = std::move(_savedStorage->Blocks);
+    _pages = std::move(_savedStorage->Pages);
+    _numElements = _savedStorage->NumElements;
+    std::copy(_savedStorage->TilePointers.begin(), _savedStorage->TilePointers.end(), gTileElementTilePointers);
+    _savedStorage = nullptr;
+}
+
+bool tile_element_storage_get_tile(const TileElement* tileElement, TileCoordsXY* outLoc)
+{
+    auto it = _pages.upper_bound(tileElement);
+    if (it == _pages.begin())
+        return false;
+
+    const auto page = std::prev(it)->second;
+    size_t offset = tileElement - page->Elements.get();
+    if (offset >= page->Used)
+        return false;
+
+    uint32_t tileIndex = page->Tiles[offset];
+    const auto& block = _blocks[tileIndex];
+    if (block.Page != page || offset < block.Offset || offset >= block.Offset + block.GetCapacity())
+    {
+        // The element is in a free block
+        return false;
+    }
+
+    outLoc->x = tileIndex % MAXIMUM_MAP_SIZE_TECHNICAL;
+    outLoc->y = tileIndex / MAXIMUM_MAP_SIZE_TECHNICAL;
+    return true;
+}
@@ -0,0 +1,70 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2019 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "../common.h"
+#include "Location.hpp"
+
+#include <vector>
+
+struct TileElement;
+
+/**
+ * The tile element storage keeps the elements of each tile together in a block with room for the tile to grow, so
+ * inserting or removing an element only moves the elements of that tile. Blocks are allocated from the pages of the
+ * 16x16 tile chunk the tile is in, and blocks a tile has outgrown are reused by other tiles of the chunk. Pages are
+ * never moved or freed until the storage is replaced. gTileElementTilePointers points at the first element of each
+ * tile.
+ */
+
+/**
+ * Replaces all elements with the given ones, which are in tile order: the elements of tile (0, 0), ending with one
+ * that is last for its tile, then those of tile (1, 0) and so on.
+ */
+void tile_element_storage_set_all(const std::vector<TileElement>& elements);
+
+/**
+ * Gets a copy of all elements in tile order.
+ */
+std::vector<TileElement> tile_element_storage_get_all();
+
+/**
+ * Gets the number of elements on all tiles.
+ */
+size_t tile_element_storage_get_count();
+
+/**
+ * Makes room for an element at the given position among the elements of the tile, moving the tile's elements to a
+ * larger block if needed. The returned element still has to be initialised by the caller.
+ */
+TileElement* tile_element_storage_insert(const TileCoordsXY& loc, size_t position);
+
+/**
+ * Removes the element by moving the elements after it on its tile down.
+ */
+void tile_element_storage_remove(TileElement* tileElement);
+
+/**
+ * Moves all elements aside, leaving the storage empty until tile_element_storage_set_all is called, e.g. to draw a
+ * track design preview on a temporary map. The saved elements are not moved in memory, so pointers to them remain
+ * valid once they are restored.
+ */
+void tile_element_storage_save();
+
+/**
+ * Frees the current elements and brings back the ones moved aside by tile_element_storage_save.
+ */
+void tile_element_storage_restore();
+
+/**
+ * Gets the tile whose block holds the element, or returns false if the element is not in the storage (e.g. an element
+ * used when drawing construction previews).
+ */
+bool tile_element_storage_get_tile(const TileElement* tileElement, TileCoordsXY* outLoc);
@@ -0,0 +1,195 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2019 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <memory>
+#include <openrct2-ui/audio/AudioContext.h>
+#include <openrct2-ui/audio/AudioFormat.h>
+#include <openrct2/Context.h>
+#include <openrct2/OpenRCT2.h>
+#include <openrct2/audio/AudioChannel.h>
+#include <openrct2/audio/AudioMixer.h>
+#include <openrct2/audio/AudioSource.h>
+#include <openrct2/config/Config.h>
+#include <vector>
+
+using namespace OpenRCT2;
+using namespace OpenRCT2::Audio;
+
+/**
+ * A square wave, by default in the format the mixer renders, so it is mixed without being converted.
+ */
+class SquareWaveAudioSource final : public ISDLAudioSource
+{
+public:
+    static constexpr int16_t AMPLITUDE = 8192;
+
+private:
+    static constexpr size_t HALF_PERIOD_FRAMES = 50;
+
+    AudioFormat _format;
+    std::vector<int16_t> _samples;
+
+public:
+    SquareWaveAudioSource(size_t numFrames, int32_t freq = MIXER_OUTPUT_FREQUENCY, int32_t channels = MIXER_OUTPUT_CHANNELS)
+    {
+        _format.freq = freq;
+        _format.format = AUDIO_S16SYS;
+        _format.channels = channels;
+        _samples.resize(numFrames * channels);
+        for (size_t i = 0; i < _samples.size(); i++)
+        {
+            _samples[i] = ((i / channels) / HALF_PERIOD_FRAMES) % 2 == 0 ? AMPLITUDE : -AMPLITUDE;
+        }
+    }
+
+    uint64_t GetLength() const override
+    {
+        return _samples.size() * sizeof(int16_t);
+    }
+
+    size_t Read(void* dst, uint64_t offset, size_t len) override
+    {
+        size_t bytesToRead = 0;
+        if (offset < GetLength())
+        {
+            bytesToRead = (size_t)std::min<uint64_t>(len, GetLength() - offset);
+            std::copy_n((const uint8_t*)_samples.data() + offset, bytesToRead, (uint8_t*)dst);
+        }
+        return bytesToRead;
+    }
+
+    AudioFormat GetFormat() const override
+    {
+        return _format;
+    }
+
+    void Prefetch(uint64_t /*offset*/) override
+    {
+    }
+};
+
+class AudioMixerTests : public testing::Test
+{
+protected:
+    static constexpr size_t TICK_FRAMES = MIXER_OUTPUT_FREQUENCY / GAME_UPDATE_FPS;
+
+    std::unique_ptr<IContext> _context;
+    std::unique_ptr<IAudioMixer> _mixer;
+
+    void SetUp() override
+    {
+        gOpenRCT2Headless = true;
+        gOpenRCT2NoGraphics = true;
+        _context = CreateContext();
+
+        gConfigSound.master_sound_enabled = true;
+        gConfigSound.master_volume = 100;
+        gConfigSound.sound_enabled = true;
+        gConfigSound.sound_volume = 100;
+
+        // The sounds are loaded from the RCT2 data when there is any, they are not needed to play other sources
+        _mixer.reset(AudioMixer::Create());
+        _mixer->InitOffline();
+    }
+
+    void TearDown() override
+    {
+        _mixer->Close();
+        _mixer = nullptr;
+        _context = nullptr;
+    }
+
+    std::vector<int16_t> RenderTicks(size_t numTicks)
+    {
+        std::vector<int16_t> output(numTicks * TICK_FRAMES * MIXER_OUTPUT_CHANNELS);
+        for (size_t tick = 0; tick < numTicks; tick++)
+        {
+            _mixer->Render(output.data() + tick * TICK_FRAMES * MIXER_OUTPUT_CHANNELS, TICK_FRAMES);
+        }
+        return output;
+    }
+
+    static bool IsSilent(const std::vector<int16_t>& samples)
+    {
+        return std::all_of(samples.begin(), samples.end(), [](int16_t sample) { return sample == 0; });
+    }
+};
+
+TEST_F(AudioMixerTests, NoChannelsIsSilent)
+{
+    auto output = RenderTicks(4);
+    ASSERT_TRUE(IsSilent(output));
+}
+
+TEST_F(AudioMixerTests, PlayingChannelIsMixed)
+{
+    SquareWaveAudioSource source(MIXER_OUTPUT_FREQUENCY);
+    auto channel = _mixer->Play(&source, MIXER_LOOP_INFINITE, false, false);
+    ASSERT_NE(channel, nullptr);
+
+    // The first tick fades the channel in, so only the ticks after it play at full volume
+    RenderTicks(1);
+    auto output = RenderTicks(4);
+    ASSERT_FALSE(IsSilent(output));
+    auto peak = *std::max_element(output.begin(), output.end());
+    ASSERT_GT(peak, 0);
+    ASSERT_LE(peak, SquareWaveAudioSource::AMPLITUDE);
+
+    // Both sides are mixed the same when the channel is panned to the centre
+    for (size_t i = 0; i < output.size(); i += MIXER_OUTPUT_CHANNELS)
+    {
+        ASSERT_EQ(output[i], output[i + 1]);
+    }
+}
+
+TEST_F(AudioMixerTests, StoppedChannelIsSilent)
+{
+    SquareWaveAudioSource source(MIXER_OUTPUT_FREQUENCY);
+    auto channel = _mixer->Play(&source, MIXER_LOOP_INFINITE, false, false);
+    ASSERT_NE(channel, nullptr);
+    ASSERT_FALSE(IsSilent(RenderTicks(2)));
+
+    // The channel fades out over the next tick, then it is removed
+    _mixer->Stop(channel);
+    RenderTicks(1);
+    ASSERT_TRUE(IsSilent(RenderTicks(4)));
+}
+
+TEST_F(AudioMixerTests, FinishedChannelIsSilent)
+{
+    SquareWaveAudioSource source(TICK_FRAMES * 2);
+    auto channel = _mixer->Play(&source, MIXER_LOOP_NONE, true, false);
+    ASSERT_NE(channel, nullptr);
+
+    ASSERT_FALSE(IsSilent(RenderTicks(2)));
+    ASSERT_TRUE(IsSilent(RenderTicks(4)));
+}
+
+TEST_F(AudioMixerTests, MasterVolumeMutes)
+{
+    SquareWaveAudioSource source(MIXER_OUTPUT_FREQUENCY);
+    auto channel = _mixer->Play(&source, MIXER_LOOP_INFINITE, false, false);
+    ASSERT_NE(channel, nullptr);
+
+    gConfigSound.master_volume = 0;
+    ASSERT_TRUE(IsSilent(RenderTicks(4)));
+}
+
+TEST_F(AudioMixerTests, ConvertedChannelIsMixed)
+{
+    // Mono at another rate has to be converted to the mixer's format
+    SquareWaveAudioSource source(MIXER_OUTPUT_FREQUENCY * 2, MIXER_OUTPUT_FREQUENCY * 2, 1);
+    auto channel = _mixer->Play(&source, MIXER_LOOP_INFINITE, false, false);
+    ASSERT_NE(channel, nullptr);
+
+    RenderTicks(1);
+    ASSERT_FALSE(IsSilent(RenderTicks(4)));
+}
@@ -0,0 +1,196 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2019 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "TestData.h"
+
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <openrct2/Cheats.h>
+#include <openrct2/Context.h>
+#include <openrct2/Game.h>
+#include <openrct2/OpenRCT2.h>
+#include <openrct2/ParkImporter.h>
+#include <openrct2/core/MemoryStream.h>
+#include <openrct2/object/ObjectManager.h>
+#include <openrct2/rct2/S6Exporter.h>
+#include <openrct2/world/LitterIndex.h>
+#include <openrct2/world/Map.h>
+#include <openrct2/world/Sprite.h>
+#include <random>
+#include <vector>
+
+using namespace OpenRCT2;
+
+class LitterIndexTest : public testing::Test
+{
+protected:
+    static void SetUpTestCase()
+    {
+        std::string parkPath = TestData::GetParkPath("bpb.sv6");
+        gOpenRCT2Headless = true;
+        gOpenRCT2NoGraphics = true;
+        _context = CreateContext();
+        bool initialised = _context->Initialise();
+        ASSERT_TRUE(initialised);
+
+        load_from_sv6(parkPath.c_str());
+        game_load_init();
+        SUCCEED();
+    }
+
+    static void TearDownTestCase()
+    {
+        if (_context)
+            _context.reset();
+    }
+
+    static std::vector<CoordsXYZ> GetPathLocations()
+    {
+        std::vector<CoordsXYZ> locations;
+        for (int32_t y = 0; y < gMapSize; y++)
+        {
+            for (int32_t x = 0; x < gMapSize; x++)
+            {
+                auto loc = TileCoordsXY{ x, y }.ToCoordsXY();
+                const TileElement* tileElement = map_get_first_element_at(loc);
+                if (tileElement == nullptr)
+                    continue;
+                do
+                {
+                    if (tileElement->GetType() == TILE_ELEMENT_TYPE_PATH)
+                    {
+                        locations.push_back({ loc.x + 16, loc.y + 16, tileElement->GetBaseZ() });
+                    }
+                } while (!(tileElement++)->IsLastForTile());
+            }
+        }
+        return locations;
+    }
+
+    static void DropLitter(std::mt19937& random, const std::vector<CoordsXYZ>& pathLocations, int32_t count)
+    {
+        gCheatsDisableLittering = false;
+        std::uniform_int_distribution<size_t> locationDist(0, pathLocations.size() - 1);
+        std::uniform_int_distribution<int32_t> offsetDist(-12, 12);
+        for (int32_t i = 0; i < count; i++)
+        {
+            auto loc = pathLocations[locationDist(random)];
+            litter_create(loc.x + offsetDist(random), loc.y + offsetDist(random), loc.z, 0, i % 12);
+        }
+    }
+
+    // Goes through all litter, the way handymen looked for litter before the index
+    static Litter* GetNearestLitterBruteForce(const CoordsXYZ& loc, int32_t maxDistance)
+    {
+        Litter* nearestLitter = nullptr;
+        uint16_t nearestLitterDist = 0;
+        for (uint16_t spriteIndex = gSpriteListHead[SPRITE_LIST_LITTER]; spriteIndex != SPRITE_INDEX_NULL;)
+        {
+            Litter* litter = &get_sprite(spriteIndex)->litter;
+            spriteIndex = litter->next;
+
+            uint16_t distance = abs(litter->x - loc.x) + abs(litter->y - loc.y) + abs(litter->z - loc.z) * 4;
+            if (distance > maxDistance)
+                continue;
+            if (nearestLitter == nullptr || distance < nearestLitterDist)
+            {
+                nearestLitter = litter;
+                nearestLitterDist = distance;
+            }
+        }
+        return nearestLitter;
+    }
+
+    static int32_t CountLitterInAreaBruteForce(const CoordsXY& centre, int32_t radius)
+    {
+        int32_t count = 0;
+        for (uint16_t spriteIndex = gSpriteListHead[SPRITE_LIST_LITTER]; spriteIndex != SPRITE_INDEX_NULL;)
+        {
+            Litter* litter = &get_sprite(spriteIndex)->litter;
+            spriteIndex = litter->next;
+
+            if (std::max(abs(litter->x - centre.x), abs(litter->y - centre.y)) <= radius)
+                count++;
+        }
+        return count;
+    }
+
+    static void ExpectSameAsBruteForce(std::mt19937& random, const std::vector<CoordsXYZ>& pathLocations)
+    {
+        std::uniform_int_distribution<size_t> locationDist(0, pathLocations.size() - 1);
+        std::uniform_int_distribution<int32_t> offsetDist(-64, 64);
+        for (int32_t i = 0; i < 1000; i++)
+        {
+            auto loc = pathLocations[locationDist(random)];
+            loc.x += offsetDist(random);
+            loc.y += offsetDist(random);
+            for (int32_t maxDistance : { 0, 32, 160, 500 })
+            {
+                ASSERT_EQ(litter_index_get_nearest(loc, maxDistance), GetNearestLitterBruteForce(loc, maxDistance))
+                    << "at (" << loc.x << ", " << loc.y << ", " << loc.z << ") within " << maxDistance;
+            }
+            for (int32_t radius : { 16, 80, 256 })
+            {
+                ASSERT_EQ(litter_index_count_in_area(loc, radius), CountLitterInAreaBruteForce(loc, radius))
+                    << "around (" << loc.x << ", " << loc.y << ") within " << radius;
+            }
+        }
+    }
+
+    static std::shared_ptr<IContext> _context;
+};
+
+std::shared_ptr<IContext> LitterIndexTest::_context;
+
+TEST_F(LitterIndexTest, NearestLitterMatchesBruteForce)
+{
+    std::mt19937 random(0x12345678);
+    auto pathLocations = GetPathLocations();
+    ASSERT_FALSE(pathLocations.empty());
+
+    DropLitter(random, pathLocations, 300);
+    ASSERT_GT(gSpriteListCount[SPRITE_LIST_LITTER], 0);
+    ExpectSameAsBruteForce(random, pathLocations);
+
+    // Removing litter, as handymen do, has to take it out of the index
+    for (int32_t i = 0; i < 100 && gSpriteListHead[SPRITE_LIST_LITTER] != SPRITE_INDEX_NULL; i++)
+    {
+        sprite_remove(&get_sprite(gSpriteListHead[SPRITE_LIST_LITTER])->generic);
+    }
+    ExpectSameAsBruteForce(random, pathLocations);
+}
+
+TEST_F(LitterIndexTest, ImportedLitterMatchesBruteForce)
+{
+    std::mt19937 random(0x87654321);
+    auto pathLocations = GetPathLocations();
+    ASSERT_FALSE(pathLocations.empty());
+
+    DropLitter(random, pathLocations, 200);
+
+    MemoryStream stream;
+    auto& objManager = _context->GetObjectManager();
+    auto exporter = std::make_unique<S6Exporter>();
+    exporter->ExportObjectsList = objManager.GetPackableObjects();
+    exporter->Export();
+    exporter->SaveGame(&stream);
+
+    // Drop more litter and use the index, so the import has to replace everything the index knows
+    DropLitter(random, pathLocations, 100);
+    ExpectSameAsBruteForce(random, pathLocations);
+
+    // Network clients load the map like this, without resetting the sprite spatial index
+    stream.SetPosition(0);
+    auto importer = ParkImporter::CreateS6(_context->GetObjectRepository());
+    auto loadResult = importer->LoadFromStream(&stream, false);
+    objManager.LoadObjects(loadResult.RequiredObjects.data(), loadResult.RequiredObjects.size());
+    importer->Import();
+
+    ExpectSameAsBruteForce(random, pathLocations);
+}
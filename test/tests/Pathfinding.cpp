@@ -1,5 +1,6 @@
 #include "TestData.h"
 #include "openrct2/core/StringReader.hpp"
+#include "openrct2/peep/FootpathGraph.h"
 #include "openrct2/peep/Peep.h"
 #include "openrct2/ride/Station.h"
 #include "openrct2/scenario/Scenario.h"
@@ -7,8 +8,10 @@
 #include <gtest/gtest.h>
 #include <openrct2/Context.h>
 #include <openrct2/Game.h>
+#include <openrct2/GameState.h>
 #include <openrct2/OpenRCT2.h>
 #include <openrct2/ParkImporter.h>
+#include <openrct2/config/Config.h>
 #include <openrct2/platform/platform.h>
 #include <openrct2/world/Footpath.h>
 #include <openrct2/world/Map.h>
@@ -63,7 +66,8 @@ protected:
         return nullptr;
     }
 
-    static bool FindPath(TileCoordsXYZ* pos, const TileCoordsXYZ& goal, int expectedSteps, int targetRideID)
+    static bool FindPath(
+        TileCoordsXYZ* pos, const TileCoordsXYZ& goal, int expectedSteps, int targetRideID, bool useGuestQueueRules = false)
     {
         // Our start position is in tile coordinates, but we need to give the peep spawn
         // position in actual world coords (32 units per tile X/Y, 8 per Z level).
@@ -82,8 +86,15 @@ protected:
 
         // Pick the direction the peep should initially move in, given the goal position.
         // This will also store the goal position and initialize pathfinding data for the peep.
-        gPeepPathFindGoalPosition = goal;
-        const Direction moveDir = peep_pathfind_choose_direction(*pos, peep);
+        PathfindContext context;
+        context.GoalPosition = goal;
+        if (useGuestQueueRules)
+        {
+            // Search the way guest_path_finding does for a guest heading for the ride
+            context.IgnoreForeignQueues = true;
+            context.QueueRideIndex = targetRideID;
+        }
+        const Direction moveDir = peep_pathfind_choose_direction(*pos, peep, context);
         if (moveDir == INVALID_DIRECTION)
         {
             // Couldn't determine a direction to move off in
@@ -213,6 +224,41 @@ TEST_P(SimplePathfindingTest, CanFindPathFromStartToGoal)
     EXPECT_TRUE(succeeded);
 }
 
+TEST_P(SimplePathfindingTest, CanFindPathFromStartToGoalWithGuestQueueRules)
+{
+    const SimplePathfindingScenario& scenario = GetParam();
+
+    ASSERT_PRED_FORMAT1(AssertIsStartPosition, scenario.start);
+    TileCoordsXYZ pos = scenario.start;
+
+    auto ride = FindRideByName(scenario.name);
+    ASSERT_NE(ride, nullptr);
+
+    auto entrancePos = ride_get_entrance_location(ride, 0);
+    TileCoordsXYZ goal = TileCoordsXYZ(
+        entrancePos.x - TileDirectionDelta[entrancePos.direction].x,
+        entrancePos.y - TileDirectionDelta[entrancePos.direction].y, entrancePos.z);
+
+    EXPECT_TRUE(FindPath(&pos, goal, scenario.steps, ride->id, true))
+        << "Failed to find path from " << scenario.start << " to " << goal << " in " << scenario.steps << " steps; reached "
+        << pos << " before giving up.";
+}
+
+TEST_P(SimplePathfindingTest, FootpathGraphCanReachGoal)
+{
+    const SimplePathfindingScenario& scenario = GetParam();
+
+    auto ride = FindRideByName(scenario.name);
+    ASSERT_NE(ride, nullptr);
+
+    auto entrancePos = ride_get_entrance_location(ride, 0);
+    TileCoordsXYZ goal = TileCoordsXYZ(
+        entrancePos.x - TileDirectionDelta[entrancePos.direction].x,
+        entrancePos.y - TileDirectionDelta[entrancePos.direction].y, entrancePos.z);
+
+    EXPECT_NE(footpath_graph_get_distance(scenario.start, goal, ride->id), FOOTPATH_GRAPH_UNREACHABLE);
+}
+
 INSTANTIATE_TEST_CASE_P(
     ForScenario, SimplePathfindingTest,
     ::testing::Values(
@@ -246,6 +292,38 @@ TEST_P(ImpossiblePathfindingTest, CannotFindPathFromStartToGoal)
     EXPECT_FALSE(FindPath(&pos, goal, 10000, ride->id));
 }
 
+TEST_P(ImpossiblePathfindingTest, CannotFindPathFromStartToGoalWithGuestQueueRules)
+{
+    const SimplePathfindingScenario& scenario = GetParam();
+    TileCoordsXYZ pos = scenario.start;
+    ASSERT_PRED_FORMAT1(AssertIsStartPosition, scenario.start);
+
+    auto ride = FindRideByName(scenario.name);
+    ASSERT_NE(ride, nullptr);
+
+    auto entrancePos = ride_get_entrance_location(ride, 0);
+    TileCoordsXYZ goal = TileCoordsXYZ(
+        entrancePos.x + TileDirectionDelta[entrancePos.direction].x,
+        entrancePos.y + TileDirectionDelta[entrancePos.direction].y, entrancePos.z);
+
+    EXPECT_FALSE(FindPath(&pos, goal, 10000, ride->id, true));
+}
+
+TEST_P(ImpossiblePathfindingTest, FootpathGraphCannotReachGoal)
+{
+    const SimplePathfindingScenario& scenario = GetParam();
+
+    auto ride = FindRideByName(scenario.name);
+    ASSERT_NE(ride, nullptr);
+
+    auto entrancePos = ride_get_entrance_location(ride, 0);
+    TileCoordsXYZ goal = TileCoordsXYZ(
+        entrancePos.x + TileDirectionDelta[entrancePos.direction].x,
+        entrancePos.y + TileDirectionDelta[entrancePos.direction].y, entrancePos.z);
+
+    EXPECT_EQ(footpath_graph_get_distance(scenario.start, goal, ride->id), FOOTPATH_GRAPH_UNREACHABLE);
+}
+
 INSTANTIATE_TEST_CASE_P(
     ForScenario, ImpossiblePathfindingTest,
     ::testing::Values(
@@ -253,3 +331,76 @@ INSTANTIATE_TEST_CASE_P(
         SimplePathfindingScenario("PathWithFences", { 11, 6, 14 }, 10000),
         SimplePathfindingScenario("PathWithCliff", { 7, 17, 14 }, 10000)),
     SimplePathfindingScenario::ToName);
+
+class PrecomputedPathfindingTest : public testing::Test
+{
+protected:
+    static constexpr uint32_t TicksToRun = 500;
+
+    /**
+     * Runs the park and returns a hash of the guests' positions and pathfinding state after every tick.
+     */
+    static std::vector<uint32_t> RunGuests(bool precomputeSearches, uint32_t* outPrecomputedSearches)
+    {
+        core_init();
+
+        gOpenRCT2Headless = true;
+        gOpenRCT2NoGraphics = true;
+        auto context = CreateContext();
+        EXPECT_TRUE(context->Initialise());
+
+        std::string parkPath = TestData::GetParkPath("bpb.sv6");
+        load_from_sv6(parkPath.c_str());
+        game_load_init();
+
+        // Searches are only run ahead of the guest updates with multithreading, and not with the footpath graph
+        bool multithreading = gConfigGeneral.multithreading;
+        bool footpathGraphPathfinding = gConfigGeneral.footpath_graph_pathfinding;
+        gConfigGeneral.multithreading = precomputeSearches;
+        gConfigGeneral.footpath_graph_pathfinding = false;
+
+        std::vector<uint32_t> hashes;
+        *outPrecomputedSearches = 0;
+        for (uint32_t i = 0; i < TicksToRun; i++)
+        {
+            context->GetGameState()->UpdateLogic();
+            *outPrecomputedSearches += peep_update_all_get_stats().PrecomputedPathfindSearches;
+
+            uint32_t hash = 27;
+            uint16_t spriteIndex;
+            Peep* peep;
+            FOR_ALL_GUESTS (spriteIndex, peep)
+            {
+                for (int32_t value : { (int32_t)peep->sprite_index, (int32_t)peep->x, (int32_t)peep->y, (int32_t)peep->z,
+                                       (int32_t)peep->direction, (int32_t)peep->state, (int32_t)peep->destination_x,
+                                       (int32_t)peep->destination_y, (int32_t)peep->guest_heading_to_ride_id,
+                                       (int32_t)peep->pathfind_goal.x, (int32_t)peep->pathfind_goal.y })
+                {
+                    hash = (13 * hash) + (uint32_t)value;
+                }
+            }
+            hashes.push_back(hash);
+        }
+
+        gConfigGeneral.multithreading = multithreading;
+        gConfigGeneral.footpath_graph_pathfinding = footpathGraphPathfinding;
+        return hashes;
+    }
+};
+
+TEST_F(PrecomputedPathfindingTest, GuestsMoveTheSameWithPrecomputedSearches)
+{
+    uint32_t serialSearches;
+    auto serialHashes = RunGuests(false, &serialSearches);
+    ASSERT_EQ(serialSearches, 0u);
+
+    uint32_t precomputedSearches;
+    auto precomputedHashes = RunGuests(true, &precomputedSearches);
+    ASSERT_GT(precomputedSearches, 0u);
+
+    ASSERT_EQ(serialHashes.size(), precomputedHashes.size());
+    for (size_t i = 0; i < serialHashes.size(); i++)
+    {
+        ASSERT_EQ(serialHashes[i], precomputedHashes[i]) << "Guests diverged after " << (i + 1) << " ticks";
+    }
+}
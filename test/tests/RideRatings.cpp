@@ -14,18 +14,46 @@
 #include <openrct2/Game.h>
 #include <openrct2/OpenRCT2.h>
 #include <openrct2/audio/AudioContext.h>
+#include <openrct2/config/Config.h>
 #include <openrct2/core/File.h>
 #include <openrct2/core/Path.hpp>
 #include <openrct2/core/String.hpp>
 #include <openrct2/platform/platform.h>
 #include <openrct2/ride/Ride.h>
+#include <openrct2/ride/RideRatings.h>
 #include <string>
+#include <vector>
 
 using namespace OpenRCT2;
 
 class RideRatings : public testing::Test
 {
 protected:
+    std::unique_ptr<IContext> _context;
+
+    void SetUp() override
+    {
+        std::string path = TestData::GetParkPath("bpb.sv6");
+
+        gOpenRCT2Headless = true;
+        gOpenRCT2NoGraphics = true;
+
+        core_init();
+        _context = CreateContext();
+        bool initialised = _context->Initialise();
+        ASSERT_TRUE(initialised);
+
+        load_from_sv6(path.c_str());
+
+        // Check ride count to check load was successful
+        ASSERT_EQ(ride_get_count(), 134);
+    }
+
+    void TearDown() override
+    {
+        _context = nullptr;
+    }
+
     void CalculateRatingsForAllRides()
     {
         for (const auto& ride : GetRideManager())
@@ -34,6 +62,21 @@ protected:
         }
     }
 
+    void CalculateRatingsForAllRidesTogether()
+    {
+        std::vector<ride_id_t> rides;
+        for (const auto& ride : GetRideManager())
+        {
+            rides.push_back(ride.id);
+        }
+
+        // Rate the rides on the job pool
+        bool multithreading = gConfigGeneral.multithreading;
+        gConfigGeneral.multithreading = true;
+        ride_ratings_update_rides(rides);
+        gConfigGeneral.multithreading = multithreading;
+    }
+
     void DumpRatings()
     {
         for (const auto& ride : GetRideManager())
@@ -43,6 +86,23 @@ protected:
         }
     }
 
+    void CheckRatings()
+    {
+        // Load expected ratings
+        auto expectedDataPath = Path::Combine(TestData::GetBasePath(), "ratings", "bpb.sv6.txt");
+        auto expectedRatings = File::ReadAllLines(expectedDataPath);
+
+        size_t expI = 0;
+        for (const auto& ride : GetRideManager())
+        {
+            auto actual = FormatRatings(ride);
+            auto expected = expectedRatings[expI];
+            ASSERT_STREQ(actual.c_str(), expected.c_str());
+
+            expI++;
+        }
+    }
+
     std::string FormatRatings(const Ride& ride)
     {
         rating_tuple ratings = ride.ratings;
@@ -55,35 +115,12 @@ protected:
 
 TEST_F(RideRatings, all)
 {
-    std::string path = TestData::GetParkPath("bpb.sv6");
-
-    gOpenRCT2Headless = true;
-    gOpenRCT2NoGraphics = true;
-
-    core_init();
-    auto context = CreateContext();
-    bool initialised = context->Initialise();
-    ASSERT_TRUE(initialised);
-
-    load_from_sv6(path.c_str());
-
-    // Check ride count to check load was successful
-    ASSERT_EQ(ride_get_count(), 134);
-
     CalculateRatingsForAllRides();
+    CheckRatings();
+}
 
-    // Load expected ratings
-    auto expectedDataPath = Path::Combine(TestData::GetBasePath(), "ratings", "bpb.sv6.txt");
-    auto expectedRatings = File::ReadAllLines(expectedDataPath);
-
-    // Check ride ratings
-    int expI = 0;
-    for (const auto& ride : GetRideManager())
-    {
-        auto actual = FormatRatings(ride);
-        auto expected = expectedRatings[expI];
-        ASSERT_STREQ(actual.c_str(), expected.c_str());
-
-        expI++;
-    }
+TEST_F(RideRatings, all_multithreaded)
+{
+    CalculateRatingsForAllRidesTogether();
+    CheckRatings();
 }
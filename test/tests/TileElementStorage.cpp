@@ -0,0 +1,309 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2019 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "TestData.h"
+
+#include <gtest/gtest.h>
+#include <openrct2/Context.h>
+#include <openrct2/Game.h>
+#include <openrct2/OpenRCT2.h>
+#include <openrct2/ParkImporter.h>
+#include <openrct2/core/MemoryStream.h>
+#include <openrct2/object/ObjectManager.h>
+#include <openrct2/rct2/S6Exporter.h>
+#include <openrct2/world/Map.h>
+#include <openrct2/world/TileElementStorage.h>
+#include <vector>
+
+using namespace OpenRCT2;
+
+static TileElement CreateElement(uint8_t type, uint8_t baseHeight, bool isLastForTile)
+{
+    TileElement tileElement = {};
+    tileElement.SetType(type);
+    tileElement.base_height = baseHeight;
+    tileElement.clearance_height = baseHeight + 2;
+    tileElement.SetLastForTile(isLastForTile);
+    return tileElement;
+}
+
+static std::vector<TileElement> GetTileElements(const TileCoordsXY& loc)
+{
+    std::vector<TileElement> elements;
+    const TileElement* tileElement = gTileElementTilePointers[loc.y * MAXIMUM_MAP_SIZE_TECHNICAL + loc.x];
+    do
+    {
+        elements.push_back(*tileElement);
+    } while (!(tileElement++)->IsLastForTile());
+    return elements;
+}
+
+static void ExpectSameElements(const std::vector<TileElement>& expected, const std::vector<TileElement>& actual)
+{
+    ASSERT_EQ(expected.size(), actual.size());
+    for (size_t i = 0; i < expected.size(); i++)
+    {
+        EXPECT_EQ(expected[i].GetType(), actual[i].GetType()) << "element " << i;
+        EXPECT_EQ(expected[i].base_height, actual[i].base_height) << "element " << i;
+        EXPECT_EQ(expected[i].clearance_height, actual[i].clearance_height) << "element " << i;
+        EXPECT_EQ(expected[i].IsLastForTile(), actual[i].IsLastForTile()) << "element " << i;
+    }
+}
+
+class TileElementStorageTest : public testing::Test
+{
+protected:
+    // A surface on every tile, with a path above it on tile (1, 0)
+    std::vector<TileElement> _elements;
+
+    void SetUp() override
+    {
+        _elements.clear();
+        for (uint32_t tileIndex = 0; tileIndex < MAX_TILE_TILE_ELEMENT_POINTERS; tileIndex++)
+        {
+            _elements.push_back(CreateElement(TILE_ELEMENT_TYPE_SURFACE, 14, tileIndex != 1));
+            if (tileIndex == 1)
+            {
+                _elements.push_back(CreateElement(TILE_ELEMENT_TYPE_PATH, 14, true));
+            }
+        }
+        map_set_tile_elements(_elements);
+    }
+};
+
+TEST_F(TileElementStorageTest, SetAllGetAllRoundTrip)
+{
+    ASSERT_EQ(tile_element_storage_get_count(), _elements.size());
+    ExpectSameElements(_elements, map_get_tile_elements());
+
+    // Loading the elements again gives the same map
+    map_set_tile_elements(map_get_tile_elements());
+    ASSERT_EQ(tile_element_storage_get_count(), _elements.size());
+    ExpectSameElements(_elements, map_get_tile_elements());
+}
+
+TEST_F(TileElementStorageTest, InsertKeepsTileOrder)
+{
+    const TileCoordsXY loc{ 3, 4 };
+    const TileElement* neighbour = gTileElementTilePointers[loc.y * MAXIMUM_MAP_SIZE_TECHNICAL + loc.x + 1];
+
+    // Below the surface
+    auto inserted = tile_element_storage_insert(loc, 0);
+    *inserted = CreateElement(TILE_ELEMENT_TYPE_WALL, 2, false);
+
+    // Above the surface, which is no longer the last element
+    inserted = tile_element_storage_insert(loc, 5);
+    (inserted - 1)->SetLastForTile(false);
+    *inserted = CreateElement(TILE_ELEMENT_TYPE_SMALL_SCENERY, 20, true);
+
+    auto tileElements = GetTileElements(loc);
+    ExpectSameElements(
+        { CreateElement(TILE_ELEMENT_TYPE_WALL, 2, false), CreateElement(TILE_ELEMENT_TYPE_SURFACE, 14, false),
+          CreateElement(TILE_ELEMENT_TYPE_SMALL_SCENERY, 20, true) },
+        tileElements);
+    EXPECT_EQ(tile_element_storage_get_count(), _elements.size() + 2);
+
+    // Other tiles are not moved
+    EXPECT_EQ(gTileElementTilePointers[loc.y * MAXIMUM_MAP_SIZE_TECHNICAL + loc.x + 1], neighbour);
+    ExpectSameElements({ CreateElement(TILE_ELEMENT_TYPE_SURFACE, 14, true) }, GetTileElements({ loc.x + 1, loc.y }));
+
+    // All elements are still found on their tile
+    const TileElement* tileElement = gTileElementTilePointers[loc.y * MAXIMUM_MAP_SIZE_TECHNICAL + loc.x];
+    for (size_t i = 0; i < tileElements.size(); i++)
+    {
+        TileCoordsXY elementLoc;
+        ASSERT_TRUE(tile_element_storage_get_tile(&tileElement[i], &elementLoc));
+        EXPECT_EQ(elementLoc, loc);
+    }
+}
+
+TEST_F(TileElementStorageTest, Remove)
+{
+    const TileCoordsXY loc{ 1, 0 };
+    auto inserted = tile_element_storage_insert(loc, 1);
+    *inserted = CreateElement(TILE_ELEMENT_TYPE_WALL, 14, false);
+    ExpectSameElements(
+        { CreateElement(TILE_ELEMENT_TYPE_SURFACE, 14, false), CreateElement(TILE_ELEMENT_TYPE_WALL, 14, false),
+          CreateElement(TILE_ELEMENT_TYPE_PATH, 14, true) },
+        GetTileElements(loc));
+
+    // The elements after the removed one move down
+    tile_element_storage_remove(inserted);
+    ExpectSameElements(
+        { CreateElement(TILE_ELEMENT_TYPE_SURFACE, 14, false), CreateElement(TILE_ELEMENT_TYPE_PATH, 14, true) },
+        GetTileElements(loc));
+    EXPECT_EQ(tile_element_storage_get_count(), _elements.size());
+
+    // Removing the last element makes the one below it last
+    auto tileElement = gTileElementTilePointers[loc.y * MAXIMUM_MAP_SIZE_TECHNICAL + loc.x];
+    tile_element_storage_remove(tileElement + 1);
+    ExpectSameElements({ CreateElement(TILE_ELEMENT_TYPE_SURFACE, 14, true) }, GetTileElements(loc));
+    EXPECT_EQ(tileElement[1].base_height, 0xFF);
+    EXPECT_EQ(tile_element_storage_get_count(), _elements.size() - 1);
+}
+
+TEST_F(TileElementStorageTest, GrowAcrossChunksAndPages)
+{
+    // The two tiles are in different 16x16 chunks, the first grows larger than a page
+    const TileCoordsXY loc{ 15, 0 };
+    const TileCoordsXY nextChunkLoc{ 16, 0 };
+    constexpr size_t numInserted = 3000;
+
+    for (size_t i = 0; i < numInserted; i++)
+    {
+        auto inserted = tile_element_storage_insert(loc, i);
+        *inserted = CreateElement(TILE_ELEMENT_TYPE_WALL, static_cast<uint8_t>(i % 250), false);
+
+        auto nextChunkInserted = tile_element_storage_insert(nextChunkLoc, 0);
+        *nextChunkInserted = CreateElement(TILE_ELEMENT_TYPE_WALL, static_cast<uint8_t>(i % 250), false);
+    }
+
+    auto tileElements = GetTileElements(loc);
+    ASSERT_EQ(tileElements.size(), numInserted + 1);
+    for (size_t i = 0; i < numInserted; i++)
+    {
+        EXPECT_EQ(tileElements[i].GetType(), TILE_ELEMENT_TYPE_WALL);
+        EXPECT_EQ(tileElements[i].base_height, i % 250);
+    }
+    EXPECT_EQ(tileElements[numInserted].GetType(), TILE_ELEMENT_TYPE_SURFACE);
+    EXPECT_TRUE(tileElements[numInserted].IsLastForTile());
+
+    auto nextChunkElements = GetTileElements(nextChunkLoc);
+    ASSERT_EQ(nextChunkElements.size(), numInserted + 1);
+    for (size_t i = 0; i < numInserted; i++)
+    {
+        EXPECT_EQ(nextChunkElements[i].base_height, (numInserted - 1 - i) % 250);
+    }
+    EXPECT_EQ(nextChunkElements[numInserted].GetType(), TILE_ELEMENT_TYPE_SURFACE);
+
+    // Each element is found on its own tile
+    for (const auto& tile : { loc, nextChunkLoc })
+    {
+        const TileElement* tileElement = gTileElementTilePointers[tile.y * MAXIMUM_MAP_SIZE_TECHNICAL + tile.x];
+        for (size_t i = 0; i <= numInserted; i++)
+        {
+            TileCoordsXY elementLoc;
+            ASSERT_TRUE(tile_element_storage_get_tile(&tileElement[i], &elementLoc));
+            EXPECT_EQ(elementLoc, tile);
+        }
+    }
+
+    // The neighbours of both tiles are left alone
+    ExpectSameElements({ CreateElement(TILE_ELEMENT_TYPE_SURFACE, 14, true) }, GetTileElements({ 14, 0 }));
+    ExpectSameElements({ CreateElement(TILE_ELEMENT_TYPE_SURFACE, 14, true) }, GetTileElements({ 17, 0 }));
+    EXPECT_EQ(tile_element_storage_get_count(), _elements.size() + numInserted * 2);
+}
+
+TEST_F(TileElementStorageTest, GetAllIsInTileOrderAfterInsert)
+{
+    // Tile (0, 0) moves to a block after the blocks of all other tiles in its chunk
+    auto inserted = tile_element_storage_insert({ 0, 0 }, 1);
+    (inserted - 1)->SetLastForTile(false);
+    *inserted = CreateElement(TILE_ELEMENT_TYPE_WALL, 20, true);
+    inserted = tile_element_storage_insert({ 0, 0 }, 2);
+    (inserted - 1)->SetLastForTile(false);
+    *inserted = CreateElement(TILE_ELEMENT_TYPE_WALL, 30, true);
+
+    auto expected = _elements;
+    expected[0].SetLastForTile(false);
+    expected.insert(
+        expected.begin() + 1,
+        { CreateElement(TILE_ELEMENT_TYPE_WALL, 20, false), CreateElement(TILE_ELEMENT_TYPE_WALL, 30, true) });
+    ExpectSameElements(expected, map_get_tile_elements());
+}
+
+TEST_F(TileElementStorageTest, SaveRestoreKeepsElementAddresses)
+{
+    const TileCoordsXY loc{ 1, 0 };
+    const TileElement* pathElement = gTileElementTilePointers[loc.x] + 1;
+
+    tile_element_storage_save();
+
+    // A temporary map with a wall on every tile
+    std::vector<TileElement> temporaryElements;
+    for (uint32_t tileIndex = 0; tileIndex < MAX_TILE_TILE_ELEMENT_POINTERS; tileIndex++)
+    {
+        temporaryElements.push_back(CreateElement(TILE_ELEMENT_TYPE_WALL, 20, true));
+    }
+    tile_element_storage_set_all(temporaryElements);
+    ASSERT_EQ(tile_element_storage_get_count(), temporaryElements.size());
+    ExpectSameElements({ CreateElement(TILE_ELEMENT_TYPE_WALL, 20, true) }, GetTileElements(loc));
+
+    tile_element_storage_restore();
+    ASSERT_EQ(tile_element_storage_get_count(), _elements.size());
+    ExpectSameElements(_elements, map_get_tile_elements());
+
+    // The elements were not moved, and are still found on their tile
+    EXPECT_EQ(gTileElementTilePointers[loc.x] + 1, pathElement);
+    EXPECT_EQ(pathElement->GetType(), TILE_ELEMENT_TYPE_PATH);
+    TileCoordsXY elementLoc;
+    ASSERT_TRUE(tile_element_storage_get_tile(pathElement, &elementLoc));
+    EXPECT_EQ(elementLoc, loc);
+}
+
+class TileElementStorageParkTest : public testing::Test
+{
+protected:
+    static void SetUpTestCase()
+    {
+        std::string parkPath = TestData::GetParkPath("tile-element-tests.sv6");
+        gOpenRCT2Headless = true;
+        gOpenRCT2NoGraphics = true;
+        _context = CreateContext();
+        bool initialised = _context->Initialise();
+        ASSERT_TRUE(initialised);
+
+        load_from_sv6(parkPath.c_str());
+        game_load_init();
+        SUCCEED();
+    }
+
+    static void TearDownTestCase()
+    {
+        if (_context)
+            _context.reset();
+    }
+
+    static std::shared_ptr<IContext> _context;
+};
+
+std::shared_ptr<IContext> TileElementStorageParkTest::_context;
+
+TEST_F(TileElementStorageParkTest, S6ExportKeepsTileOrder)
+{
+    // Add an element to a tile, so its elements are moved to a new block
+    const TileElement* pathElement = map_get_footpath_element(TileCoordsXYZ{ 19, 18, 14 }.ToCoordsXYZ());
+    ASSERT_NE(pathElement, nullptr);
+    TileElement pathCopy = *pathElement;
+    auto inserted = tile_element_insert({ 19, 18, 40 }, 0b1111);
+    ASSERT_NE(inserted, nullptr);
+    bool isLastForTile = inserted->IsLastForTile();
+    *inserted = pathCopy;
+    inserted->base_height = 40;
+    inserted->clearance_height = 44;
+    inserted->SetLastForTile(isLastForTile);
+
+    auto expected = map_get_tile_elements();
+
+    MemoryStream stream;
+    auto& objManager = _context->GetObjectManager();
+    auto exporter = std::make_unique<S6Exporter>();
+    exporter->ExportObjectsList = objManager.GetPackableObjects();
+    exporter->Export();
+    exporter->SaveGame(&stream);
+
+    stream.SetPosition(0);
+    auto importer = ParkImporter::CreateS6(_context->GetObjectRepository());
+    auto loadResult = importer->LoadFromStream(&stream, false);
+    objManager.LoadObjects(loadResult.RequiredObjects.data(), loadResult.RequiredObjects.size());
+    importer->Import();
+
+    ExpectSameElements(expected, map_get_tile_elements());
+    EXPECT_NE(map_get_footpath_element(TileCoordsXYZ{ 19, 18, 40 }.ToCoordsXYZ()), nullptr);
+}
@@ -16,6 +16,7 @@
 #include <openrct2/ParkImporter.h>
 #include <openrct2/world/Footpath.h>
 #include <openrct2/world/Map.h>
+#include <openrct2/world/MapAreaSummary.h>
 
 using namespace OpenRCT2;
 
@@ -140,3 +141,33 @@ TEST_F(TileElementWantsFootpathConnection, DifferentHeight)
     EXPECT_FALSE(tile_element_wants_path_connection_towards({ 18, 10, 24, 1 }, nullptr));
     SUCCEED();
 }
+
+TEST_F(TileElementWantsFootpathConnection, AreaSummaryFollowsTileElements)
+{
+    // The area summary must be updated when elements are inserted and removed
+    const TileCoordsXY areaMin = { 15, 15 };
+    const TileCoordsXY areaMax = { 20, 20 };
+    const uint32_t numScenery = map_area_summary_get(areaMin, areaMax).NumScenery;
+
+    TileElement* const sceneryElement = tile_element_insert({ 17, 17, 100 }, 0b1111);
+    ASSERT_NE(sceneryElement, nullptr);
+    sceneryElement->SetType(TILE_ELEMENT_TYPE_SMALL_SCENERY);
+    EXPECT_EQ(map_area_summary_get(areaMin, areaMax).NumScenery, numScenery + 1);
+    tile_element_remove(sceneryElement);
+    EXPECT_EQ(map_area_summary_get(areaMin, areaMax).NumScenery, numScenery);
+
+    // Areas that split the map add up to the whole map
+    const uint32_t numMapScenery = map_area_summary_get({ 0, 0 }, { 255, 255 }).NumScenery;
+    EXPECT_EQ(
+        map_area_summary_get({ 0, 0 }, { 16, 255 }).NumScenery + map_area_summary_get({ 17, 0 }, { 255, 16 }).NumScenery
+            + map_area_summary_get({ 17, 17 }, { 255, 255 }).NumScenery,
+        numMapScenery);
+
+    // The rides with track in the area include the stall
+    const TrackElement* const stallElement = map_get_track_element_at(TileCoordsXYZ{ 19, 15, 14 }.ToCoordsXYZ());
+    ASSERT_NE(stallElement, nullptr);
+    std::bitset<MAX_RIDES> rides;
+    map_area_summary_get_rides(areaMin, areaMax, rides);
+    EXPECT_TRUE(rides[stallElement->GetRideIndex()]);
+    SUCCEED();
+}